@@ -0,0 +1,260 @@
+#if defined(ACTORS) || !defined(__SDCC)
+
+#include "actor.h"
+
+#include <string.h>
+
+#include "map.h"
+#include "anim.h"
+#include "sfx.h"
+
+typedef struct ActorKindDef {
+    UINT8 pool;
+    UINT8 w;
+    UINT8 h;
+    UINT8 flags;
+    INT16 vel_x_fp;
+    INT16 vel_y_fp;
+    UINT8 life;
+    UINT8 anim_clip;
+} ActorKindDef;
+
+static const ActorKindDef ACTOR_KINDS[ACTOR_KIND_COUNT] = {
+    { ACTOR_POOL_ENEMY, 16, 16, ACTOR_FLAG_GRAVITY | ACTOR_FLAG_TILE_SOLID | ACTOR_FLAG_TURN_AT_WALL | ACTOR_FLAG_FACING_LEFT, -FP_MAKE(0, 128), 0, 0, ANIM_CLIP_WALKER },
+    { ACTOR_POOL_PROJECTILE, 8, 8, ACTOR_FLAG_DIE_AT_WALL | ACTOR_FLAG_EXPIRES, FP_MAKE(3, 0), 0, 90, ANIM_CLIP_PROJECTILE },
+    { ACTOR_POOL_PARTICLE, 8, 8, ACTOR_FLAG_GRAVITY | ACTOR_FLAG_EXPIRES, 0, -FP_MAKE(2, 0), 24, ANIM_CLIP_PARTICLE },
+};
+
+INT16 actor_x[ACTOR_CAPACITY];
+INT16 actor_y[ACTOR_CAPACITY];
+UINT8 actor_x_sub[ACTOR_CAPACITY];
+UINT8 actor_y_sub[ACTOR_CAPACITY];
+INT16 actor_vel_x_fp[ACTOR_CAPACITY];
+INT16 actor_vel_y_fp[ACTOR_CAPACITY];
+UINT8 actor_flags[ACTOR_CAPACITY];
+UINT8 actor_kind[ACTOR_CAPACITY];
+UINT8 actor_w[ACTOR_CAPACITY];
+UINT8 actor_h[ACTOR_CAPACITY];
+UINT8 actor_anim_step[ACTOR_CAPACITY];
+UINT8 actor_anim_timer[ACTOR_CAPACITY];
+UINT8 actor_life[ACTOR_CAPACITY];
+
+UINT8 actor_active[ACTOR_CAPACITY];
+UINT8 actor_active_count;
+
+Pool g_actor_pools[ACTOR_POOL_COUNT];
+
+static UINT8 actor_active_pos[ACTOR_CAPACITY];
+static UINT8 actor_pool_next[ACTOR_CAPACITY];
+static UINT8 actor_pool_gen[ACTOR_CAPACITY];
+
+static Pool* actor_pool_of(UINT8 slot) {
+    if (slot < ACTOR_PROJECTILE_FIRST) {
+        return &g_actor_pools[ACTOR_POOL_ENEMY];
+    }
+    if (slot < ACTOR_PARTICLE_FIRST) {
+        return &g_actor_pools[ACTOR_POOL_PROJECTILE];
+    }
+    return &g_actor_pools[ACTOR_POOL_PARTICLE];
+}
+
+void actor_system_init(void) {
+    pool_init(&g_actor_pools[ACTOR_POOL_ENEMY], actor_pool_next, actor_pool_gen, ACTOR_ENEMY_FIRST, ACTOR_ENEMY_CAPACITY);
+    pool_init(&g_actor_pools[ACTOR_POOL_PROJECTILE], actor_pool_next, actor_pool_gen, ACTOR_PROJECTILE_FIRST, ACTOR_PROJECTILE_CAPACITY);
+    pool_init(&g_actor_pools[ACTOR_POOL_PARTICLE], actor_pool_next, actor_pool_gen, ACTOR_PARTICLE_FIRST, ACTOR_PARTICLE_CAPACITY);
+
+    for (UINT8 i = 0; i < ACTOR_CAPACITY; ++i) {
+        actor_flags[i] = 0;
+    }
+    actor_active_count = 0;
+}
+
+ActorHandle actor_spawn(UINT8 kind, INT16 x, INT16 y) {
+    const ActorKindDef* def = &ACTOR_KINDS[kind];
+
+    ActorHandle handle = pool_alloc(&g_actor_pools[def->pool]);
+    if (handle == ACTOR_HANDLE_NONE) {
+        return ACTOR_HANDLE_NONE;
+    }
+    UINT8 slot = POOL_HANDLE_INDEX(handle);
+
+    actor_x[slot] = x;
+    actor_y[slot] = y;
+    actor_x_sub[slot] = 0;
+    actor_y_sub[slot] = 0;
+    actor_vel_x_fp[slot] = def->vel_x_fp;
+    actor_vel_y_fp[slot] = def->vel_y_fp;
+    actor_flags[slot] = (UINT8)(def->flags | ACTOR_FLAG_ACTIVE);
+    actor_kind[slot] = kind;
+    actor_w[slot] = def->w;
+    actor_h[slot] = def->h;
+    ANIM_START(actor_anim_step[slot], actor_anim_timer[slot], def->anim_clip);
+    actor_life[slot] = def->life;
+
+    actor_active_pos[slot] = actor_active_count;
+    actor_active[actor_active_count++] = slot;
+
+    return handle;
+}
+
+void actor_despawn(UINT8 slot) {
+    if (!(actor_flags[slot] & ACTOR_FLAG_ACTIVE)) {
+        return;
+    }
+    actor_flags[slot] = 0;
+
+    Pool* pool = actor_pool_of(slot);
+    pool_free(pool, pool_handle_of(pool, slot));
+
+    UINT8 pos = actor_active_pos[slot];
+    UINT8 last = actor_active[--actor_active_count];
+    actor_active[pos] = last;
+    actor_active_pos[last] = pos;
+}
+
+UINT8 actor_resolve(ActorHandle handle) {
+    UINT8 slot = POOL_HANDLE_INDEX(handle);
+    if (slot >= ACTOR_CAPACITY) {
+        return ACTOR_NONE;
+    }
+    return pool_resolve(actor_pool_of(slot), handle);
+}
+
+ActorHandle actor_handle(UINT8 slot) {
+    return pool_handle_of(actor_pool_of(slot), slot);
+}
+
+void actor_integrate_all(void) {
+    for (UINT8 i = 0; i < actor_active_count; ++i) {
+        UINT8 slot = actor_active[i];
+        UINT8 flags = actor_flags[slot];
+
+        if ((flags & (ACTOR_FLAG_GRAVITY | ACTOR_FLAG_ON_GROUND)) == ACTOR_FLAG_GRAVITY) {
+            INT16 vy = (INT16)(actor_vel_y_fp[slot] + ACTOR_GRAVITY_FP);
+            actor_vel_y_fp[slot] = FP_CLAMP_MAX(vy, ACTOR_MAX_FALL_FP);
+        }
+
+        FP_POS_ADD(actor_x[slot], actor_x_sub[slot], actor_vel_x_fp[slot]);
+        FP_POS_ADD(actor_y[slot], actor_y_sub[slot], actor_vel_y_fp[slot]);
+    }
+}
+
+void actor_collide_all(void) {
+    for (UINT8 i = 0; i < actor_active_count; ++i) {
+        UINT8 slot = actor_active[i];
+        UINT8 flags = actor_flags[slot];
+
+        if (!(flags & (ACTOR_FLAG_TILE_SOLID | ACTOR_FLAG_TURN_AT_WALL | ACTOR_FLAG_DIE_AT_WALL))) {
+            continue;
+        }
+
+        INT16 x = actor_x[slot];
+        INT16 y = actor_y[slot];
+        INT16 bottom = (INT16)(y + actor_h[slot]);
+
+        if ((flags & ACTOR_FLAG_TILE_SOLID) && actor_vel_y_fp[slot] >= 0) {
+            INT16 tile_y = bottom >> 3;
+            if (map_is_solid_at((x + (actor_w[slot] >> 1)) >> 3, tile_y)) {
+                actor_y[slot] = (INT16)((tile_y << 3) - actor_h[slot]);
+                actor_y_sub[slot] = 0;
+                actor_vel_y_fp[slot] = 0;
+                flags |= ACTOR_FLAG_ON_GROUND;
+            } else {
+                flags &= (UINT8)~ACTOR_FLAG_ON_GROUND;
+            }
+        }
+
+        if (flags & (ACTOR_FLAG_TURN_AT_WALL | ACTOR_FLAG_DIE_AT_WALL)) {
+            INT16 vx = actor_vel_x_fp[slot];
+            INT16 edge_x = (vx < 0) ? x : (INT16)(x + actor_w[slot] - 1);
+            if (vx != 0 && map_is_solid_at(edge_x >> 3, (bottom - 1) >> 3)) {
+                if (flags & ACTOR_FLAG_DIE_AT_WALL) {
+                    flags |= ACTOR_FLAG_EXPIRES;
+                    actor_life[slot] = 1;
+                    sfx_play(SFX_HIT);
+                } else {
+                    actor_vel_x_fp[slot] = (INT16)-vx;
+                    actor_x_sub[slot] = 0;
+                    actor_x[slot] = (vx < 0) ? (INT16)(((edge_x >> 3) + 1) << 3) : (INT16)(((edge_x >> 3) << 3) - actor_w[slot]);
+                    flags ^= ACTOR_FLAG_FACING_LEFT;
+                }
+            }
+        }
+
+        actor_flags[slot] = flags;
+    }
+}
+
+void actor_animate_all(void) {
+    for (UINT8 i = 0; i < actor_active_count; ++i) {
+        UINT8 slot = actor_active[i];
+        ANIM_TICK(actor_anim_step[slot], actor_anim_timer[slot]);
+    }
+}
+
+void actor_expire_all(void) {
+    UINT8 i = actor_active_count;
+    while (i != 0) {
+        UINT8 slot = actor_active[--i];
+        if ((actor_flags[slot] & ACTOR_FLAG_EXPIRES) && --actor_life[slot] == 0) {
+            actor_despawn(slot);
+        }
+    }
+}
+
+void actor_update_all(void) {
+    actor_integrate_all();
+    actor_collide_all();
+    actor_animate_all();
+    actor_expire_all();
+}
+
+#if defined(GAME_SNAPSHOT)
+
+static void* const ACTOR_SAVE_ARRAYS[] = {
+    actor_x, actor_y, actor_vel_x_fp, actor_vel_y_fp,
+    actor_x_sub, actor_y_sub, actor_flags, actor_kind, actor_w, actor_h,
+    actor_anim_step, actor_anim_timer, actor_life, actor_active, actor_pool_next, actor_pool_gen,
+};
+
+static const UINT8 ACTOR_SAVE_ARRAY_SIZES[] = {
+    sizeof(actor_x), sizeof(actor_y), sizeof(actor_vel_x_fp), sizeof(actor_vel_y_fp),
+    sizeof(actor_x_sub), sizeof(actor_y_sub), sizeof(actor_flags), sizeof(actor_kind), sizeof(actor_w), sizeof(actor_h),
+    sizeof(actor_anim_step), sizeof(actor_anim_timer), sizeof(actor_life), sizeof(actor_active), sizeof(actor_pool_next),
+    sizeof(actor_pool_gen),
+};
+
+void actor_save(UINT8* out) {
+    for (UINT8 i = 0; i < (UINT8)sizeof(ACTOR_SAVE_ARRAY_SIZES); ++i) {
+        memcpy(out, ACTOR_SAVE_ARRAYS[i], ACTOR_SAVE_ARRAY_SIZES[i]);
+        out += ACTOR_SAVE_ARRAY_SIZES[i];
+    }
+    *out++ = actor_active_count;
+    for (UINT8 p = 0; p < ACTOR_POOL_COUNT; ++p) {
+        *out++ = g_actor_pools[p].free_head;
+        *out++ = g_actor_pools[p].live;
+    }
+}
+
+#ifndef __SDCC
+void actor_load(const UINT8* in) {
+    actor_system_init();
+
+    for (UINT8 i = 0; i < (UINT8)sizeof(ACTOR_SAVE_ARRAY_SIZES); ++i) {
+        memcpy(ACTOR_SAVE_ARRAYS[i], in, ACTOR_SAVE_ARRAY_SIZES[i]);
+        in += ACTOR_SAVE_ARRAY_SIZES[i];
+    }
+    actor_active_count = *in++;
+    for (UINT8 p = 0; p < ACTOR_POOL_COUNT; ++p) {
+        g_actor_pools[p].free_head = *in++;
+        g_actor_pools[p].live = *in++;
+    }
+    for (UINT8 i = 0; i < actor_active_count; ++i) {
+        actor_active_pos[actor_active[i]] = i;
+    }
+}
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "game_types.h"
+#include "fixed.h"
+#include "pool.h"
+
+#ifndef ACTOR_ENEMY_CAPACITY
+#define ACTOR_ENEMY_CAPACITY 16
+#endif
+#ifndef ACTOR_PROJECTILE_CAPACITY
+#define ACTOR_PROJECTILE_CAPACITY 8
+#endif
+#ifndef ACTOR_PARTICLE_CAPACITY
+#define ACTOR_PARTICLE_CAPACITY 8
+#endif
+
+#define ACTOR_ENEMY_FIRST 0
+#define ACTOR_PROJECTILE_FIRST (ACTOR_ENEMY_FIRST + ACTOR_ENEMY_CAPACITY)
+#define ACTOR_PARTICLE_FIRST (ACTOR_PROJECTILE_FIRST + ACTOR_PROJECTILE_CAPACITY)
+#define ACTOR_CAPACITY (ACTOR_PARTICLE_FIRST + ACTOR_PARTICLE_CAPACITY)
+
+#define ACTOR_NONE POOL_INDEX_NONE
+
+#define ACTOR_FLAG_ACTIVE      0x01
+#define ACTOR_FLAG_ON_GROUND   0x02
+#define ACTOR_FLAG_FACING_LEFT 0x04
+#define ACTOR_FLAG_GRAVITY     0x08
+#define ACTOR_FLAG_TILE_SOLID  0x10
+#define ACTOR_FLAG_TURN_AT_WALL 0x20
+#define ACTOR_FLAG_DIE_AT_WALL 0x40
+#define ACTOR_FLAG_EXPIRES     0x80
+
+typedef enum ActorPoolId {
+    ACTOR_POOL_ENEMY = 0,
+    ACTOR_POOL_PROJECTILE,
+    ACTOR_POOL_PARTICLE,
+    ACTOR_POOL_COUNT
+} ActorPoolId;
+
+typedef enum ActorKind {
+    ACTOR_KIND_WALKER = 0,
+    ACTOR_KIND_PROJECTILE,
+    ACTOR_KIND_PARTICLE,
+    ACTOR_KIND_COUNT
+} ActorKind;
+
+typedef PoolHandle ActorHandle;
+
+#define ACTOR_HANDLE_NONE POOL_HANDLE_NONE
+
+#define ACTOR_SAVE_SIZE (ACTOR_CAPACITY * (4u * 2u + 12u) + 1u + ACTOR_POOL_COUNT * 2u)
+
+#define ACTOR_GRAVITY_FP       ((INT16)21)
+#define ACTOR_MAX_FALL_FP      ((INT16)(3 << 8) + 192)
+
+extern INT16 actor_x[ACTOR_CAPACITY];
+extern INT16 actor_y[ACTOR_CAPACITY];
+extern UINT8 actor_x_sub[ACTOR_CAPACITY];
+extern UINT8 actor_y_sub[ACTOR_CAPACITY];
+extern INT16 actor_vel_x_fp[ACTOR_CAPACITY];
+extern INT16 actor_vel_y_fp[ACTOR_CAPACITY];
+extern UINT8 actor_flags[ACTOR_CAPACITY];
+extern UINT8 actor_kind[ACTOR_CAPACITY];
+extern UINT8 actor_w[ACTOR_CAPACITY];
+extern UINT8 actor_h[ACTOR_CAPACITY];
+extern UINT8 actor_anim_step[ACTOR_CAPACITY];
+extern UINT8 actor_anim_timer[ACTOR_CAPACITY];
+extern UINT8 actor_life[ACTOR_CAPACITY];
+
+extern UINT8 actor_active[ACTOR_CAPACITY];
+extern UINT8 actor_active_count;
+
+extern Pool g_actor_pools[ACTOR_POOL_COUNT];
+
+void actor_system_init(void);
+
+ActorHandle actor_spawn(UINT8 kind, INT16 x, INT16 y);
+
+void actor_despawn(UINT8 slot);
+
+UINT8 actor_resolve(ActorHandle handle);
+
+ActorHandle actor_handle(UINT8 slot);
+
+void actor_integrate_all(void);
+
+void actor_collide_all(void);
+
+void actor_animate_all(void);
+
+void actor_expire_all(void);
+
+void actor_update_all(void);
+
+#ifdef GAME_SNAPSHOT
+void actor_save(UINT8* out);
+#endif
+
+#ifndef __SDCC
+void actor_load(const UINT8* in);
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "game_types.h"
+#include "anim_data.h"
+
+typedef struct Anim {
+    UINT8 clip;
+    UINT8 step;
+    UINT8 timer;
+} Anim;
+
+#define ANIM_START(step, timer, c) \
+    do { \
+        (step) = ANIM_CLIP_START[(c)]; \
+        (timer) = ANIM_DURATION[(step)]; \
+    } while (0)
+
+#define ANIM_TICK(step, timer) \
+    do { \
+        if (--(timer) == 0) { \
+            (step) = ANIM_NEXT[(step)]; \
+            (timer) = ANIM_DURATION[(step)]; \
+        } \
+    } while (0)
+
+#define ANIM_FRAME_OF(step) (ANIM_FRAME[(step)])
+
+#define anim_play(a, c) \
+    do { \
+        (a)->clip = (c); \
+        ANIM_START((a)->step, (a)->timer, (c)); \
+    } while (0)
+
+#define anim_tick(a) ANIM_TICK((a)->step, (a)->timer)
+
+#define anim_frame(a) ANIM_FRAME_OF((a)->step)
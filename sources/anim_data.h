@@ -0,0 +1,31 @@
+#pragma once
+
+#include "game_types.h"
+
+#define ANIM_CLIP_PLAYER_IDLE 0
+#define ANIM_CLIP_PLAYER_RUN 1
+#define ANIM_CLIP_PLAYER_JUMP 2
+#define ANIM_CLIP_WALKER 3
+#define ANIM_CLIP_PROJECTILE 4
+#define ANIM_CLIP_PARTICLE 5
+#define ANIM_CLIP_COUNT 6
+#define ANIM_STEP_COUNT 28
+
+static const UINT8 ANIM_CLIP_START[6] = {
+    0, 4, 14, 18, 22, 24,
+};
+
+static const UINT8 ANIM_FRAME[28] = {
+    0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 2, 3,
+    0, 1, 0, 1, 2, 3, 0, 1, 0, 1, 2, 3,
+};
+
+static const UINT8 ANIM_DURATION[28] = {
+    30, 30, 30, 30, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 8, 8, 8, 8, 4, 4, 6, 6, 6, 6,
+};
+
+static const UINT8 ANIM_NEXT[28] = {
+    1, 2, 3, 0, 5, 6, 7, 8, 9, 10, 11, 12, 13, 4, 15, 16,
+    17, 14, 19, 20, 21, 18, 23, 22, 25, 26, 27, 27,
+};
@@ -0,0 +1,50 @@
+#include "bank_scope.h"
+
+#ifdef BANK_PROFILE
+#include <gbdk/emu_debug.h>
+#endif
+
+#ifdef BANK_SWITCH_STATS
+
+volatile UINT8 g_bank_switch_count;
+volatile UINT8 g_bank_switches_last_frame;
+
+#ifdef BANK_PROFILE
+
+volatile UINT8 g_bank_asset_current;
+UINT8 g_bank_profile_transitions[BANK_ASSET_COUNT][BANK_ASSET_COUNT];
+
+static UINT16 g_bank_profile_frame;
+
+void bank_profile_note_banked_call(UINT8 asset) {
+    UINT8 caller = g_bank_asset_current;
+    BANK_PROFILE_TRANSITION(asset);
+    BANK_PROFILE_TRANSITION(caller);
+    g_bank_switch_count += 2;
+}
+
+static void bank_profile_flush(void) {
+    for (UINT8 from = 0; from < (UINT8)BANK_ASSET_COUNT; ++from) {
+        for (UINT8 to = 0; to < (UINT8)BANK_ASSET_COUNT; ++to) {
+            UINT8 n = g_bank_profile_transitions[from][to];
+            if (n != 0) {
+                EMU_printf("BANKPROF f=%u %u>%u n=%u", g_bank_profile_frame, (UINT16)from, (UINT16)to, (UINT16)n);
+                g_bank_profile_transitions[from][to] = 0;
+            }
+        }
+    }
+    EMU_printf("BANKPROF f=%u total=%u", g_bank_profile_frame, (UINT16)g_bank_switches_last_frame);
+    g_bank_profile_frame++;
+}
+#endif
+
+void bank_switch_stats_frame_end(void) {
+    g_bank_switches_last_frame = g_bank_switch_count;
+    g_bank_switch_count = 0;
+
+#ifdef BANK_PROFILE
+    bank_profile_flush();
+#endif
+}
+
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "game_types.h"
+
+typedef enum BankAsset {
+    BANK_ASSET_HOME = 0,
+    BANK_ASSET_TILEMAP,
+    BANK_ASSET_PLAYER_ANIM,
+    BANK_ASSET_MUSIC,
+    BANK_ASSET_BENCH,
+    BANK_ASSET_COUNT
+} BankAsset;
+
+#if defined(BANK_PROFILE) && !defined(BANK_SWITCH_STATS)
+#define BANK_SWITCH_STATS
+#endif
+
+#ifdef BANK_SWITCH_STATS
+extern volatile UINT8 g_bank_switch_count;
+extern volatile UINT8 g_bank_switches_last_frame;
+
+#define BANK_SWITCH_STATS_INC() (g_bank_switch_count++)
+
+void bank_switch_stats_frame_end(void);
+#else
+#define BANK_SWITCH_STATS_INC() ((void)0)
+
+#define bank_switch_stats_frame_end() ((void)0)
+#endif
+
+#ifdef BANK_PROFILE
+extern volatile UINT8 g_bank_asset_current;
+extern UINT8 g_bank_profile_transitions[BANK_ASSET_COUNT][BANK_ASSET_COUNT];
+
+#define BANK_PROFILE_TRANSITION(asset) \
+    do { \
+        g_bank_profile_transitions[g_bank_asset_current][(asset)]++; \
+        g_bank_asset_current = (UINT8)(asset); \
+    } while (0)
+
+#define BANK_PROFILE_SAVE() UINT8 bank_scope_saved_asset = g_bank_asset_current
+#define BANK_PROFILE_SAVED_ASSET() bank_scope_saved_asset
+
+void bank_profile_note_banked_call(UINT8 asset);
+#define BANK_NOTE_BANKED_CALL(asset) bank_profile_note_banked_call((asset))
+#else
+#define BANK_PROFILE_TRANSITION(asset) ((void)0)
+#define BANK_PROFILE_SAVE() ((void)0)
+#define BANK_PROFILE_SAVED_ASSET() BANK_ASSET_HOME
+
+#define BANK_NOTE_BANKED_CALL(asset) ((void)0)
+#endif
+
+#if defined(__SDCC)
+
+#define BANK_SWITCH(asset, b) \
+    do { \
+        if (_current_bank != (UINT8)(b)) { \
+            SWITCH_ROM((b)); \
+            BANK_SWITCH_STATS_INC(); \
+        } \
+        BANK_PROFILE_TRANSITION((asset)); \
+    } while (0)
+
+#define BANK_SCOPE_ENTER(asset, b) \
+    UINT8 bank_scope_saved = _current_bank; \
+    BANK_PROFILE_SAVE(); \
+    BANK_SWITCH((asset), (b))
+
+#define BANK_SCOPE_EXIT() BANK_SWITCH(BANK_PROFILE_SAVED_ASSET(), bank_scope_saved)
+
+#else
+
+#define BANK_SWITCH(asset, b) ((void)0)
+
+#define BANK_SCOPE_ENTER(asset, b) ((void)0)
+
+#define BANK_SCOPE_EXIT() ((void)0)
+
+#endif
@@ -0,0 +1,143 @@
+#if defined(ACTORS) || !defined(__SDCC)
+
+#include "broadphase.h"
+
+UINT8 broadphase_order[ACTOR_CAPACITY];
+UINT8 broadphase_count;
+
+BroadphasePair broadphase_pairs[BROADPHASE_MAX_PAIRS];
+UINT8 broadphase_pair_count;
+BOOLEAN broadphase_overflow;
+
+static UINT8 g_broadphase_member[ACTOR_CAPACITY];
+
+void broadphase_init(void) {
+    for (UINT8 i = 0; i < ACTOR_CAPACITY; ++i) {
+        g_broadphase_member[i] = 0;
+    }
+    broadphase_count = 0;
+    broadphase_pair_count = 0;
+    broadphase_overflow = 0;
+}
+
+void broadphase_sync(void) {
+    UINT8 n = 0;
+
+    for (UINT8 i = 0; i < broadphase_count; ++i) {
+        UINT8 slot = broadphase_order[i];
+        if (actor_flags[slot] & ACTOR_FLAG_ACTIVE) {
+            broadphase_order[n++] = slot;
+        } else {
+            g_broadphase_member[slot] = 0;
+        }
+    }
+
+    for (UINT8 i = 0; i < actor_active_count; ++i) {
+        UINT8 slot = actor_active[i];
+        if (!g_broadphase_member[slot]) {
+            g_broadphase_member[slot] = 1;
+            broadphase_order[n++] = slot;
+        }
+    }
+
+    broadphase_count = n;
+}
+
+void broadphase_sort(void) {
+    for (UINT8 i = 1; i < broadphase_count; ++i) {
+        UINT8 slot = broadphase_order[i];
+        INT16 x = actor_x[slot];
+        UINT8 j = i;
+
+        while (j != 0 && actor_x[broadphase_order[j - 1]] > x) {
+            broadphase_order[j] = broadphase_order[j - 1];
+            --j;
+        }
+        broadphase_order[j] = slot;
+    }
+}
+
+void broadphase_sweep(void) {
+    UINT8 pairs = 0;
+    broadphase_overflow = 0;
+
+    for (UINT8 i = 0; i < broadphase_count; ++i) {
+        UINT8 a = broadphase_order[i];
+        INT16 right = (INT16)(actor_x[a] + actor_w[a]);
+        INT16 top = actor_y[a];
+        INT16 bottom = (INT16)(top + actor_h[a]);
+
+        for (UINT8 k = (UINT8)(i + 1u); k < broadphase_count; ++k) {
+            UINT8 b = broadphase_order[k];
+            if (actor_x[b] >= right) {
+                break;
+            }
+            if (actor_y[b] >= bottom || (INT16)(actor_y[b] + actor_h[b]) <= top) {
+                continue;
+            }
+            if (pairs == BROADPHASE_MAX_PAIRS) {
+                broadphase_overflow = 1;
+                broadphase_pair_count = pairs;
+                return;
+            }
+            broadphase_pairs[pairs].a = a;
+            broadphase_pairs[pairs].b = b;
+            ++pairs;
+        }
+    }
+
+    broadphase_pair_count = pairs;
+}
+
+void broadphase_update(void) {
+    broadphase_sync();
+    broadphase_sort();
+    broadphase_sweep();
+}
+
+UINT8 broadphase_query(INT16 x, INT16 y, UINT8 w, UINT8 h, UINT8* out, UINT8 max) {
+    INT16 right = (INT16)(x + w);
+    INT16 bottom = (INT16)(y + h);
+    UINT8 n = 0;
+
+    for (UINT8 i = 0; i < broadphase_count && n < max; ++i) {
+        UINT8 slot = broadphase_order[i];
+        INT16 ax = actor_x[slot];
+        if (ax >= right) {
+            break;
+        }
+        if ((INT16)(ax + actor_w[slot]) <= x) {
+            continue;
+        }
+        if (actor_y[slot] >= bottom || (INT16)(actor_y[slot] + actor_h[slot]) <= y) {
+            continue;
+        }
+        out[n++] = slot;
+    }
+
+    return n;
+}
+
+#if defined(GAME_SNAPSHOT)
+void broadphase_save(UINT8* out) {
+    for (UINT8 i = 0; i < ACTOR_CAPACITY; ++i) {
+        out[i] = broadphase_order[i];
+    }
+    out[ACTOR_CAPACITY] = broadphase_count;
+}
+
+#ifndef __SDCC
+void broadphase_load(const UINT8* in) {
+    broadphase_init();
+    for (UINT8 i = 0; i < ACTOR_CAPACITY; ++i) {
+        broadphase_order[i] = in[i];
+    }
+    broadphase_count = in[ACTOR_CAPACITY];
+    for (UINT8 i = 0; i < broadphase_count; ++i) {
+        g_broadphase_member[broadphase_order[i]] = 1;
+    }
+}
+#endif
+#endif
+
+#endif
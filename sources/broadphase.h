@@ -0,0 +1,42 @@
+#pragma once
+
+#include "game_types.h"
+#include "actor.h"
+
+#ifndef BROADPHASE_MAX_PAIRS
+#define BROADPHASE_MAX_PAIRS 24
+#endif
+
+#define BROADPHASE_SAVE_SIZE (ACTOR_CAPACITY + 1u)
+
+typedef struct BroadphasePair {
+    UINT8 a;
+    UINT8 b;
+} BroadphasePair;
+
+extern UINT8 broadphase_order[ACTOR_CAPACITY];
+extern UINT8 broadphase_count;
+
+extern BroadphasePair broadphase_pairs[BROADPHASE_MAX_PAIRS];
+extern UINT8 broadphase_pair_count;
+extern BOOLEAN broadphase_overflow;
+
+void broadphase_init(void);
+
+void broadphase_sync(void);
+
+void broadphase_sort(void);
+
+void broadphase_sweep(void);
+
+void broadphase_update(void);
+
+UINT8 broadphase_query(INT16 x, INT16 y, UINT8 w, UINT8 h, UINT8* out, UINT8 max);
+
+#ifdef GAME_SNAPSHOT
+void broadphase_save(UINT8* out);
+#endif
+
+#ifndef __SDCC
+void broadphase_load(const UINT8* in);
+#endif
@@ -0,0 +1,93 @@
+#if defined(BROADPHASE_BENCH) && !defined(__SDCC)
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "actor.h"
+#include "broadphase.h"
+#include "host_prof.h"
+#include "host_rand.h"
+
+#define BROADPHASE_BENCH_FRAMES 20000u
+#define BROADPHASE_BENCH_WORLD_W 480
+#define BROADPHASE_BENCH_WORLD_H 320
+
+static uint32_t g_bench_rng = 0x2545F491u;
+
+static uint32_t naive_pairs(void) {
+    uint32_t n = 0;
+    for (UINT8 i = 0; i < actor_active_count; ++i) {
+        UINT8 a = actor_active[i];
+        for (UINT8 k = (UINT8)(i + 1u); k < actor_active_count; ++k) {
+            UINT8 b = actor_active[k];
+            if (actor_x[a] < actor_x[b] + actor_w[b] && actor_x[b] < actor_x[a] + actor_w[a]
+                && actor_y[a] < actor_y[b] + actor_h[b] && actor_y[b] < actor_y[a] + actor_h[a]) {
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+static void bench_step(void) {
+    for (UINT8 i = 0; i < actor_active_count; ++i) {
+        UINT8 slot = actor_active[i];
+        INT16 x = (INT16)(actor_x[slot] + (INT16)(host_rand_next(&g_bench_rng) % 5u) - 2);
+        INT16 y = (INT16)(actor_y[slot] + (INT16)(host_rand_next(&g_bench_rng) % 3u) - 1);
+        actor_x[slot] = (x < 0) ? 0 : (x > BROADPHASE_BENCH_WORLD_W) ? BROADPHASE_BENCH_WORLD_W : x;
+        actor_y[slot] = (y < 0) ? 0 : (y > BROADPHASE_BENCH_WORLD_H) ? BROADPHASE_BENCH_WORLD_H : y;
+    }
+}
+
+static void bench_count(UINT8 count) {
+    uint64_t sweep_ns = 0;
+    uint64_t naive_ns = 0;
+    uint64_t max_ns = 0;
+    uint32_t pairs = 0;
+    uint32_t overflows = 0;
+
+    actor_system_init();
+    broadphase_init();
+    for (UINT8 i = 0; i < count; ++i) {
+        actor_spawn(ACTOR_KIND_WALKER, (INT16)(host_rand_next(&g_bench_rng) % BROADPHASE_BENCH_WORLD_W), (INT16)(host_rand_next(&g_bench_rng) % BROADPHASE_BENCH_WORLD_H));
+    }
+
+    for (uint32_t f = 0; f < BROADPHASE_BENCH_FRAMES; f++) {
+        bench_step();
+
+        uint64_t t0 = host_prof_now_ns();
+        broadphase_update();
+        uint64_t t1 = host_prof_now_ns();
+        uint32_t expected = naive_pairs();
+        uint64_t t2 = host_prof_now_ns();
+
+        if (broadphase_overflow) {
+            overflows++;
+        } else if (broadphase_pair_count != expected) {
+            fprintf(stderr, "n=%u frame %u: sweep %u pairs, naive %u\n", (unsigned)count, (unsigned)f, (unsigned)broadphase_pair_count, (unsigned)expected);
+            exit(1);
+        }
+
+        sweep_ns += t1 - t0;
+        naive_ns += t2 - t1;
+        if (t1 - t0 > max_ns) max_ns = t1 - t0;
+        pairs += broadphase_pair_count;
+    }
+
+    printf("n=%3u  sort+sweep avg %8.1f ns max %8llu ns  naive avg %8.1f ns  pairs/frame %5.2f  overflow frames %u\n",
+        (unsigned)count, (double)sweep_ns / BROADPHASE_BENCH_FRAMES, (unsigned long long)max_ns,
+        (double)naive_ns / BROADPHASE_BENCH_FRAMES, (double)pairs / BROADPHASE_BENCH_FRAMES, (unsigned)overflows);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        g_bench_rng = host_rand_seed((uint32_t)strtoul(argv[1], 0, 0));
+    }
+
+    for (UINT16 n = 2; n <= ACTOR_ENEMY_CAPACITY; n = (UINT16)(n * 2u)) {
+        bench_count((UINT8)n);
+    }
+    return 0;
+}
+
+#endif
@@ -1,25 +1,12 @@
 #include "camera.h"
+#include "camera_ease_data.h"
+#include "host_prof.h"
 
 #define EASE_DURATION 256u
 #define EASE_DURATION_DIV 8u
-#define EASE_DURATION_HALF EASE_DURATION / 2u
 
 #define CAMERA_BASE_Y (-24)
 
-UINT16 ease_in_out(UINT16 t) {
-    if (t < EASE_DURATION_HALF) {
-
-        UINT16 scaled = (t * t) >> 6;
-        return scaled;
-    } else {
-
-        UINT16 t_inv = EASE_DURATION - t;
-        UINT16 scaled = (t_inv * t_inv) >> 6;
-
-        return (EASE_DURATION << 1) - scaled;
-    }
-}
-
 void camera_init(Camera* camera, const Player* player) {
 
     camera->rel_x_from_player = player->facing_left ? -CAMERA_LOOKAHEAD : CAMERA_LOOKAHEAD;
@@ -43,7 +30,10 @@ void camera_input_up_down(Camera* camera, INT8 lookahead_y) {
     camera->y_lookahead = lookahead_y;
 }
 
+HOST_PROF_ZONE(g_prof_camera_update, "camera_update");
+
 void camera_update(Camera* camera, const Player* player, Map* map) {
+    HOST_PROF_BEGIN(g_prof_camera_update);
 
     if (camera->progress_x != EASE_DURATION) {
         camera->progress_x += CAMERA_MOVE_FRAMES;
@@ -53,9 +43,16 @@ void camera_update(Camera* camera, const Player* player, Map* map) {
             camera->rel_x_from_player = (INT16)(camera->start_offset_x + camera->move_distance_x);
         } else {
 
-            UINT16 eased = ease_in_out(camera->progress_x) >> 1;
+            UINT8 step = (UINT8)(camera->progress_x >> CAMERA_EASE_STEP_SHIFT);
+            INT16 offset;
 
-            INT16 offset = (camera->move_distance_x * (INT32)eased) >> EASE_DURATION_DIV;
+            if (camera->move_distance_x == CAMERA_EASE_FULL_DISTANCE) {
+                offset = CAMERA_EASE_OFFSET_POS[step];
+            } else if (camera->move_distance_x == -CAMERA_EASE_FULL_DISTANCE) {
+                offset = CAMERA_EASE_OFFSET_NEG[step];
+            } else {
+                offset = (INT16)(camera->move_distance_x * (INT16)CAMERA_EASE_TABLE[step]) >> EASE_DURATION_DIV;
+            }
             camera->rel_x_from_player = (INT16)(camera->start_offset_x + offset);
         }
     } else {
@@ -82,4 +79,6 @@ void camera_update(Camera* camera, const Player* player, Map* map) {
 
     map_set_scroll(map, cam_world_x - PLAYER_OFFSET_X, cam_world_y - PLAYER_OFFSET_Y);
     map_apply_scroll(map);
+
+    HOST_PROF_END(g_prof_camera_update);
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <gb/gb.h>
+#include "game_types.h"
 #include "player.h"
 #include "map.h"
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "game_types.h"
+
+#define CAMERA_EASE_STEP_SHIFT 2
+#define CAMERA_EASE_STEPS 64
+#define CAMERA_EASE_FULL_DISTANCE 112
+
+static const UINT16 CAMERA_EASE_TABLE[64] = {
+    0, 0, 0, 1, 2, 3, 4, 6, 8, 10, 12, 15, 18, 21, 24, 28,
+    32, 36, 40, 45, 50, 55, 60, 66, 72, 78, 84, 91, 98, 105, 112, 120,
+    128, 136, 143, 151, 158, 165, 171, 178, 184, 190, 195, 201, 206, 211, 215, 220,
+    224, 228, 231, 235, 238, 241, 243, 246, 248, 250, 251, 253, 254, 255, 255, 256,
+};
+
+static const INT8 CAMERA_EASE_OFFSET_POS[64] = {
+    0, 0, 0, 0, 0, 1, 1, 2, 3, 4, 5, 6, 7, 9, 10, 12,
+    14, 15, 17, 19, 21, 24, 26, 28, 31, 34, 36, 39, 42, 45, 49, 52,
+    56, 59, 62, 66, 69, 72, 74, 77, 80, 83, 85, 87, 90, 92, 94, 96,
+    98, 99, 101, 102, 104, 105, 106, 107, 108, 109, 109, 110, 111, 111, 111, 112,
+};
+
+static const INT8 CAMERA_EASE_OFFSET_NEG[64] = {
+    0, 0, 0, -1, -1, -2, -2, -3, -4, -5, -6, -7, -8, -10, -11, -13,
+    -14, -16, -18, -20, -22, -25, -27, -29, -32, -35, -37, -40, -43, -46, -49, -53,
+    -56, -60, -63, -67, -70, -73, -75, -78, -81, -84, -86, -88, -91, -93, -95, -97,
+    -98, -100, -102, -103, -105, -106, -107, -108, -109, -110, -110, -111, -112, -112, -112, -112,
+};
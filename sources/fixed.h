@@ -0,0 +1,22 @@
+#pragma once
+
+#include "game_types.h"
+
+#define FP_ONE ((INT16)256)
+
+#define FP_MAKE(i, f) ((INT16)(((UINT16)(UINT8)(i) << 8) | (UINT8)(f)))
+#define FP_INT(v) ((INT8)((UINT16)(v) >> 8))
+#define FP_FRAC(v) ((UINT8)(v))
+
+#define FP_MIRROR(v) FP_MAKE(-FP_INT(v), FP_FRAC(v))
+
+#define FP_CLAMP_MAX(v, max) (((v) > (max)) ? (max) : (v))
+
+#define FP_SUB_FLOOR0(v, d) (((v) > (d)) ? (INT16)((v) - (d)) : (INT16)0)
+
+#define FP_POS_ADD(pos, sub, d) \
+    do { \
+        UINT16 fp_pos_sum = (UINT16)(sub) + FP_FRAC(d); \
+        (pos) += (INT16)FP_INT(d) + (INT16)(fp_pos_sum >> 8); \
+        (sub) = (UINT8)fp_pos_sum; \
+    } while (0)
@@ -0,0 +1,142 @@
+#if defined(FLIGHT_RECORDER) && defined(__SDCC)
+
+#include <gb/gb.h>
+#include <string.h>
+
+#include "flight_rec.h"
+#include "frame.h"
+
+#define FLIGHT_REC_SRAM_HEADER ((FlightRecSramHeader*)FLIGHT_REC_SRAM_BASE)
+#define FLIGHT_REC_SRAM_ENTRIES ((FlightRecEntry*)(FLIGHT_REC_SRAM_BASE + sizeof(FlightRecSramHeader)))
+#define FLIGHT_REC_SRAM_KEYFRAMES ((FlightRecKeyframe*)&FLIGHT_REC_SRAM_ENTRIES[FLIGHT_REC_FRAMES])
+
+static const char FLIGHT_REC_MAGIC[4] = { 'F', 'R', 'E', 'C' };
+
+FlightRecEntry g_flight_rec_entry;
+
+static UINT16 g_flight_rec_frame;
+static UINT8 g_flight_rec_lag_start;
+static BOOLEAN g_flight_rec_pending;
+static BOOLEAN g_flight_rec_frozen;
+
+static void flight_rec_reset(FlightRecSramHeader* h) {
+    memcpy(h->magic, FLIGHT_REC_MAGIC, sizeof(FLIGHT_REC_MAGIC));
+    h->version = FLIGHT_REC_SRAM_VERSION;
+    h->capacity = FLIGHT_REC_FRAMES;
+    h->entry_size = sizeof(FlightRecEntry);
+    h->player_size = sizeof(Player);
+    h->camera_size = sizeof(Camera);
+    h->map_size = sizeof(Map);
+    h->phase_count = PHASE_PROF_COUNT;
+    h->frozen = 0;
+    h->head = 0;
+    h->count = 0;
+    h->drop_frame = 0;
+    for (UINT8 i = 0; i < FLIGHT_REC_KEYFRAMES; ++i) {
+        h->keyframe_frame[i] = 0;
+        h->keyframe_valid[i] = 0;
+    }
+    h->sfx_save_size = SFX_SAVE_SIZE;
+    h->actor_save_size = FLIGHT_REC_ACTOR_SAVE_SIZE;
+    h->broadphase_save_size = FLIGHT_REC_BROADPHASE_SAVE_SIZE;
+    h->map_objects_save_size = FLIGHT_REC_MAP_OBJECTS_SAVE_SIZE;
+    h->speed_gov_save_size = SPEED_GOV_SAVE_SIZE;
+}
+
+void flight_rec_init(void) {
+    ENABLE_RAM;
+    SWITCH_RAM(FLIGHT_REC_SRAM_BANK);
+
+    FlightRecSramHeader* h = FLIGHT_REC_SRAM_HEADER;
+    if (memcmp(h->magic, FLIGHT_REC_MAGIC, sizeof(FLIGHT_REC_MAGIC)) != 0 || h->version != FLIGHT_REC_SRAM_VERSION ||
+        h->capacity != FLIGHT_REC_FRAMES || h->entry_size != sizeof(FlightRecEntry) ||
+        h->actor_save_size != FLIGHT_REC_ACTOR_SAVE_SIZE || h->map_objects_save_size != FLIGHT_REC_MAP_OBJECTS_SAVE_SIZE ||
+        joypad() == (J_B | J_SELECT)) {
+        flight_rec_reset(h);
+    }
+    g_flight_rec_frozen = h->frozen;
+
+    DISABLE_RAM;
+
+    g_flight_rec_frame = 0;
+    g_flight_rec_pending = 0;
+}
+
+static void flight_rec_commit(void) {
+    FlightRecEntry* e = &g_flight_rec_entry;
+
+    e->lag = (UINT8)(g_frame_lag_count - g_flight_rec_lag_start);
+    e->submit_ly = g_frame_submit_ly;
+#ifdef PHASE_PROFILE
+    memcpy(e->phase, g_phase_prof_last, sizeof(e->phase));
+#endif
+
+    ENABLE_RAM;
+    SWITCH_RAM(FLIGHT_REC_SRAM_BANK);
+
+    FlightRecSramHeader* h = FLIGHT_REC_SRAM_HEADER;
+    memcpy(&FLIGHT_REC_SRAM_ENTRIES[h->head], e, sizeof(FlightRecEntry));
+    if (++h->head == FLIGHT_REC_FRAMES) {
+        h->head = 0;
+    }
+    if (h->count < FLIGHT_REC_FRAMES) {
+        ++h->count;
+    }
+    if (e->lag) {
+        h->drop_frame = e->frame;
+        h->frozen = 1;
+        g_flight_rec_frozen = 1;
+    }
+
+    DISABLE_RAM;
+}
+
+static void flight_rec_keyframe(UINT16 frame) {
+    ENABLE_RAM;
+    SWITCH_RAM(FLIGHT_REC_SRAM_BANK);
+
+    FlightRecSramHeader* h = FLIGHT_REC_SRAM_HEADER;
+    UINT8 slot = (UINT8)((UINT8)frame / FLIGHT_REC_KEYFRAME_INTERVAL) & (FLIGHT_REC_KEYFRAMES - 1u);
+    FlightRecKeyframe* k = &FLIGHT_REC_SRAM_KEYFRAMES[slot];
+
+    h->keyframe_valid[slot] = 0;
+#ifdef ACTORS
+    actor_save(k->actors);
+    broadphase_save(k->broadphase);
+    map_objects_save(k->map_objects);
+#endif
+    sfx_save(k->sfx);
+    speed_gov_save(k->speed_gov);
+    h->keyframe_frame[slot] = frame;
+    h->keyframe_valid[slot] = 1;
+
+    DISABLE_RAM;
+}
+
+void flight_rec_frame(const Player* player, const Camera* camera, const Map* map, UINT8 prev_joy) {
+    if (g_flight_rec_frozen) {
+        return;
+    }
+
+    if (g_flight_rec_pending) {
+        flight_rec_commit();
+        if (g_flight_rec_frozen) {
+            return;
+        }
+    }
+
+    FlightRecEntry* e = &g_flight_rec_entry;
+    e->frame = g_flight_rec_frame++;
+    e->prev_joy = prev_joy;
+    e->joy = 0;
+    memcpy(&e->player, player, sizeof(Player));
+    memcpy(&e->camera, camera, sizeof(Camera));
+    memcpy(&e->map, map, sizeof(Map));
+    if (((UINT8)e->frame & (FLIGHT_REC_KEYFRAME_INTERVAL - 1u)) == 0) {
+        flight_rec_keyframe(e->frame);
+    }
+    g_flight_rec_lag_start = g_frame_lag_count;
+    g_flight_rec_pending = 1;
+}
+
+#endif
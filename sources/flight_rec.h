@@ -0,0 +1,96 @@
+#pragma once
+
+#include "game_types.h"
+#include "player.h"
+#include "camera.h"
+#include "map.h"
+#include "actor.h"
+#include "broadphase.h"
+#include "map_objects.h"
+#include "sfx.h"
+#include "speed_gov.h"
+#include "phase_prof.h"
+
+#ifndef FLIGHT_REC_FRAMES
+#define FLIGHT_REC_FRAMES 32u
+#endif
+
+#define FLIGHT_REC_SRAM_BANK 1u
+#define FLIGHT_REC_SRAM_BASE 0xA000u
+#define FLIGHT_REC_SRAM_VERSION 2u
+
+#define FLIGHT_REC_KEYFRAMES 2u
+#define FLIGHT_REC_KEYFRAME_INTERVAL (FLIGHT_REC_FRAMES / FLIGHT_REC_KEYFRAMES)
+
+#if FLIGHT_REC_FRAMES < 2 || FLIGHT_REC_FRAMES > 128 || (FLIGHT_REC_FRAMES & (FLIGHT_REC_FRAMES - 1u)) != 0
+#error "FLIGHT_REC_FRAMES must be a power of two between 2 and 128"
+#endif
+
+typedef struct FlightRecEntry {
+    UINT16 frame;
+    UINT8 joy;
+    UINT8 prev_joy;
+    UINT8 lag;
+    UINT8 submit_ly;
+    UINT16 phase[PHASE_PROF_COUNT];
+    Player player;
+    Camera camera;
+    Map map;
+} FlightRecEntry;
+
+#ifdef ACTORS
+#define FLIGHT_REC_ACTOR_SAVE_SIZE ACTOR_SAVE_SIZE
+#define FLIGHT_REC_BROADPHASE_SAVE_SIZE BROADPHASE_SAVE_SIZE
+#define FLIGHT_REC_MAP_OBJECTS_SAVE_SIZE MAP_OBJECTS_SAVE_SIZE
+#else
+#define FLIGHT_REC_ACTOR_SAVE_SIZE 0u
+#define FLIGHT_REC_BROADPHASE_SAVE_SIZE 0u
+#define FLIGHT_REC_MAP_OBJECTS_SAVE_SIZE 0u
+#endif
+
+typedef struct FlightRecKeyframe {
+#ifdef ACTORS
+    UINT8 actors[ACTOR_SAVE_SIZE];
+    UINT8 broadphase[BROADPHASE_SAVE_SIZE];
+    UINT8 map_objects[MAP_OBJECTS_SAVE_SIZE];
+#endif
+    UINT8 sfx[SFX_SAVE_SIZE];
+    UINT8 speed_gov[SPEED_GOV_SAVE_SIZE];
+} FlightRecKeyframe;
+
+typedef struct FlightRecSramHeader {
+    char magic[4];
+    UINT8 version;
+    UINT8 capacity;
+    UINT8 entry_size;
+    UINT8 player_size;
+    UINT8 camera_size;
+    UINT8 map_size;
+    UINT8 phase_count;
+    UINT8 frozen;
+    UINT8 head;
+    UINT8 count;
+    UINT16 drop_frame;
+    UINT16 keyframe_frame[FLIGHT_REC_KEYFRAMES];
+    UINT8 keyframe_valid[FLIGHT_REC_KEYFRAMES];
+    UINT8 sfx_save_size;
+    UINT16 actor_save_size;
+    UINT8 broadphase_save_size;
+    UINT8 map_objects_save_size;
+    UINT8 speed_gov_save_size;
+} FlightRecSramHeader;
+
+#ifdef FLIGHT_RECORDER
+
+extern FlightRecEntry g_flight_rec_entry;
+
+void flight_rec_init(void);
+
+void flight_rec_frame(const Player* player, const Camera* camera, const Map* map, UINT8 prev_joy);
+
+#define FLIGHT_REC_FRAME(player, camera, map, prev_joy) flight_rec_frame((player), (camera), (map), (prev_joy))
+#define FLIGHT_REC_INPUT(joy) (g_flight_rec_entry.joy = (joy))
+#else
+#define FLIGHT_REC_FRAME(player, camera, map, prev_joy) ((void)0)
+#define FLIGHT_REC_INPUT(joy) ((void)0)
+#endif
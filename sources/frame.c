@@ -0,0 +1,137 @@
+#include "frame.h"
+
+#if defined(__SDCC)
+
+#include <gb/gb.h>
+#include <gb/cgb.h>
+
+#include "sprite_stream.h"
+#include "phase_prof.h"
+#include "speed_gov.h"
+
+static FrameStrip g_frame_strips[FRAME_MAX_STRIPS];
+static volatile UINT8 g_frame_strip_head;
+static volatile UINT8 g_frame_strip_tail;
+
+static FrameShadow g_frame_back;
+static FrameShadow g_frame_ready;
+static volatile BOOLEAN g_frame_pending;
+static BOOLEAN g_frame_started;
+static BOOLEAN g_frame_submitted;
+
+UINT8 g_frame_lag_count;
+UINT8 g_frame_strip_overflow;
+UINT8 g_frame_strip_deferred;
+UINT8 g_frame_submit_ly;
+
+#define FRAME_STRIPS_QUEUED() ((UINT8)(g_frame_strip_tail - g_frame_strip_head))
+
+void frame_init(void) {
+    g_frame_strip_head = 0;
+    g_frame_strip_tail = 0;
+    g_frame_back.strip_end = 0;
+    g_frame_pending = 0;
+    g_frame_started = 0;
+    g_frame_submitted = 0;
+    g_frame_lag_count = 0;
+    g_frame_strip_overflow = 0;
+    g_frame_strip_deferred = 0;
+}
+
+void frame_start(void) {
+    g_frame_started = 1;
+
+    CRITICAL {
+        add_VBL(frame_vbl_isr);
+    }
+}
+
+void frame_set_scroll(UINT8 x, UINT8 y) {
+    g_frame_back.scx = x;
+    g_frame_back.scy = y;
+    if (!g_frame_started) {
+        move_bkg(x, y);
+    }
+}
+
+FrameStrip* frame_strip_begin(UINT8 x, UINT8 y, UINT8 w, UINT8 h) {
+    if (!g_frame_started) {
+        return 0;
+    }
+    if (FRAME_STRIPS_QUEUED() == FRAME_MAX_STRIPS) {
+        ++g_frame_strip_overflow;
+        do {
+            wait_vbl_done();
+        } while (FRAME_STRIPS_QUEUED() == FRAME_MAX_STRIPS);
+    }
+
+    FrameStrip* s = &g_frame_strips[g_frame_strip_tail & (FRAME_MAX_STRIPS - 1u)];
+    s->x = x;
+    s->y = y;
+    s->w = w;
+    s->h = h;
+    s->cost = (UINT8)((UINT8)(w * h) << 1);
+    return s;
+}
+
+void frame_strip_end(void) {
+    ++g_frame_strip_tail;
+}
+
+void frame_submit(void) {
+    g_frame_submit_ly = LY_REG;
+    g_frame_back.strip_end = g_frame_strip_tail;
+
+    CRITICAL {
+        g_frame_ready = g_frame_back;
+        g_frame_pending = 1;
+        g_frame_submitted = 1;
+        ENABLE_OAM_DMA;
+    }
+}
+
+void frame_vbl_isr(void) NONBANKED {
+    PHASE_PROF_ISR_BEGIN();
+
+    UINT8 head = g_frame_strip_head;
+    UINT8 tail = g_frame_strip_tail;
+    UINT8 budget = g_speed_fast ? (UINT8)(FRAME_VBL_TILE_BUDGET << 1) : (UINT8)FRAME_VBL_TILE_BUDGET;
+
+    if (head != tail) {
+        UINT8 old_vbk = VBK_REG;
+        do {
+            const FrameStrip* s = &g_frame_strips[head & (FRAME_MAX_STRIPS - 1u)];
+            if (s->cost > budget) {
+                ++g_frame_strip_deferred;
+                break;
+            }
+            budget -= s->cost;
+
+            VBK_REG = VBK_TILES;
+            set_bkg_tiles(s->x, s->y, s->w, s->h, s->tiles);
+            VBK_REG = VBK_ATTRIBUTES;
+            set_bkg_tiles(s->x, s->y, s->w, s->h, s->attrs);
+        } while (++head != tail);
+        VBK_REG = old_vbk;
+        g_frame_strip_head = head;
+    }
+
+    if (!g_frame_pending) {
+        if (g_frame_submitted) {
+            ++g_frame_lag_count;
+        }
+    } else if ((UINT8)(tail - head) > (UINT8)(tail - g_frame_ready.strip_end)) {
+        ++g_frame_lag_count;
+    } else {
+        SCX_REG = g_frame_ready.scx;
+        SCY_REG = g_frame_ready.scy;
+
+        sprite_stream_vblank(budget);
+
+        g_frame_pending = 0;
+    }
+
+    PHASE_PROF_ISR_END(PHASE_PROF_VRAM);
+}
+
+#endif
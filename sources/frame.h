@@ -0,0 +1,60 @@
+#pragma once
+
+#include "game_types.h"
+
+#ifndef FRAME_MAX_STRIPS
+#define FRAME_MAX_STRIPS 8
+#endif
+
+#define FRAME_STRIP_MAX_TILES 21
+
+#ifndef FRAME_VBL_TILE_BUDGET
+#define FRAME_VBL_TILE_BUDGET 48
+#endif
+
+#if (FRAME_MAX_STRIPS & (FRAME_MAX_STRIPS - 1)) != 0
+#error "FRAME_MAX_STRIPS must be a power of two"
+#endif
+#if FRAME_VBL_TILE_BUDGET < 2 * FRAME_STRIP_MAX_TILES || FRAME_VBL_TILE_BUDGET > 127
+#error "FRAME_VBL_TILE_BUDGET must hold one strip in both VRAM planes and double in a byte"
+#endif
+
+#if defined(__SDCC)
+#include <gbdk/platform.h>
+
+typedef struct FrameStrip {
+    UINT8 x;
+    UINT8 y;
+    UINT8 w;
+    UINT8 h;
+    UINT8 cost;
+    UINT8 tiles[FRAME_STRIP_MAX_TILES];
+    UINT8 attrs[FRAME_STRIP_MAX_TILES];
+} FrameStrip;
+
+typedef struct FrameShadow {
+    UINT8 scx;
+    UINT8 scy;
+    UINT8 strip_end;
+} FrameShadow;
+
+extern UINT8 g_frame_lag_count;
+extern UINT8 g_frame_strip_overflow;
+extern UINT8 g_frame_strip_deferred;
+extern UINT8 g_frame_submit_ly;
+
+void frame_init(void);
+
+void frame_start(void);
+
+void frame_set_scroll(UINT8 x, UINT8 y);
+
+FrameStrip* frame_strip_begin(UINT8 x, UINT8 y, UINT8 w, UINT8 h);
+
+void frame_strip_end(void);
+
+void frame_submit(void);
+
+void frame_vbl_isr(void) NONBANKED;
+
+#endif
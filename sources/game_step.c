@@ -0,0 +1,62 @@
+#include "game_step.h"
+
+#include "actor.h"
+#include "bank_scope.h"
+#include "broadphase.h"
+#include "frame.h"
+#include "input.h"
+#include "oam.h"
+#include "phase_prof.h"
+#include "speed_gov.h"
+
+#if defined(__SDCC)
+#include <gb/gb.h>
+#else
+#include "host_hw.h"
+#include "sprite_stream.h"
+
+static void game_host_vblank(void) {
+    sprite_stream_vblank(g_speed_fast ? (UINT8)(FRAME_VBL_TILE_BUDGET << 1) : (UINT8)FRAME_VBL_TILE_BUDGET);
+    host_hw_oam_dma();
+}
+#endif
+
+UINT8 game_step(Player* player, Camera* camera, Map* map) {
+    input_update(player, camera);
+    PHASE_PROF_MARK(PHASE_PROF_INPUT);
+
+    BANK_SWITCH(BANK_ASSET_TILEMAP, TILEMAP_MAP_BANK);
+
+    player_update(player);
+    PHASE_PROF_MARK(PHASE_PROF_PLAYER);
+
+#ifdef ACTORS
+    actor_update_all();
+
+    broadphase_update();
+    PHASE_PROF_MARK(PHASE_PROF_ACTORS);
+#endif
+
+    camera_update(camera, player, map);
+    PHASE_PROF_MARK(PHASE_PROF_CAMERA);
+
+#if defined(__SDCC)
+    DISABLE_OAM_DMA;
+#endif
+    oam_begin();
+    player_draw(player, CAMERA_TO_SCREEN_X(*camera), CAMERA_TO_SCREEN_Y(*camera));
+    oam_end();
+
+#if defined(__SDCC)
+    frame_submit();
+#else
+    game_host_vblank();
+#endif
+    PHASE_PROF_MARK(PHASE_PROF_DRAW);
+
+    UINT8 slack = speed_gov_wait_vbl();
+    speed_gov_update(slack);
+    PHASE_PROF_MARK(PHASE_PROF_WAIT);
+
+    return slack;
+}
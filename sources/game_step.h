@@ -0,0 +1,8 @@
+#pragma once
+
+#include "game_types.h"
+#include "camera.h"
+#include "map.h"
+#include "player.h"
+
+UINT8 game_step(Player* player, Camera* camera, Map* map);
@@ -15,3 +15,7 @@ typedef uint32_t UINT32;
 typedef uint8_t BOOLEAN;
 
 #endif
+
+#if defined(FLIGHT_RECORDER) || !defined(__SDCC)
+#define GAME_SNAPSHOT
+#endif
@@ -0,0 +1,669 @@
+#if defined(HOST_GAME) && !defined(__SDCC)
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "actor.h"
+#include "broadphase.h"
+#include "camera.h"
+#include "game_step.h"
+#include "host_hw.h"
+#include "host_prof.h"
+#include "input.h"
+#include "map.h"
+#include "map_objects.h"
+#include "oam.h"
+#include "player.h"
+#include "sfx.h"
+#include "speed_gov.h"
+
+#define HOST_GAME_START_X 500
+#define HOST_GAME_START_Y 300
+#define HOST_GAME_SCRIPT_FRAMES 3600u
+#define HOST_GAME_LEVEL_W 256u
+#define HOST_GAME_LEVEL_H 64u
+#define HOST_GAME_FLOOR_Y 45u
+#define HOST_GAME_TRACE_EVENTS_PER_FRAME 16u
+
+typedef struct HostGameKeyframe {
+#ifdef ACTORS
+    UINT8 actors[ACTOR_SAVE_SIZE];
+    UINT8 broadphase[BROADPHASE_SAVE_SIZE];
+    UINT8 map_objects[MAP_OBJECTS_SAVE_SIZE];
+#endif
+    UINT8 sfx[SFX_SAVE_SIZE];
+    UINT8 speed_gov[SPEED_GOV_SAVE_SIZE];
+} HostGameKeyframe;
+
+typedef struct HostGameTrace {
+    UINT8* joy;
+    UINT32 frames;
+    UINT8 prev_joy;
+    BOOLEAN has_start;
+    BOOLEAN has_keyframe;
+    Player player;
+    Camera camera;
+    Map map;
+    HostGameKeyframe keyframe;
+} HostGameTrace;
+
+typedef struct HostGameField {
+    const char* object;
+    const char* key;
+    size_t offset;
+    size_t size;
+} HostGameField;
+
+#define HOST_GAME_FIELD(type, field) { 0, #field, offsetof(type, field), sizeof(((type*)0)->field) }
+#define HOST_GAME_SUBFIELD(type, object, field) { #object, #field, offsetof(type, object.field), sizeof(((type*)0)->object.field) }
+
+static const HostGameField HOST_GAME_PLAYER_FIELDS[] = {
+    HOST_GAME_FIELD(Player, x),
+    HOST_GAME_FIELD(Player, y),
+    HOST_GAME_FIELD(Player, vel_x_fp),
+    HOST_GAME_FIELD(Player, vel_y),
+    HOST_GAME_FIELD(Player, x_subpixel),
+    HOST_GAME_FIELD(Player, y_subpixel),
+    HOST_GAME_FIELD(Player, y_speed_fp),
+    HOST_GAME_FIELD(Player, y_dir),
+    HOST_GAME_FIELD(Player, y_arc),
+    HOST_GAME_FIELD(Player, y_arc_step),
+    HOST_GAME_FIELD(Player, gravity_timer),
+    HOST_GAME_SUBFIELD(Player, anim, clip),
+    HOST_GAME_SUBFIELD(Player, anim, step),
+    HOST_GAME_SUBFIELD(Player, anim, timer),
+    HOST_GAME_FIELD(Player, accel_mode),
+    HOST_GAME_FIELD(Player, facing_left),
+    HOST_GAME_FIELD(Player, on_ground),
+    HOST_GAME_FIELD(Player, jumping),
+    HOST_GAME_FIELD(Player, is_moving),
+    HOST_GAME_FIELD(Player, sprinting),
+    HOST_GAME_FIELD(Player, in_water),
+};
+
+static const HostGameField HOST_GAME_CAMERA_FIELDS[] = {
+    HOST_GAME_FIELD(Camera, rel_x_from_player),
+    HOST_GAME_FIELD(Camera, rel_y_from_player),
+    HOST_GAME_FIELD(Camera, vel_x),
+    HOST_GAME_FIELD(Camera, progress_x),
+    HOST_GAME_FIELD(Camera, start_offset_x),
+    HOST_GAME_FIELD(Camera, move_distance_x),
+    HOST_GAME_FIELD(Camera, progress_y),
+    HOST_GAME_FIELD(Camera, y_lookahead),
+};
+
+static const HostGameField HOST_GAME_MAP_FIELDS[] = {
+    HOST_GAME_FIELD(Map, scroll_x),
+    HOST_GAME_FIELD(Map, scroll_y),
+    HOST_GAME_FIELD(Map, tile_x),
+    HOST_GAME_FIELD(Map, tile_y),
+    HOST_GAME_FIELD(Map, tile_offset_x),
+    HOST_GAME_FIELD(Map, tile_offset_y),
+    HOST_GAME_FIELD(Map, vram_x_left),
+    HOST_GAME_FIELD(Map, vram_y_top),
+};
+
+#define HOST_GAME_FIELD_COUNT(fields) (sizeof(fields) / sizeof((fields)[0]))
+
+static char* host_game_read_file(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* data = (n >= 0) ? (char*)malloc((size_t)n + 1u) : 0;
+    if (data && fread(data, 1, (size_t)n, f) != (size_t)n) {
+        free(data);
+        data = 0;
+    }
+    fclose(f);
+    if (data) {
+        data[n] = 0;
+        *size = (size_t)n;
+    }
+    return data;
+}
+
+static const char* host_game_json_ws(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+        p++;
+    }
+    return p;
+}
+
+static const char* host_game_json_skip(const char* p) {
+    p = host_game_json_ws(p);
+    if (*p == '"') {
+        for (p++; *p && *p != '"'; p++) {
+            if (*p == '\\' && p[1]) {
+                p++;
+            }
+        }
+        return *p ? p + 1 : 0;
+    }
+    if (*p == '{' || *p == '[') {
+        char close = (*p == '{') ? '}' : ']';
+        p = host_game_json_ws(p + 1);
+        if (*p == close) {
+            return p + 1;
+        }
+        while (p) {
+            if (close == '}') {
+                p = (*p == '"') ? host_game_json_skip(p) : 0;
+                p = p ? host_game_json_ws(p) : 0;
+                if (!p || *p != ':') {
+                    return 0;
+                }
+                p++;
+            }
+            p = host_game_json_skip(p);
+            if (!p) {
+                return 0;
+            }
+            p = host_game_json_ws(p);
+            if (*p != ',') {
+                return (*p == close) ? p + 1 : 0;
+            }
+            p = host_game_json_ws(p + 1);
+        }
+        return 0;
+    }
+    const char* start = p;
+    while (*p && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+        p++;
+    }
+    return (p != start) ? p : 0;
+}
+
+static const char* host_game_json_member(const char* object, const char* key) {
+    const char* p = object ? host_game_json_ws(object) : 0;
+    if (!p || *p != '{') {
+        return 0;
+    }
+    p = host_game_json_ws(p + 1);
+    size_t key_len = strlen(key);
+    while (*p == '"') {
+        const char* name = p + 1;
+        const char* end = host_game_json_skip(p);
+        if (!end) {
+            return 0;
+        }
+        BOOLEAN match = ((size_t)(end - 1 - name) == key_len) && memcmp(name, key, key_len) == 0;
+        p = host_game_json_ws(end);
+        if (*p != ':') {
+            return 0;
+        }
+        p = host_game_json_ws(p + 1);
+        if (match) {
+            return p;
+        }
+        p = host_game_json_skip(p);
+        if (!p) {
+            return 0;
+        }
+        p = host_game_json_ws(p);
+        if (*p != ',') {
+            return 0;
+        }
+        p = host_game_json_ws(p + 1);
+    }
+    return 0;
+}
+
+static BOOLEAN host_game_json_int(const char* value, long* out) {
+    char* end;
+    if (!value) {
+        return 0;
+    }
+    *out = strtol(value, &end, 10);
+    return end != value && host_game_json_skip(value) == end;
+}
+
+static int host_game_json_hex_digit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static BOOLEAN host_game_json_hex(const char* value, UINT8* out, size_t size) {
+    if (!value || *value != '"') {
+        return 0;
+    }
+    const char* p = value + 1;
+    for (size_t i = 0; i < size; i++) {
+        int hi = host_game_json_hex_digit(p[0]);
+        int lo = (hi >= 0) ? host_game_json_hex_digit(p[1]) : -1;
+        if (lo < 0) {
+            return 0;
+        }
+        out[i] = (UINT8)((hi << 4) | lo);
+        p += 2;
+    }
+    return *p == '"';
+}
+
+static BOOLEAN host_game_json_fields(const char* object, const HostGameField* fields, size_t count, void* out, const char* what) {
+    for (size_t i = 0; i < count; i++) {
+        const HostGameField* f = &fields[i];
+        const char* parent = f->object ? host_game_json_member(object, f->object) : object;
+        long v;
+        if (!host_game_json_int(host_game_json_member(parent, f->key), &v)) {
+            fprintf(stderr, "trace start: %s.%s%s%s is missing\n", what, f->object ? f->object : "", f->object ? "." : "", f->key);
+            return 0;
+        }
+        UINT8* dst = (UINT8*)out + f->offset;
+        if (f->size == 1u) {
+            *dst = (UINT8)v;
+        } else {
+            UINT16 w = (UINT16)v;
+            memcpy(dst, &w, sizeof(w));
+        }
+    }
+    return 1;
+}
+
+static BOOLEAN host_game_json_keyframe(const char* object, HostGameKeyframe* keyframe) {
+    static const struct {
+        const char* key;
+        size_t offset;
+        size_t size;
+    } parts[] = {
+#ifdef ACTORS
+        { "actors", offsetof(HostGameKeyframe, actors), ACTOR_SAVE_SIZE },
+        { "broadphase", offsetof(HostGameKeyframe, broadphase), BROADPHASE_SAVE_SIZE },
+        { "map_objects", offsetof(HostGameKeyframe, map_objects), MAP_OBJECTS_SAVE_SIZE },
+#endif
+        { "sfx", offsetof(HostGameKeyframe, sfx), SFX_SAVE_SIZE },
+        { "speed_gov", offsetof(HostGameKeyframe, speed_gov), SPEED_GOV_SAVE_SIZE },
+    };
+    for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+        if (!host_game_json_hex(host_game_json_member(object, parts[i].key), (UINT8*)keyframe + parts[i].offset, parts[i].size)) {
+            fprintf(stderr, "trace keyframe: %s is missing or not %u bytes; was the trace made by this build?\n", parts[i].key,
+                (unsigned)parts[i].size);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static BOOLEAN host_game_load_json(HostGameTrace* trace, const char* text) {
+    const char* root = host_game_json_ws(text);
+    if (!host_game_json_skip(root)) {
+        fprintf(stderr, "trace is not well-formed JSON\n");
+        return 0;
+    }
+
+    const char* p = host_game_json_member(root, "joypad");
+    if (!p || *p != '[') {
+        fprintf(stderr, "trace has no joypad array\n");
+        return 0;
+    }
+    p = host_game_json_ws(p + 1);
+
+    UINT32 cap = 256u;
+    trace->joy = (UINT8*)malloc(cap);
+    trace->frames = 0;
+    while (trace->joy && *p != ']') {
+        long v;
+        if (!host_game_json_int(p, &v) || v < 0 || v > 255) {
+            fprintf(stderr, "trace joypad entry %u is not a byte\n", (unsigned)trace->frames);
+            return 0;
+        }
+        if (trace->frames == cap) {
+            cap *= 2u;
+            trace->joy = (UINT8*)realloc(trace->joy, cap);
+            if (!trace->joy) {
+                return 0;
+            }
+        }
+        trace->joy[trace->frames++] = (UINT8)v;
+        p = host_game_json_ws(host_game_json_skip(p));
+        if (*p == ',') {
+            p = host_game_json_ws(p + 1);
+        }
+    }
+    if (!trace->joy) {
+        return 0;
+    }
+
+    const char* start = host_game_json_member(root, "start");
+    if (!start) {
+        return 1;
+    }
+    long prev;
+    if (!host_game_json_int(host_game_json_member(start, "prev_joy"), &prev)) {
+        fprintf(stderr, "trace start: prev_joy is missing\n");
+        return 0;
+    }
+    trace->prev_joy = (UINT8)prev;
+    if (!host_game_json_fields(host_game_json_member(start, "player"), HOST_GAME_PLAYER_FIELDS,
+            HOST_GAME_FIELD_COUNT(HOST_GAME_PLAYER_FIELDS), &trace->player, "player") ||
+        !host_game_json_fields(host_game_json_member(start, "camera"), HOST_GAME_CAMERA_FIELDS,
+            HOST_GAME_FIELD_COUNT(HOST_GAME_CAMERA_FIELDS), &trace->camera, "camera") ||
+        !host_game_json_fields(host_game_json_member(start, "map"), HOST_GAME_MAP_FIELDS,
+            HOST_GAME_FIELD_COUNT(HOST_GAME_MAP_FIELDS), &trace->map, "map")) {
+        return 0;
+    }
+    trace->has_start = 1;
+
+    const char* keyframe = host_game_json_member(start, "keyframe");
+    if (keyframe && *keyframe == '{') {
+        if (!host_game_json_keyframe(keyframe, &trace->keyframe)) {
+            return 0;
+        }
+        trace->has_keyframe = 1;
+    } else {
+        fprintf(stderr, "warning: trace has no keyframe; actors, objects and sound start from power-on state\n");
+    }
+    return 1;
+}
+
+static BOOLEAN host_game_load_trace(HostGameTrace* trace, const char* path) {
+    size_t size = 0;
+    char* data = host_game_read_file(path, &size);
+    if (!data) {
+        return 0;
+    }
+
+    BOOLEAN ok;
+    size_t len = strlen(path);
+    if (len > 5u && strcmp(path + len - 5u, ".json") == 0) {
+        ok = host_game_load_json(trace, data);
+        free(data);
+    } else {
+        trace->joy = (UINT8*)data;
+        trace->frames = (UINT32)size;
+        ok = 1;
+    }
+    return ok;
+}
+
+static void host_game_script_trace(HostGameTrace* trace, UINT32 frames) {
+    trace->joy = (UINT8*)malloc(frames ? frames : 1u);
+    trace->frames = frames;
+    for (UINT32 f = 0; f < frames; f++) {
+        UINT32 phase = f % 600u;
+        UINT8 joy = (phase < 360u) ? J_RIGHT : (phase < 540u) ? J_LEFT : 0;
+        if ((f % 90u) < 20u) {
+            joy |= J_A;
+        }
+        if ((f % 240u) >= 200u) {
+            joy |= J_B;
+        }
+        trace->joy[f] = joy;
+    }
+}
+
+#ifndef HOST_MAP_DATA
+static void host_game_default_level(void) {
+    static UINT8 level[HOST_GAME_LEVEL_W * HOST_GAME_LEVEL_H];
+    memset(level, MAP_BLOCKTYPE_AIR, sizeof(level));
+
+    for (UINT16 x = 0; x < HOST_GAME_LEVEL_W; x++) {
+        for (UINT16 y = HOST_GAME_FLOOR_Y; y < HOST_GAME_LEVEL_H; y++) {
+            level[y * HOST_GAME_LEVEL_W + x] = MAP_BLOCKTYPE_SOLID;
+        }
+    }
+    for (UINT16 y = 0; y < HOST_GAME_FLOOR_Y; y++) {
+        level[y * HOST_GAME_LEVEL_W] = MAP_BLOCKTYPE_SOLID;
+        level[y * HOST_GAME_LEVEL_W + HOST_GAME_LEVEL_W - 1u] = MAP_BLOCKTYPE_SOLID;
+    }
+    for (UINT16 i = 0; i < 24u; i++) {
+        UINT16 px = (UINT16)(12u + i * 10u);
+        UINT16 py = (UINT16)(HOST_GAME_FLOOR_Y - 4u - (i % 3u) * 3u);
+        for (UINT16 x = px; x < px + 5u && x < HOST_GAME_LEVEL_W - 1u; x++) {
+            level[py * HOST_GAME_LEVEL_W + x] = MAP_BLOCKTYPE_SOLID;
+        }
+    }
+    map_test_load(level, HOST_GAME_LEVEL_W, HOST_GAME_LEVEL_H);
+}
+
+static BOOLEAN host_game_load_level(const char* path, UINT16 width, UINT16 height) {
+    size_t size = 0;
+    char* data = host_game_read_file(path, &size);
+    if (!data || size < (size_t)width * height) {
+        free(data);
+        return 0;
+    }
+    map_test_load((const UINT8*)data, width, height);
+    free(data);
+    return 1;
+}
+#endif
+
+static void host_game_stats_row(FILE* csv, UINT32 frame, const HostHwStats* d, const Player* player, const Map* map) {
+    fprintf(csv, "%u,%u,%u,%u,%u,%u,%d,%d,%d,%d\n", (unsigned)frame, (unsigned)d->seeks, (unsigned)d->strips,
+        (unsigned)d->vram_bytes, (unsigned)d->oam_bytes, (unsigned)d->collision_queries,
+        player->x, player->y, map->scroll_x, map->scroll_y);
+}
+
+static void host_game_usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [trace.joy|trace.json] [-frames n] [-repeat n]", argv0);
+#ifndef HOST_MAP_DATA
+    fprintf(stderr, " [-level file w h]");
+#endif
+    fprintf(stderr, " [-csv out.csv]");
+#ifdef HOST_PROF
+    fprintf(stderr, " [-prof-trace out.json]");
+#endif
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv) {
+    HostGameTrace trace;
+    const char* trace_path = 0;
+    const char* csv_path = 0;
+#ifdef HOST_PROF
+    const char* prof_trace_path = 0;
+#endif
+#ifndef HOST_MAP_DATA
+    const char* level_path = 0;
+    UINT16 level_w = 0;
+    UINT16 level_h = 0;
+#endif
+    UINT32 script_frames = HOST_GAME_SCRIPT_FRAMES;
+    UINT32 repeat = 1;
+
+    memset(&trace, 0, sizeof(trace));
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc) {
+            script_frames = (UINT32)strtoul(argv[++i], 0, 0);
+        } else if (strcmp(argv[i], "-repeat") == 0 && i + 1 < argc) {
+            repeat = (UINT32)strtoul(argv[++i], 0, 0);
+#ifndef HOST_MAP_DATA
+        } else if (strcmp(argv[i], "-level") == 0 && i + 3 < argc) {
+            level_path = argv[++i];
+            level_w = (UINT16)strtoul(argv[++i], 0, 0);
+            level_h = (UINT16)strtoul(argv[++i], 0, 0);
+#endif
+        } else if (strcmp(argv[i], "-csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+#ifdef HOST_PROF
+        } else if (strcmp(argv[i], "-prof-trace") == 0 && i + 1 < argc) {
+            prof_trace_path = argv[++i];
+#endif
+        } else if (argv[i][0] != '-' && !trace_path) {
+            trace_path = argv[i];
+        } else {
+            host_game_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (trace_path) {
+        if (!host_game_load_trace(&trace, trace_path)) {
+            fprintf(stderr, "%s: cannot read a joypad trace\n", trace_path);
+            return 1;
+        }
+#ifndef HOST_MAP_DATA
+        if (trace.has_start && !level_path) {
+            fprintf(stderr, "warning: %s was recorded on the game map; build with HOST_MAP_DATA to replay it on that map\n",
+                trace_path);
+        }
+#endif
+    } else {
+        host_game_script_trace(&trace, script_frames);
+    }
+
+    FILE* csv = 0;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) {
+            fprintf(stderr, "%s: cannot write\n", csv_path);
+            return 1;
+        }
+        fprintf(csv, "frame,seeks,strips,vram_bytes,oam_bytes,collision_queries,player_x,player_y,scroll_x,scroll_y\n");
+    }
+
+    HostHwStats max;
+    HostHwStats total;
+    memset(&max, 0, sizeof(max));
+    memset(&total, 0, sizeof(total));
+    uint64_t ns = 0;
+    UINT32 hash = 2166136261u;
+    UINT32 frames = 0;
+
+#ifdef HOST_PROF
+    host_prof_reset();
+    if (prof_trace_path && !host_prof_trace_start((size_t)trace.frames * repeat * HOST_GAME_TRACE_EVENTS_PER_FRAME)) {
+        fprintf(stderr, "%s: cannot allocate the profile trace\n", prof_trace_path);
+        return 1;
+    }
+#endif
+
+    for (UINT32 r = 0; r < repeat; r++) {
+        Player player;
+        Camera camera;
+        Map map;
+
+        host_hw_reset();
+        sfx_init();
+        speed_gov_init();
+        player_init(&player, HOST_GAME_START_X, HOST_GAME_START_Y);
+        camera_init(&camera, &player);
+#ifdef ACTORS
+        actor_system_init();
+        broadphase_init();
+#endif
+        map_init(&map);
+#ifndef HOST_MAP_DATA
+        if (level_path) {
+            if (!host_game_load_level(level_path, level_w, level_h)) {
+                fprintf(stderr, "%s: cannot read a %ux%u level\n", level_path, (unsigned)level_w, (unsigned)level_h);
+                return 1;
+            }
+        } else {
+            host_game_default_level();
+        }
+#endif
+        PREV_JOY = trace.prev_joy;
+
+        if (trace.has_start) {
+            player = trace.player;
+            camera = trace.camera;
+            map = trace.map;
+        } else {
+            INT16 cam_world_x = (player.x + PLAYER_HALF_WIDTH) + camera.rel_x_from_player;
+            INT16 cam_world_y = player.y + camera.rel_y_from_player;
+            map_set_scroll_immediate(&map, cam_world_x - PLAYER_OFFSET_X, cam_world_y - PLAYER_OFFSET_Y);
+        }
+        map_apply_scroll(&map);
+        map_draw_full_screen(&map);
+        if (trace.has_keyframe) {
+#ifdef ACTORS
+            actor_load(trace.keyframe.actors);
+            broadphase_load(trace.keyframe.broadphase);
+            map_objects_load(trace.keyframe.map_objects);
+#endif
+            sfx_load(trace.keyframe.sfx);
+            speed_gov_load(trace.keyframe.speed_gov);
+        } else {
+            map_objects_activate_window(map.tile_x, map.tile_y);
+        }
+        oam_init();
+        memset(&g_host_hw_stats, 0, sizeof(g_host_hw_stats));
+
+        for (UINT32 f = 0; f < trace.frames; f++) {
+            HostHwStats before = g_host_hw_stats;
+            uint64_t t0 = host_prof_now_ns();
+
+            g_input_host_joy = trace.joy[f];
+            game_step(&player, &camera, &map);
+            sfx_tick();
+
+            ns += host_prof_now_ns() - t0;
+
+            HostHwStats d;
+            d.seeks = g_host_hw_stats.seeks - before.seeks;
+            d.strips = g_host_hw_stats.strips - before.strips;
+            d.vram_bytes = g_host_hw_stats.vram_bytes - before.vram_bytes;
+            d.oam_bytes = g_host_hw_stats.oam_bytes - before.oam_bytes;
+            d.collision_queries = g_host_hw_stats.collision_queries - before.collision_queries;
+            if (d.seeks > max.seeks) max.seeks = d.seeks;
+            if (d.strips > max.strips) max.strips = d.strips;
+            if (d.vram_bytes > max.vram_bytes) max.vram_bytes = d.vram_bytes;
+            if (d.oam_bytes > max.oam_bytes) max.oam_bytes = d.oam_bytes;
+            if (d.collision_queries > max.collision_queries) max.collision_queries = d.collision_queries;
+            if (csv && r == 0u) {
+                host_game_stats_row(csv, f, &d, &player, &map);
+            }
+            frames++;
+        }
+
+        total.seeks += g_host_hw_stats.seeks;
+        total.strips += g_host_hw_stats.strips;
+        total.vram_bytes += g_host_hw_stats.vram_bytes;
+        total.oam_bytes += g_host_hw_stats.oam_bytes;
+        total.collision_queries += g_host_hw_stats.collision_queries;
+        if (r == 0u) {
+            hash = host_hw_hash(hash);
+            hash = (hash ^ (UINT16)player.x) * 16777619u;
+            hash = (hash ^ (UINT16)player.y) * 16777619u;
+            printf("end state: player %d,%d scroll %d,%d hash %08x\n", player.x, player.y, map.scroll_x, map.scroll_y, (unsigned)hash);
+        }
+    }
+
+    if (csv) {
+        fclose(csv);
+    }
+
+    double n = frames ? (double)frames : 1.0;
+    printf("%u frames (%u x %u), %.3f ms total, %.1f ns/frame\n", (unsigned)frames, (unsigned)trace.frames, (unsigned)repeat,
+        (double)ns / 1e6, (double)ns / n);
+    printf("%-18s %10s %9s %6s\n", "per frame", "total", "avg", "max");
+    printf("%-18s %10u %9.2f %6u\n", "seeks", (unsigned)total.seeks, total.seeks / n, (unsigned)max.seeks);
+    printf("%-18s %10u %9.2f %6u\n", "strip decodes", (unsigned)total.strips, total.strips / n, (unsigned)max.strips);
+    printf("%-18s %10u %9.2f %6u\n", "VRAM bytes", (unsigned)total.vram_bytes, total.vram_bytes / n, (unsigned)max.vram_bytes);
+    printf("%-18s %10u %9.2f %6u\n", "OAM bytes", (unsigned)total.oam_bytes, total.oam_bytes / n, (unsigned)max.oam_bytes);
+    printf("%-18s %10u %9.2f %6u\n", "collision queries", (unsigned)total.collision_queries, total.collision_queries / n,
+        (unsigned)max.collision_queries);
+
+#ifdef HOST_PROF
+    printf("\n");
+    host_prof_report(stdout);
+    if (prof_trace_path) {
+        if (!host_prof_trace_write(prof_trace_path)) {
+            fprintf(stderr, "%s: cannot write\n", prof_trace_path);
+            return 1;
+        }
+        printf("wrote %s\n", prof_trace_path);
+    }
+#endif
+
+    free(trace.joy);
+    return 0;
+}
+
+#endif
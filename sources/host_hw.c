@@ -0,0 +1,92 @@
+#ifndef __SDCC
+
+#include "host_hw.h"
+
+#include <string.h>
+
+UINT8 g_host_hw_bkg_tiles[HOST_HW_BKG_W * HOST_HW_BKG_H];
+UINT8 g_host_hw_bkg_attrs[HOST_HW_BKG_W * HOST_HW_BKG_H];
+UINT8 g_host_hw_shadow_oam[HOST_HW_OAM_BYTES];
+UINT8 g_host_hw_oam[HOST_HW_OAM_BYTES];
+UINT8 g_host_hw_scx;
+UINT8 g_host_hw_scy;
+HostHwStats g_host_hw_stats;
+
+void host_hw_reset(void) {
+    memset(g_host_hw_bkg_tiles, 0, sizeof(g_host_hw_bkg_tiles));
+    memset(g_host_hw_bkg_attrs, 0, sizeof(g_host_hw_bkg_attrs));
+    memset(g_host_hw_shadow_oam, 0, sizeof(g_host_hw_shadow_oam));
+    memset(g_host_hw_oam, 0, sizeof(g_host_hw_oam));
+    g_host_hw_scx = 0;
+    g_host_hw_scy = 0;
+    memset(&g_host_hw_stats, 0, sizeof(g_host_hw_stats));
+}
+
+void host_hw_set_bkg_tiles(UINT8 x, UINT8 y, UINT8 w, UINT8 h, const UINT8* tiles, const UINT8* attrs) {
+    for (UINT8 row = 0; row < h; ++row) {
+        UINT16 base = (UINT16)(((y + row) & (HOST_HW_BKG_H - 1u)) * HOST_HW_BKG_W);
+        for (UINT8 col = 0; col < w; ++col) {
+            UINT16 i = (UINT16)(base + ((x + col) & (HOST_HW_BKG_W - 1u)));
+            g_host_hw_bkg_tiles[i] = tiles[row * w + col];
+            g_host_hw_bkg_attrs[i] = attrs[row * w + col];
+        }
+    }
+    g_host_hw_stats.vram_bytes += (UINT32)w * h * 2u;
+}
+
+void host_hw_set_scroll(UINT8 scx, UINT8 scy) {
+    g_host_hw_scx = scx;
+    g_host_hw_scy = scy;
+}
+
+void host_hw_move_sprite(UINT8 nb, UINT8 x, UINT8 y, UINT8 tile, UINT8 prop) {
+    if (nb >= HOST_HW_OAM_SPRITES) {
+        return;
+    }
+    UINT8* e = &g_host_hw_shadow_oam[nb * 4u];
+    e[0] = y;
+    e[1] = x;
+    e[2] = tile;
+    e[3] = prop;
+    g_host_hw_stats.oam_bytes += 4u;
+}
+
+UINT8 host_hw_move_metasprite(const metasprite_t* metasprite, UINT8 base_tile, UINT8 base_prop, UINT8 base_sprite, UINT8 x, UINT8 y) {
+    UINT8 n = 0;
+    while (metasprite->dy != (INT8)metasprite_end) {
+        y = (UINT8)(y + metasprite->dy);
+        x = (UINT8)(x + metasprite->dx);
+        host_hw_move_sprite((UINT8)(base_sprite + n), x, y, (UINT8)(base_tile + metasprite->dtile), (UINT8)(base_prop | metasprite->props));
+        ++n;
+        ++metasprite;
+    }
+    return n;
+}
+
+void host_hw_hide_sprites(UINT8 from, UINT8 to) {
+    for (UINT8 nb = from; nb < to && nb < HOST_HW_OAM_SPRITES; ++nb) {
+        g_host_hw_shadow_oam[nb * 4u] = 0;
+        g_host_hw_stats.oam_bytes += 1u;
+    }
+}
+
+void host_hw_oam_dma(void) {
+    memcpy(g_host_hw_oam, g_host_hw_shadow_oam, sizeof(g_host_hw_oam));
+}
+
+static UINT32 host_hw_fnv(UINT32 hash, const UINT8* p, UINT32 n) {
+    for (UINT32 i = 0; i < n; ++i) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+UINT32 host_hw_hash(UINT32 hash) {
+    hash = host_hw_fnv(hash, g_host_hw_bkg_tiles, sizeof(g_host_hw_bkg_tiles));
+    hash = host_hw_fnv(hash, g_host_hw_bkg_attrs, sizeof(g_host_hw_bkg_attrs));
+    hash = host_hw_fnv(hash, g_host_hw_oam, sizeof(g_host_hw_oam));
+    hash = host_hw_fnv(hash, &g_host_hw_scx, 1u);
+    return host_hw_fnv(hash, &g_host_hw_scy, 1u);
+}
+
+#endif
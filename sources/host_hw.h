@@ -0,0 +1,45 @@
+#pragma once
+
+#ifndef __SDCC
+
+#include "game_types.h"
+#include "oam.h"
+
+#define HOST_HW_BKG_W 32u
+#define HOST_HW_BKG_H 32u
+#define HOST_HW_OAM_SPRITES 40u
+#define HOST_HW_OAM_BYTES (HOST_HW_OAM_SPRITES * 4u)
+
+typedef struct HostHwStats {
+    UINT32 seeks;
+    UINT32 strips;
+    UINT32 vram_bytes;
+    UINT32 oam_bytes;
+    UINT32 collision_queries;
+} HostHwStats;
+
+extern UINT8 g_host_hw_bkg_tiles[HOST_HW_BKG_W * HOST_HW_BKG_H];
+extern UINT8 g_host_hw_bkg_attrs[HOST_HW_BKG_W * HOST_HW_BKG_H];
+extern UINT8 g_host_hw_shadow_oam[HOST_HW_OAM_BYTES];
+extern UINT8 g_host_hw_oam[HOST_HW_OAM_BYTES];
+extern UINT8 g_host_hw_scx;
+extern UINT8 g_host_hw_scy;
+extern HostHwStats g_host_hw_stats;
+
+void host_hw_reset(void);
+
+void host_hw_set_bkg_tiles(UINT8 x, UINT8 y, UINT8 w, UINT8 h, const UINT8* tiles, const UINT8* attrs);
+
+void host_hw_set_scroll(UINT8 scx, UINT8 scy);
+
+void host_hw_move_sprite(UINT8 nb, UINT8 x, UINT8 y, UINT8 tile, UINT8 prop);
+
+UINT8 host_hw_move_metasprite(const metasprite_t* metasprite, UINT8 base_tile, UINT8 base_prop, UINT8 base_sprite, UINT8 x, UINT8 y);
+
+void host_hw_hide_sprites(UINT8 from, UINT8 to);
+
+void host_hw_oam_dma(void);
+
+UINT32 host_hw_hash(UINT32 hash);
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef __SDCC
+
+#include "host_perf.h"
+
+#include <string.h>
+
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+typedef struct HostPerfConfig {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+} HostPerfConfig;
+
+#define HOST_PERF_CACHE(cache, op, result) \
+    ((uint64_t)(cache) | ((uint64_t)(op) << 8) | ((uint64_t)(result) << 16))
+
+static const HostPerfConfig HOST_PERF_CONFIG[HOST_PERF_COUNT] = {
+    { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { "branches", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+    { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { "L1d-loads", PERF_TYPE_HW_CACHE,
+        HOST_PERF_CACHE(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS) },
+    { "L1d-misses", PERF_TYPE_HW_CACHE,
+        HOST_PERF_CACHE(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+};
+
+static int g_host_perf_fd[HOST_PERF_COUNT] = { -1, -1, -1, -1, -1 };
+
+static int host_perf_event_open(const HostPerfConfig* cfg) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = cfg->type;
+    attr.config = cfg->config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+uint8_t host_perf_open(void) {
+    uint8_t opened = 0;
+    for (uint8_t i = 0; i < HOST_PERF_COUNT; ++i) {
+        if (g_host_perf_fd[i] < 0) {
+            g_host_perf_fd[i] = host_perf_event_open(&HOST_PERF_CONFIG[i]);
+        }
+        if (g_host_perf_fd[i] >= 0) {
+            opened++;
+        }
+    }
+    return opened;
+}
+
+void host_perf_close(void) {
+    for (uint8_t i = 0; i < HOST_PERF_COUNT; ++i) {
+        if (g_host_perf_fd[i] >= 0) {
+            close(g_host_perf_fd[i]);
+            g_host_perf_fd[i] = -1;
+        }
+    }
+}
+
+uint8_t host_perf_available(HostPerfEvent event) {
+    return (event < HOST_PERF_COUNT && g_host_perf_fd[event] >= 0) ? 1u : 0u;
+}
+
+const char* host_perf_name(HostPerfEvent event) {
+    return (event < HOST_PERF_COUNT) ? HOST_PERF_CONFIG[event].name : "?";
+}
+
+void host_perf_start(void) {
+    for (uint8_t i = 0; i < HOST_PERF_COUNT; ++i) {
+        if (g_host_perf_fd[i] >= 0) {
+            ioctl(g_host_perf_fd[i], PERF_EVENT_IOC_RESET, 0);
+        }
+    }
+    for (uint8_t i = 0; i < HOST_PERF_COUNT; ++i) {
+        if (g_host_perf_fd[i] >= 0) {
+            ioctl(g_host_perf_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void host_perf_stop(HostPerfSample* out) {
+    for (uint8_t i = 0; i < HOST_PERF_COUNT; ++i) {
+        if (g_host_perf_fd[i] >= 0) {
+            ioctl(g_host_perf_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    memset(out, 0, sizeof(*out));
+    for (uint8_t i = 0; i < HOST_PERF_COUNT; ++i) {
+        uint64_t buf[3];
+        if (g_host_perf_fd[i] < 0 || read(g_host_perf_fd[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf)) {
+            continue;
+        }
+        if (buf[2] == 0u) {
+            continue;
+        }
+        out->value[i] = (buf[2] < buf[1]) ? (uint64_t)((double)buf[0] * (double)buf[1] / (double)buf[2]) : buf[0];
+        out->valid[i] = 1u;
+    }
+}
+
+#else
+
+uint8_t host_perf_open(void) { return 0u; }
+void host_perf_close(void) { }
+uint8_t host_perf_available(HostPerfEvent event) { (void)event; return 0u; }
+const char* host_perf_name(HostPerfEvent event) { (void)event; return "?"; }
+void host_perf_start(void) { }
+void host_perf_stop(HostPerfSample* out) { memset(out, 0, sizeof(*out)); }
+
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+#ifndef __SDCC
+
+#include <stdint.h>
+
+typedef enum HostPerfEvent {
+    HOST_PERF_INSTRUCTIONS = 0,
+    HOST_PERF_BRANCHES,
+    HOST_PERF_BRANCH_MISSES,
+    HOST_PERF_L1D_LOADS,
+    HOST_PERF_L1D_MISSES,
+    HOST_PERF_COUNT
+} HostPerfEvent;
+
+typedef struct HostPerfSample {
+    uint64_t value[HOST_PERF_COUNT];
+    uint8_t valid[HOST_PERF_COUNT];
+} HostPerfSample;
+
+uint8_t host_perf_open(void);
+
+void host_perf_close(void);
+
+uint8_t host_perf_available(HostPerfEvent event);
+
+const char* host_perf_name(HostPerfEvent event);
+
+void host_perf_start(void);
+
+void host_perf_stop(HostPerfSample* out);
+
+#endif
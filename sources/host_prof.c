@@ -0,0 +1,308 @@
+#ifndef __SDCC
+
+#include "host_prof.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(HOST_PROF_CLOCK_MONOTONIC)
+#include <x86intrin.h>
+#define HOST_PROF_RDTSC 1
+#endif
+
+#define HOST_PROF_CALIBRATE_RUNS 4096u
+#define HOST_PROF_CALIBRATE_NS 20000000ull
+
+typedef struct HostProfFrame {
+    HostProfZone* zone;
+    uint64_t start;
+    uint64_t overhead;
+    uint64_t child;
+} HostProfFrame;
+
+typedef struct HostProfEvent {
+    const HostProfZone* zone;
+    uint64_t start;
+    uint64_t ticks;
+} HostProfEvent;
+
+uint64_t g_host_prof_clock_ticks;
+uint64_t g_host_prof_inner_ticks;
+uint64_t g_host_prof_pair_ticks;
+
+static double g_host_prof_ns_per_tick = 1.0;
+static uint8_t g_host_prof_ready;
+
+static HostProfFrame g_host_prof_stack[HOST_PROF_STACK_MAX];
+static uint8_t g_host_prof_sp;
+static HostProfZone* g_host_prof_zones;
+
+static HostProfEvent* g_host_prof_events;
+static size_t g_host_prof_event_count;
+static size_t g_host_prof_event_max;
+static uint64_t g_host_prof_trace_origin;
+
+static uint64_t host_prof_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t host_prof_now(void) {
+#ifdef HOST_PROF_RDTSC
+    _mm_lfence();
+    uint64_t t = (uint64_t)__rdtsc();
+    _mm_lfence();
+    return t;
+#else
+    return host_prof_monotonic_ns();
+#endif
+}
+
+uint64_t host_prof_ticks_to_ns(uint64_t ticks) {
+    return (uint64_t)((double)ticks * g_host_prof_ns_per_tick + 0.5);
+}
+
+uint64_t host_prof_now_ns(void) {
+    host_prof_init();
+    return host_prof_ticks_to_ns(host_prof_now());
+}
+
+static int host_prof_cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t host_prof_median(uint64_t* samples, size_t n) {
+    qsort(samples, n, sizeof(samples[0]), host_prof_cmp_u64);
+    return samples[n / 2u];
+}
+
+void host_prof_init(void) {
+    if (g_host_prof_ready) {
+        return;
+    }
+    g_host_prof_ready = 1u;
+
+#ifdef HOST_PROF_RDTSC
+    {
+        uint64_t ns0 = host_prof_monotonic_ns();
+        uint64_t t0 = host_prof_now();
+        uint64_t ns1;
+        do {
+            ns1 = host_prof_monotonic_ns();
+        } while (ns1 - ns0 < HOST_PROF_CALIBRATE_NS);
+        uint64_t t1 = host_prof_now();
+        g_host_prof_ns_per_tick = (double)(ns1 - ns0) / (double)(t1 - t0);
+    }
+#endif
+
+    static uint64_t samples[HOST_PROF_CALIBRATE_RUNS];
+    HostProfZone* zones = g_host_prof_zones;
+    HostProfZone probe = HOST_PROF_ZONE_INIT("host_prof_probe");
+    HostProfZone nested = HOST_PROF_ZONE_INIT("host_prof_nested");
+
+    for (uint32_t i = 0; i < HOST_PROF_CALIBRATE_RUNS; ++i) {
+        uint64_t a = host_prof_now();
+        uint64_t b = host_prof_now();
+        samples[i] = b - a;
+    }
+    g_host_prof_clock_ticks = host_prof_median(samples, HOST_PROF_CALIBRATE_RUNS);
+
+    g_host_prof_inner_ticks = 0;
+    g_host_prof_pair_ticks = 0;
+    for (uint32_t i = 0; i < HOST_PROF_CALIBRATE_RUNS; ++i) {
+        uint64_t before = probe.total_ticks;
+        host_prof_enter(&probe);
+        host_prof_exit(&probe);
+        samples[i] = probe.total_ticks - before;
+    }
+    g_host_prof_inner_ticks = host_prof_median(samples, HOST_PROF_CALIBRATE_RUNS);
+
+    for (uint32_t i = 0; i < HOST_PROF_CALIBRATE_RUNS; ++i) {
+        uint64_t before = probe.total_ticks;
+        host_prof_enter(&probe);
+        host_prof_enter(&nested);
+        host_prof_exit(&nested);
+        host_prof_exit(&probe);
+        samples[i] = probe.total_ticks - before;
+    }
+    g_host_prof_pair_ticks = host_prof_median(samples, HOST_PROF_CALIBRATE_RUNS);
+
+    g_host_prof_sp = 0;
+    g_host_prof_zones = zones;
+}
+
+void host_prof_enter(HostProfZone* zone) {
+    if (!g_host_prof_ready) {
+        host_prof_init();
+    }
+    if (g_host_prof_sp >= HOST_PROF_STACK_MAX) {
+        return;
+    }
+    if (!zone->registered) {
+        zone->registered = 1u;
+        zone->next = g_host_prof_zones;
+        g_host_prof_zones = zone;
+    }
+
+    HostProfFrame* f = &g_host_prof_stack[g_host_prof_sp++];
+    f->zone = zone;
+    f->overhead = 0;
+    f->child = 0;
+    f->start = host_prof_now();
+}
+
+static uint8_t host_prof_bucket(uint64_t ns) {
+    uint8_t b = 0;
+    while (ns && b < HOST_PROF_HIST_BUCKETS - 1u) {
+        ns >>= 1;
+        ++b;
+    }
+    return b;
+}
+
+void host_prof_exit(HostProfZone* zone) {
+    uint64_t end = host_prof_now();
+    if (g_host_prof_sp == 0u) {
+        return;
+    }
+
+    HostProfFrame* f = &g_host_prof_stack[--g_host_prof_sp];
+    uint64_t raw = end - f->start;
+    uint64_t cost = g_host_prof_inner_ticks + f->overhead;
+    uint64_t ticks = (raw > cost) ? raw - cost : 0;
+    uint64_t excl = (ticks > f->child) ? ticks - f->child : 0;
+
+    HostProfZone* z = f->zone;
+    z->calls++;
+    z->total_ticks += ticks;
+    z->excl_ticks += excl;
+    z->hist[host_prof_bucket(host_prof_ticks_to_ns(ticks))]++;
+
+    if (g_host_prof_sp != 0u) {
+        HostProfFrame* parent = &g_host_prof_stack[g_host_prof_sp - 1u];
+        parent->overhead += f->overhead + g_host_prof_pair_ticks;
+        parent->child += ticks;
+    }
+
+    if (g_host_prof_event_count < g_host_prof_event_max) {
+        HostProfEvent* e = &g_host_prof_events[g_host_prof_event_count++];
+        e->zone = z;
+        e->start = f->start;
+        e->ticks = ticks;
+    }
+
+    (void)zone;
+}
+
+void host_prof_zone_reset(HostProfZone* zone) {
+    zone->calls = 0;
+    zone->total_ticks = 0;
+    zone->excl_ticks = 0;
+    memset(zone->hist, 0, sizeof(zone->hist));
+}
+
+void host_prof_zones_reset(HostProfZone* zones, uint8_t count) {
+    for (uint8_t i = 0; i < count; ++i) {
+        host_prof_zone_reset(&zones[i]);
+    }
+}
+
+void host_prof_reset(void) {
+    for (HostProfZone* z = g_host_prof_zones; z; z = z->next) {
+        host_prof_zone_reset(z);
+    }
+    g_host_prof_sp = 0;
+    g_host_prof_event_count = 0;
+}
+
+uint64_t host_prof_total_ns(const HostProfZone* zone) {
+    return host_prof_ticks_to_ns(zone->total_ticks);
+}
+
+uint64_t host_prof_excl_ns(const HostProfZone* zone) {
+    return host_prof_ticks_to_ns(zone->excl_ticks);
+}
+
+uint64_t host_prof_percentile_ns(const HostProfZone* zone, uint8_t percent) {
+    uint64_t target = ((uint64_t)zone->calls * percent + 99u) / 100u;
+    uint64_t seen = 0;
+    for (uint8_t b = 0; b < HOST_PROF_HIST_BUCKETS; ++b) {
+        seen += zone->hist[b];
+        if (seen >= target && seen != 0) {
+            return (b == 0) ? 0 : (1ull << b) - 1u;
+        }
+    }
+    return 0;
+}
+
+void host_prof_report(FILE* out) {
+    fprintf(out, "host_prof: clock %.3f ns/tick, read %llu ticks, zone overhead inner %llu / pair %llu ticks\n",
+        g_host_prof_ns_per_tick, (unsigned long long)g_host_prof_clock_ticks,
+        (unsigned long long)g_host_prof_inner_ticks, (unsigned long long)g_host_prof_pair_ticks);
+    fprintf(out, "%-28s %10s %12s %12s %9s %9s %9s\n", "zone", "calls", "total_ns", "excl_ns", "mean_ns", "p50<=ns", "p99<=ns");
+
+    for (HostProfZone* z = g_host_prof_zones; z; z = z->next) {
+        if (z->calls == 0u) {
+            continue;
+        }
+        uint64_t total = host_prof_total_ns(z);
+        fprintf(out, "%-28s %10u %12llu %12llu %9llu %9llu %9llu\n", z->name, z->calls,
+            (unsigned long long)total, (unsigned long long)host_prof_excl_ns(z),
+            (unsigned long long)(total / z->calls),
+            (unsigned long long)host_prof_percentile_ns(z, 50u),
+            (unsigned long long)host_prof_percentile_ns(z, 99u));
+
+        fprintf(out, "%-28s", "");
+        for (uint8_t b = 0; b < HOST_PROF_HIST_BUCKETS; ++b) {
+            if (z->hist[b]) {
+                fprintf(out, " <2^%u:%u", b, z->hist[b]);
+            }
+        }
+        fprintf(out, "\n");
+    }
+}
+
+int host_prof_trace_start(size_t max_events) {
+    host_prof_init();
+    free(g_host_prof_events);
+    g_host_prof_events = (HostProfEvent*)calloc(max_events, sizeof(HostProfEvent));
+    g_host_prof_event_max = g_host_prof_events ? max_events : 0;
+    g_host_prof_event_count = 0;
+    g_host_prof_trace_origin = host_prof_now();
+    return g_host_prof_events != 0;
+}
+
+int host_prof_trace_write(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return 0;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < g_host_prof_event_count; ++i) {
+        const HostProfEvent* e = &g_host_prof_events[i];
+        uint64_t ts = host_prof_ticks_to_ns(e->start - g_host_prof_trace_origin);
+        uint64_t dur = host_prof_ticks_to_ns(e->ticks);
+        fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%llu.%03llu,\"dur\":%llu.%03llu}%s\n",
+            e->zone->name,
+            (unsigned long long)(ts / 1000u), (unsigned long long)(ts % 1000u),
+            (unsigned long long)(dur / 1000u), (unsigned long long)(dur % 1000u),
+            (i + 1 < g_host_prof_event_count) ? "," : "");
+    }
+    fprintf(f, "]}\n");
+
+    int ok = !ferror(f);
+    fclose(f);
+
+    free(g_host_prof_events);
+    g_host_prof_events = 0;
+    g_host_prof_event_max = 0;
+    g_host_prof_event_count = 0;
+    return ok;
+}
+
+#endif
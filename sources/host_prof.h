@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef __SDCC
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define HOST_PROF_HIST_BUCKETS 40u
+
+#ifndef HOST_PROF_STACK_MAX
+#define HOST_PROF_STACK_MAX 32u
+#endif
+
+typedef struct HostProfZone {
+    const char* name;
+    uint32_t calls;
+    uint64_t total_ticks;
+    uint64_t excl_ticks;
+    uint32_t hist[HOST_PROF_HIST_BUCKETS];
+    struct HostProfZone* next;
+    uint8_t registered;
+} HostProfZone;
+
+#define HOST_PROF_ZONE_INIT(zone_name) { (zone_name), 0u, 0ull, 0ull, { 0u }, 0, 0u }
+
+void host_prof_init(void);
+
+uint64_t host_prof_now(void);
+
+uint64_t host_prof_ticks_to_ns(uint64_t ticks);
+
+uint64_t host_prof_now_ns(void);
+
+void host_prof_enter(HostProfZone* zone);
+
+void host_prof_exit(HostProfZone* zone);
+
+void host_prof_zone_reset(HostProfZone* zone);
+
+void host_prof_zones_reset(HostProfZone* zones, uint8_t count);
+
+void host_prof_reset(void);
+
+uint64_t host_prof_total_ns(const HostProfZone* zone);
+
+uint64_t host_prof_excl_ns(const HostProfZone* zone);
+
+uint64_t host_prof_percentile_ns(const HostProfZone* zone, uint8_t percent);
+
+void host_prof_report(FILE* out);
+
+int host_prof_trace_start(size_t max_events);
+
+int host_prof_trace_write(const char* path);
+
+extern uint64_t g_host_prof_clock_ticks;
+extern uint64_t g_host_prof_inner_ticks;
+extern uint64_t g_host_prof_pair_ticks;
+
+#endif
+
+#if defined(HOST_PROF) && !defined(__SDCC)
+#define HOST_PROF_ZONE(var, zone_name) static HostProfZone var = HOST_PROF_ZONE_INIT(zone_name)
+#define HOST_PROF_BEGIN(var) host_prof_enter(&(var))
+#define HOST_PROF_END(var) host_prof_exit(&(var))
+#else
+#define HOST_PROF_ZONE(var, zone_name) typedef int var##_host_prof_unused
+#define HOST_PROF_BEGIN(var) ((void)0)
+#define HOST_PROF_END(var) ((void)0)
+#endif
@@ -0,0 +1,18 @@
+#ifndef __SDCC
+
+#include "host_rand.h"
+
+uint32_t host_rand_seed(uint32_t seed) {
+    return seed | 1u;
+}
+
+uint32_t host_rand_next(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+
+#ifndef __SDCC
+
+#include <stdint.h>
+
+uint32_t host_rand_seed(uint32_t seed);
+
+uint32_t host_rand_next(uint32_t* state);
+
+#endif
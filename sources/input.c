@@ -0,0 +1,69 @@
+#include "input.h"
+
+#include "flight_rec.h"
+
+UINT8 PREV_JOY;
+
+#ifndef __SDCC
+UINT8 g_input_host_joy;
+#endif
+
+void input_update(Player* player, Camera* camera) {
+#if defined(__SDCC)
+    UINT8 joy = joypad();
+#else
+    UINT8 joy = g_input_host_joy;
+#endif
+    FLIGHT_REC_INPUT(joy);
+
+    if ((joy & J_SELECT) && !(PREV_JOY & J_SELECT)) {
+        player->in_water = !player->in_water;
+    }
+
+    player->jumping = (joy & J_A) != 0;
+
+    BOOLEAN jump_pressed = (joy & J_A) && !(PREV_JOY & J_A);
+    if (jump_pressed) {
+        player_input_jump(player);
+    }
+
+    BOOLEAN sprint_held = (joy & J_B) && player->on_ground;
+
+    if (joy & J_LEFT) {
+        if (!player->facing_left) {
+            camera_input_left_right(camera, -CAMERA_LOOKAHEAD);
+        }
+        BOOLEAN just_pressed = !(PREV_JOY & J_LEFT);
+        player_input_left(player, just_pressed, sprint_held);
+    }
+    else if (joy & J_RIGHT) {
+        if (player->facing_left) {
+            camera_input_left_right(camera, CAMERA_LOOKAHEAD);
+        }
+        BOOLEAN just_pressed = !(PREV_JOY & J_RIGHT);
+        player_input_right(player, just_pressed, sprint_held);
+    }
+    else {
+        BOOLEAN just_released = (PREV_JOY & (J_LEFT | J_RIGHT));
+        player_input_none(player, just_released);
+    }
+
+    if (joy & J_UP) {
+        if (!(PREV_JOY & J_UP)) {
+            camera_input_up_down(camera, -CAMERA_LOOKAHEAD_Y);
+        }
+    }
+    else if (joy & J_DOWN) {
+        if (!(PREV_JOY & J_DOWN)) {
+            camera_input_up_down(camera, CAMERA_LOOKAHEAD_Y);
+        }
+    }
+    else {
+
+        if (PREV_JOY & (J_UP | J_DOWN)) {
+            camera_input_up_down(camera, 0);
+        }
+    }
+
+    PREV_JOY = joy;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "game_types.h"
+#include "player.h"
+#include "camera.h"
+
+#ifndef __SDCC
+
+#define J_RIGHT  0x01u
+#define J_LEFT   0x02u
+#define J_UP     0x04u
+#define J_DOWN   0x08u
+#define J_A      0x10u
+#define J_B      0x20u
+#define J_SELECT 0x40u
+#define J_START  0x80u
+
+extern UINT8 g_input_host_joy;
+#endif
+
+extern UINT8 PREV_JOY;
+
+void input_update(Player* player, Camera* camera);
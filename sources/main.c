@@ -4,82 +4,38 @@
 #ifdef VBLANK_BENCH
 #include "vblank_bench.h"
 
-static uint8_t div_delta_u8(uint8_t start, uint8_t end) {
-    return (uint8_t)(end - start);
-}
-
 volatile uint8_t g_vblank_wait_div_last;
 #endif
 
 #include "player.h"
+#include "actor.h"
+#include "broadphase.h"
 #include "camera.h"
 #include "map.h"
+#include "map_objects.h"
 #include "music.h"
-
-UINT8 PREV_JOY;
-
-void input_update(Player* player, Camera* camera) {
-    UINT8 joy = joypad();
-
-    if ((joy & J_SELECT) && !(PREV_JOY & J_SELECT)) {
-        player->in_water = !player->in_water;
-    }
-
-    player->jumping = (joy & J_A) != 0;
-
-    BOOLEAN jump_pressed = (joy & J_A) && !(PREV_JOY & J_A);
-    if (jump_pressed) {
-        player_input_jump(player);
-    }
-
-    BOOLEAN sprint_held = (joy & J_B) && player->on_ground;
-
-    if (joy & J_LEFT) {
-        if (!player->facing_left) {
-            camera_input_left_right(camera, -CAMERA_LOOKAHEAD);
-        }
-        BOOLEAN just_pressed = !(PREV_JOY & J_LEFT);
-        player_input_left(player, just_pressed, sprint_held);
-    }
-    else if (joy & J_RIGHT) {
-        if (player->facing_left) {
-            camera_input_left_right(camera, CAMERA_LOOKAHEAD);
-        }
-        BOOLEAN just_pressed = !(PREV_JOY & J_RIGHT);
-        player_input_right(player, just_pressed, sprint_held);
-    }
-    else {
-        BOOLEAN just_released = (PREV_JOY & (J_LEFT | J_RIGHT));
-        player_input_none(player, just_released);
-    }
-
-    if (joy & J_UP) {
-        if (!(PREV_JOY & J_UP)) {
-            camera_input_up_down(camera, -CAMERA_LOOKAHEAD_Y);
-        }
-    }
-    else if (joy & J_DOWN) {
-        if (!(PREV_JOY & J_DOWN)) {
-            camera_input_up_down(camera, CAMERA_LOOKAHEAD_Y);
-        }
-    }
-    else {
-
-        if (PREV_JOY & (J_UP | J_DOWN)) {
-            camera_input_up_down(camera, 0);
-        }
-    }
-
-    PREV_JOY = joy;
-}
+#include "sfx.h"
+#include "bank_scope.h"
+#include "oam.h"
+#include "frame.h"
+#include "phase_prof.h"
+#include "flight_rec.h"
+#include "speed_gov.h"
+#include "input.h"
+#include "game_step.h"
+
+#ifdef TILEMAP_MACRO_VERIFY
+#include <gbdk/emu_debug.h>
+#endif
 
 void main() {
     DISPLAY_OFF;
 
     SPRITES_8x8;
 
-    cpu_slow();
+    speed_gov_init();
 
+    sfx_init();
     music_init();
 
     Player player;
@@ -88,9 +44,20 @@ void main() {
     Camera camera;
     camera_init(&camera, &player);
 
+#ifdef ACTORS
+    actor_system_init();
+    broadphase_init();
+#endif
+
+    frame_init();
+
     Map map;
     map_init(&map);
 
+#ifdef TILEMAP_MACRO_VERIFY
+    EMU_printf("tilemap_macro_verify: %u mismatches", tilemap_macro_verify());
+#endif
+
     {
         INT16 cam_world_x = (player.x + PLAYER_HALF_WIDTH) + camera.rel_x_from_player;
         INT16 cam_world_y = player.y + camera.rel_y_from_player;
@@ -98,6 +65,10 @@ void main() {
     }
     map_apply_scroll(&map);
     map_draw_full_screen(&map);
+    map_objects_activate_window(map.tile_x, map.tile_y);
+
+    oam_init();
+    frame_start();
 
     SHOW_BKG;
     SHOW_SPRITES;
@@ -106,34 +77,46 @@ void main() {
 #ifdef VBLANK_BENCH
     g_vblank_wait_div_last = 0u;
     UINT8 div_stride = 0;
+    BANK_NOTE_BANKED_CALL(BANK_ASSET_BENCH);
     vblank_bench_init();
 #endif
 
-    while (1) {
-
-        input_update(&player, &camera);
+#ifdef MUSIC_TICK_PROFILE
+    UINT8 music_profile_stride = 0;
+#endif
 
-        player_update(&player);
+#ifdef PHASE_PROFILE
+    phase_prof_init();
+#endif
 
-        camera_update(&camera, &player, &map);
+#ifdef FLIGHT_RECORDER
+    flight_rec_init();
+#endif
 
-        player_draw(&player, CAMERA_TO_SCREEN_X(camera), CAMERA_TO_SCREEN_Y(camera));
+    while (1) {
+        PHASE_PROF_FRAME();
+        FLIGHT_REC_FRAME(&player, &camera, &map, PREV_JOY);
 
 #ifdef VBLANK_BENCH
+        UINT8 slack = game_step(&player, &camera, &map);
         if (div_stride++ >= 30) {
             div_stride = 0;
-            DIV_REG = 0;
-            uint8_t t0 = DIV_REG;
-            wait_vbl_done();
-            g_vblank_wait_div_last = div_delta_u8(t0, DIV_REG);
+            g_vblank_wait_div_last = slack;
 
+            BANK_NOTE_BANKED_CALL(BANK_ASSET_BENCH);
             vblank_bench_print_right4(g_vblank_wait_div_last);
         }
-        else {
-            wait_vbl_done();
-        }
 #else
-        wait_vbl_done();
+        game_step(&player, &camera, &map);
 #endif
+
+#ifdef MUSIC_TICK_PROFILE
+        if (++music_profile_stride >= 60) {
+            music_profile_stride = 0;
+            music_tick_profile_report();
+        }
+#endif
+
+        bank_switch_stats_frame_end();
     }
 }
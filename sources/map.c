@@ -1,4 +1,7 @@
 #include "map.h"
+#include "map_objects.h"
+#include "bank_scope.h"
+#include "host_prof.h"
 
 #include <string.h>
 
@@ -6,33 +9,41 @@
 
 #include <gb/gbdecompress.h>
 
+#include "frame.h"
+
+#if ROW_WIDTH > FRAME_STRIP_MAX_TILES || COL_HEIGHT > FRAME_STRIP_MAX_TILES
+#error "FRAME_STRIP_MAX_TILES is smaller than a map strip"
+#endif
+#else
+
+#include "host_hw.h"
+#endif
+
 UINT8 col_tiles[COL_HEIGHT];
 UINT8 row_tiles[ROW_WIDTH];
 UINT8 col_attrs[COL_HEIGHT];
 UINT8 row_attrs[ROW_WIDTH];
-#endif
 
-#ifndef __SDCC
+#if !defined(__SDCC) && !defined(HOST_MAP_DATA)
 
-#define HOST_COLLISION_W 256u
-#define HOST_COLLISION_H 256u
-static UINT8 g_host_block_types[HOST_COLLISION_W * HOST_COLLISION_H];
+static UINT8 g_host_block_types[MAP_TILES_W * MAP_TILES_H];
 
 static UINT8 host_get_block_type(UINT16 map_tile_x, UINT16 map_tile_y) {
-    if (map_tile_x >= HOST_COLLISION_W || map_tile_y >= HOST_COLLISION_H) {
+    if (map_tile_x >= MAP_TILES_W || map_tile_y >= MAP_TILES_H) {
         return MAP_BLOCKTYPE_AIR;
     }
-    return g_host_block_types[(UINT16)(map_tile_y * HOST_COLLISION_W + map_tile_x)];
+    return g_host_block_types[(UINT16)(map_tile_y * MAP_TILES_W + map_tile_x)];
 }
 
 static void host_set_block_type(UINT16 map_tile_x, UINT16 map_tile_y, UINT8 block_type) {
-    if (map_tile_x >= HOST_COLLISION_W || map_tile_y >= HOST_COLLISION_H) {
+    if (map_tile_x >= MAP_TILES_W || map_tile_y >= MAP_TILES_H) {
         return;
     }
-    g_host_block_types[(UINT16)(map_tile_y * HOST_COLLISION_W + map_tile_x)] = block_type;
+    g_host_block_types[(UINT16)(map_tile_y * MAP_TILES_W + map_tile_x)] = block_type;
 }
 
 BOOLEAN map_is_solid_at(UINT16 map_tile_x, UINT16 map_tile_y) {
+    g_host_hw_stats.collision_queries++;
     return host_get_block_type(map_tile_x, map_tile_y) == MAP_BLOCKTYPE_SOLID;
 }
 
@@ -41,8 +52,39 @@ void map_test_set_block_type_at(const Map* map, UINT16 map_tile_x, UINT16 map_ti
     host_set_block_type(map_tile_x, map_tile_y, block_type);
 }
 
-void map_draw_full_screen(Map* map) {
-    (void)map;
+void map_test_load(const UINT8* block_types, UINT16 width, UINT16 height) {
+    memset(g_host_block_types, 0, sizeof(g_host_block_types));
+    for (UINT16 y = 0; y < height && y < MAP_TILES_H; ++y) {
+        for (UINT16 x = 0; x < width && x < MAP_TILES_W; ++x) {
+            host_set_block_type(x, y, block_types[(UINT32)y * width + x]);
+        }
+    }
+}
+
+void update_column(Map* map, UINT8 rel_x, UINT16 map_tile_y_start) {
+    UINT8 vram_x = (map->vram_x_left + rel_x) & (VRAM_WIDTH_MINUS_1);
+    UINT16 map_tile_x = (UINT16)(map->tile_x + rel_x);
+
+    g_host_hw_stats.seeks++;
+    g_host_hw_stats.strips++;
+    for (UINT8 yy = 0; yy < COL_HEIGHT; ++yy) {
+        col_tiles[yy] = host_get_block_type(map_tile_x, (UINT16)(map_tile_y_start + yy));
+        col_attrs[yy] = 0;
+    }
+    host_hw_set_bkg_tiles(vram_x, map->vram_y_top, 1, COL_HEIGHT, col_tiles, col_attrs);
+}
+
+void update_row(Map* map, UINT8 rel_y, UINT16 map_tile_x_start) {
+    UINT8 vram_y = (map->vram_y_top + rel_y) & (VRAM_HEIGHT_MINUS_1);
+    UINT16 map_tile_y = (UINT16)(map->tile_y + rel_y);
+
+    g_host_hw_stats.seeks++;
+    g_host_hw_stats.strips++;
+    for (UINT8 xx = 0; xx < ROW_WIDTH; ++xx) {
+        row_tiles[xx] = host_get_block_type((UINT16)(map_tile_x_start + xx), map_tile_y);
+        row_attrs[xx] = 0;
+    }
+    host_hw_set_bkg_tiles(map->vram_x_left, vram_y, ROW_WIDTH, 1, row_tiles, row_attrs);
 }
 
 #else
@@ -51,20 +93,18 @@ static TilemapCursor g_tile_cursor_query;
 
 static UINT8 map_get_block_type_at_tile(UINT16 map_tile_x, UINT16 map_tile_y) {
 
-#ifdef __SDCC
-    UINT8 old_bank = _current_bank;
-    SWITCH_ROM(TILEMAP_MAP_BANK);
-#endif
+    BANK_SCOPE_ENTER(BANK_ASSET_TILEMAP, TILEMAP_MAP_BANK);
     uint16_t dict_idx = tilemap_stream_seek_xy(&g_tile_cursor_query, (uint8_t)map_tile_x, (uint8_t)map_tile_y);
     uint8_t tile_id = MACROTILES_IDS[dict_idx];
     uint8_t block_type = TILEID_TO_TYPE[tile_id];
-#ifdef __SDCC
-    SWITCH_ROM(old_bank);
-#endif
+    BANK_SCOPE_EXIT();
     return block_type;
 }
 
 BOOLEAN map_is_solid_at(UINT16 map_tile_x, UINT16 map_tile_y) {
+#ifndef __SDCC
+    g_host_hw_stats.collision_queries++;
+#endif
     return map_get_block_type_at_tile(map_tile_x, map_tile_y) == MAP_BLOCKTYPE_SOLID;
 }
 
@@ -77,31 +117,44 @@ void update_column(Map* map, UINT8 rel_x, UINT16 map_tile_y_start) {
 
     UINT8 yy;
 
-    UINT8 old_bank = _current_bank;
+#if defined(__SDCC)
+    FrameStrip* strip = frame_strip_begin(vram_x, vram_y_start, 1, COL_HEIGHT);
+    UINT8* tiles = strip ? strip->tiles : col_tiles;
+    UINT8* attrs = strip ? strip->attrs : col_attrs;
+#else
+    UINT8* tiles = col_tiles;
+    UINT8* attrs = col_attrs;
+    g_host_hw_stats.seeks++;
+    g_host_hw_stats.strips++;
+#endif
 
-    SWITCH_ROM(TILEMAP_MAP_BANK);
+    BANK_SCOPE_ENTER(BANK_ASSET_TILEMAP, TILEMAP_MAP_BANK);
     uint16_t idx = tilemap_stream_seek_xy(&g_tile_cursor_col, (uint8_t)map->tile_x + rel_x, (uint8_t)map_tile_y_start);
 
-    col_tiles[0] = MACROTILES_IDS[idx];
-    col_attrs[0] = MACROTILES_ATTRS[idx];
+    tiles[0] = MACROTILES_IDS[idx];
+    attrs[0] = MACROTILES_ATTRS[idx];
 
-    {
-        TilemapCursor start_cursor;
-        memcpy(&start_cursor, &g_tile_cursor_col, sizeof(start_cursor));
-        for (yy = 1; yy < COL_HEIGHT; ++yy) {
-            idx = tilemap_macro_next_down(&g_tile_cursor_col);
-            col_tiles[yy] = MACROTILES_IDS[idx];
-            col_attrs[yy] = MACROTILES_ATTRS[idx];
-        }
-        memcpy(&g_tile_cursor_col, &start_cursor, sizeof(start_cursor));
+    for (yy = 1; yy < COL_HEIGHT; ++yy) {
+        idx = tilemap_macro_next_down(&g_tile_cursor_col);
+        tiles[yy] = MACROTILES_IDS[idx];
+        attrs[yy] = MACROTILES_ATTRS[idx];
+    }
+    BANK_SCOPE_EXIT();
+
+#if defined(__SDCC)
+    if (strip) {
+        frame_strip_end();
+        return;
     }
-    SWITCH_ROM(old_bank);
 
     VBK_REG = VBK_TILES;
     set_bkg_tiles(vram_x, vram_y_start, 1, COL_HEIGHT, col_tiles);
 
     VBK_REG = VBK_ATTRIBUTES;
     set_bkg_tiles(vram_x, vram_y_start, 1, COL_HEIGHT, col_attrs);
+#else
+    host_hw_set_bkg_tiles(vram_x, vram_y_start, 1, COL_HEIGHT, tiles, attrs);
+#endif
 }
 
 void update_row(
@@ -115,39 +168,54 @@ void update_row(
 
     UINT8 xx;
 
-    UINT8 old_bank = _current_bank;
+#if defined(__SDCC)
+    FrameStrip* strip = frame_strip_begin(vram_x_start, vram_y, ROW_WIDTH, 1);
+    UINT8* tiles = strip ? strip->tiles : row_tiles;
+    UINT8* attrs = strip ? strip->attrs : row_attrs;
+#else
+    UINT8* tiles = row_tiles;
+    UINT8* attrs = row_attrs;
+    g_host_hw_stats.seeks++;
+    g_host_hw_stats.strips++;
+#endif
 
-    SWITCH_ROM(TILEMAP_MAP_BANK);
+    BANK_SCOPE_ENTER(BANK_ASSET_TILEMAP, TILEMAP_MAP_BANK);
     uint16_t idx = tilemap_stream_seek_xy(&g_tile_cursor_row, (uint8_t)map_tile_x_start, (uint8_t)map->tile_y + rel_y);
 
-    row_tiles[0] = MACROTILES_IDS[idx];
-    row_attrs[0] = MACROTILES_ATTRS[idx];
+    tiles[0] = MACROTILES_IDS[idx];
+    attrs[0] = MACROTILES_ATTRS[idx];
 
-    {
-        TilemapCursor start_cursor;
-        memcpy(&start_cursor, &g_tile_cursor_row, sizeof(start_cursor));
-        for (xx = 1; xx < ROW_WIDTH; ++xx) {
-            idx = tilemap_macro_next_right(&g_tile_cursor_row);
-            row_tiles[xx] = MACROTILES_IDS[idx];
-            row_attrs[xx] = MACROTILES_ATTRS[idx];
-        }
-        memcpy(&g_tile_cursor_row, &start_cursor, sizeof(start_cursor));
+    for (xx = 1; xx < ROW_WIDTH; ++xx) {
+        idx = tilemap_macro_next_right(&g_tile_cursor_row);
+        tiles[xx] = MACROTILES_IDS[idx];
+        attrs[xx] = MACROTILES_ATTRS[idx];
+    }
+    BANK_SCOPE_EXIT();
+
+#if defined(__SDCC)
+    if (strip) {
+        frame_strip_end();
+        return;
     }
-    SWITCH_ROM(old_bank);
 
     VBK_REG = VBK_TILES;
     set_bkg_tiles(vram_x_start, vram_y, ROW_WIDTH, 1, row_tiles);
 
     VBK_REG = VBK_ATTRIBUTES;
     set_bkg_tiles(vram_x_start, vram_y, ROW_WIDTH, 1, row_attrs);
+#else
+    host_hw_set_bkg_tiles(vram_x_start, vram_y, ROW_WIDTH, 1, tiles, attrs);
+#endif
 }
+#endif
 
 void map_draw_full_screen(Map* map) {
+    BANK_SCOPE_ENTER(BANK_ASSET_TILEMAP, TILEMAP_MAP_BANK);
     for (UINT8 y = 0; y < COL_HEIGHT; ++y) {
         update_row(map, y, map->tile_x);
     }
+    BANK_SCOPE_EXIT();
 }
-#endif
 
 void map_init(Map* map) {
     map->scroll_x = 0;
@@ -159,16 +227,20 @@ void map_init(Map* map) {
     map->vram_x_left = 0;
     map->vram_y_top = 0;
 
-#if defined(__SDCC)
+    map_objects_init();
+
+#if defined(__SDCC) || defined(HOST_MAP_DATA)
 
     tilemap_cursor_init(&g_tile_cursor_row);
     tilemap_cursor_init(&g_tile_cursor_col);
     tilemap_cursor_init(&g_tile_cursor_query);
 
+#if defined(__SDCC)
     gb_decompress_bkg_data(0, tileset_comp);
     VBK_REG = VBK_TILES;
 
     set_bkg_palette(0, 8, tileset_palette);
+#endif
 #else
     memset(g_host_block_types, 0, sizeof(g_host_block_types));
 #endif
@@ -188,7 +260,10 @@ void map_set_scroll_immediate(Map* map, INT16 new_scroll_x, INT16 new_scroll_y)
     map->vram_y_top = (UINT8)(map->tile_y & VRAM_HEIGHT_MINUS_1);
 }
 
+HOST_PROF_ZONE(g_prof_map_set_scroll, "map_set_scroll");
+
 void map_set_scroll(Map* map, INT16 new_scroll_x, INT16 new_scroll_y) {
+    HOST_PROF_BEGIN(g_prof_map_set_scroll);
 
     INT16 delta_x = new_scroll_x - map->scroll_x;
     INT16 delta_y = new_scroll_y - map->scroll_y;
@@ -204,9 +279,9 @@ void map_set_scroll(Map* map, INT16 new_scroll_x, INT16 new_scroll_y) {
             map->tile_x++;
             map->vram_x_left = (map->vram_x_left + 1) & (VRAM_WIDTH_MINUS_1);
 
-#if defined(__SDCC)
             update_column(map, SCREEN_TILES_W, map->tile_y);
-#endif
+            map_objects_enter_column(map->tile_x + SCREEN_TILES_W, map->tile_y);
+            map_objects_leave_column(map->tile_x - (MAP_OBJECT_DESPAWN_MARGIN + 1));
         }
     } else if (delta_x < 0) {
 
@@ -216,9 +291,9 @@ void map_set_scroll(Map* map, INT16 new_scroll_x, INT16 new_scroll_y) {
             map->tile_x--;
             map->vram_x_left = (map->vram_x_left - 1) & (VRAM_WIDTH_MINUS_1);
 
-#if defined(__SDCC)
             update_column(map, 0, map->tile_y);
-#endif
+            map_objects_enter_column(map->tile_x, map->tile_y);
+            map_objects_leave_column(map->tile_x + (ROW_WIDTH + MAP_OBJECT_DESPAWN_MARGIN));
         }
     }
 
@@ -230,9 +305,9 @@ void map_set_scroll(Map* map, INT16 new_scroll_x, INT16 new_scroll_y) {
             map->tile_y++;
             map->vram_y_top = (map->vram_y_top + 1) & (VRAM_HEIGHT_MINUS_1);
 
-#if defined(__SDCC)
             update_row(map, SCREEN_TILES_H, map->tile_x);
-#endif
+            map_objects_enter_row(map->tile_y + SCREEN_TILES_H, map->tile_x);
+            map_objects_leave_row(map->tile_y - (MAP_OBJECT_DESPAWN_MARGIN + 1));
         }
     } else if (delta_y < 0) {
 
@@ -242,16 +317,21 @@ void map_set_scroll(Map* map, INT16 new_scroll_x, INT16 new_scroll_y) {
             map->tile_y--;
             map->vram_y_top = (map->vram_y_top - 1) & (VRAM_HEIGHT_MINUS_1);
 
-#if defined(__SDCC)
             update_row(map, 0, map->tile_x);
-#endif
+            map_objects_enter_row(map->tile_y, map->tile_x);
+            map_objects_leave_row(map->tile_y + (COL_HEIGHT + MAP_OBJECT_DESPAWN_MARGIN));
         }
     }
+
+    map_objects_release_outside(map->tile_x, map->tile_y);
+
+    HOST_PROF_END(g_prof_map_set_scroll);
 }
 
 void map_apply_scroll(const Map* map) {
-    (void)map;
 #if defined(__SDCC)
-    move_bkg((UINT8)map->scroll_x, (UINT8)map->scroll_y);
+    frame_set_scroll((UINT8)map->scroll_x, (UINT8)map->scroll_y);
+#else
+    host_hw_set_scroll((UINT8)map->scroll_x, (UINT8)map->scroll_y);
 #endif
 }
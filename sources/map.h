@@ -2,8 +2,10 @@
 
 #include "game_types.h"
 
+#if defined(__SDCC) || defined(HOST_MAP_DATA)
 #if defined(__SDCC)
 #include <gb/cgb.h>
+#endif
 
 #include "tileset_comp.h"
 
@@ -11,12 +13,21 @@
 #include "tilemap_macro.h"
 typedef TilemapMacroCursor TilemapCursor;
 #define TILEMAP_MAP_BANK TILEMAP_MACRO_DATA_BANK
+#define MAP_TILES_W (TILEMAP_MACRO_WIDTH * TILEMAP_MACRO_GROUP_SIDE)
+#define MAP_TILES_H (TILEMAP_MACRO_HEIGHT * TILEMAP_MACRO_GROUP_SIDE)
 #define tilemap_cursor_init(c) tilemap_macro_init((c))
 #define tilemap_stream_seek_xy(c, x, y) tilemap_macro_seek_xy((c), (x), (y))
 #define tilemap_stream_next_right(c) tilemap_macro_next_right((c))
 #define tilemap_stream_next_down(c) tilemap_macro_next_down((c))
 
+#if defined(__SDCC)
 #include "palette.h"
+#endif
+
+#else
+
+#define MAP_TILES_W 256u
+#define MAP_TILES_H 256u
 
 #endif
 
@@ -60,7 +71,9 @@ void map_apply_scroll(const Map* map);
 
 void map_draw_full_screen(Map* map);
 
-#ifndef __SDCC
+#if !defined(__SDCC) && !defined(HOST_MAP_DATA)
 
 void map_test_set_block_type_at(const Map* map, UINT16 map_tile_x, UINT16 map_tile_y, UINT8 block_type);
+
+void map_test_load(const UINT8* block_types, UINT16 width, UINT16 height);
 #endif
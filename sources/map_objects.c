@@ -0,0 +1,204 @@
+#ifdef ACTORS
+
+#include "map_objects.h"
+
+#include "actor.h"
+#include "map.h"
+
+#if defined(__SDCC) || defined(HOST_MAP_DATA)
+#include "map_objects_data.h"
+#else
+#include "map_objects_sample.h"
+#endif
+
+#if MAP_OBJECT_COLUMNS != MAP_TILES_W || MAP_OBJECT_ROWS != MAP_TILES_H
+#error "the map object layer does not match the map size; rebuild it with tools/build_map_objects.py"
+#endif
+
+#define MAP_OBJECT_WINDOW_W (SCREEN_TILES_W + HORIZONTAL_TILE_LOOKAHEAD)
+#define MAP_OBJECT_WINDOW_H (SCREEN_TILES_H + VERTICAL_TILE_LOOKAHEAD)
+
+#define MAP_OBJECT_KEEP_W (MAP_OBJECT_WINDOW_W + 2 * MAP_OBJECT_DESPAWN_MARGIN)
+#define MAP_OBJECT_KEEP_H (MAP_OBJECT_WINDOW_H + 2 * MAP_OBJECT_DESPAWN_MARGIN)
+
+static UINT8 g_map_object_spawned[(MAP_OBJECT_COUNT + 7) / 8 + 1];
+static ActorHandle g_map_object_actor[MAP_OBJECT_COUNT + 1];
+
+static UINT8 g_map_object_live_id[ACTOR_CAPACITY];
+static ActorHandle g_map_object_live_actor[ACTOR_CAPACITY];
+static UINT8 g_map_object_live_count;
+
+#define SPAWNED_BYTE(id) g_map_object_spawned[(id) >> 3]
+#define SPAWNED_BIT(id) ((UINT8)(1u << ((id) & 7u)))
+
+BOOLEAN map_object_is_spawned(UINT8 id) {
+    return (SPAWNED_BYTE(id) & SPAWNED_BIT(id)) != 0;
+}
+
+void map_objects_init(void) {
+    for (UINT8 i = 0; i < (UINT8)sizeof(g_map_object_spawned); ++i) {
+        g_map_object_spawned[i] = 0;
+    }
+    g_map_object_live_count = 0;
+}
+
+static void map_objects_drop_dead(void) {
+    UINT8 i = g_map_object_live_count;
+    while (i != 0) {
+        --i;
+        if (actor_resolve(g_map_object_live_actor[i]) == ACTOR_NONE) {
+            UINT8 last = --g_map_object_live_count;
+            g_map_object_live_id[i] = g_map_object_live_id[last];
+            g_map_object_live_actor[i] = g_map_object_live_actor[last];
+        }
+    }
+}
+
+static void map_object_spawn(UINT8 id) {
+    if (SPAWNED_BYTE(id) & SPAWNED_BIT(id)) {
+        return;
+    }
+
+    ActorHandle h = actor_spawn(MAP_OBJECT_KIND[id], (INT16)(MAP_OBJECT_TILE_X[id] << 3), (INT16)(MAP_OBJECT_TILE_Y[id] << 3));
+    if (h == ACTOR_HANDLE_NONE) {
+        return;
+    }
+    g_map_object_actor[id] = h;
+    SPAWNED_BYTE(id) |= SPAWNED_BIT(id);
+
+    if (g_map_object_live_count == ACTOR_CAPACITY) {
+        map_objects_drop_dead();
+    }
+    g_map_object_live_id[g_map_object_live_count] = id;
+    g_map_object_live_actor[g_map_object_live_count++] = h;
+}
+
+static void map_object_release(UINT8 id) {
+    if ((SPAWNED_BYTE(id) & SPAWNED_BIT(id)) && actor_resolve(g_map_object_actor[id]) == ACTOR_NONE) {
+        SPAWNED_BYTE(id) &= (UINT8)~SPAWNED_BIT(id);
+    }
+}
+
+void map_objects_release_outside(UINT16 tile_x, UINT16 tile_y) {
+    UINT16 keep_x = tile_x - MAP_OBJECT_DESPAWN_MARGIN;
+    UINT16 keep_y = tile_y - MAP_OBJECT_DESPAWN_MARGIN;
+
+    UINT8 i = g_map_object_live_count;
+    while (i != 0) {
+        --i;
+        UINT8 slot = actor_resolve(g_map_object_live_actor[i]);
+        if (slot != ACTOR_NONE) {
+            UINT16 ax = (UINT16)((UINT16)actor_x[slot] >> 3) - keep_x;
+            UINT16 ay = (UINT16)((UINT16)actor_y[slot] >> 3) - keep_y;
+            if (ax < MAP_OBJECT_KEEP_W && ay < MAP_OBJECT_KEEP_H) {
+                continue;
+            }
+            actor_despawn(slot);
+
+            UINT8 id = g_map_object_live_id[i];
+            SPAWNED_BYTE(id) &= (UINT8)~SPAWNED_BIT(id);
+        }
+
+        UINT8 last = --g_map_object_live_count;
+        g_map_object_live_id[i] = g_map_object_live_id[last];
+        g_map_object_live_actor[i] = g_map_object_live_actor[last];
+    }
+}
+
+void map_objects_enter_column(UINT16 col, UINT16 tile_y) {
+    if (col >= MAP_OBJECT_COLUMNS) {
+        return;
+    }
+
+    UINT8 end = MAP_OBJECT_COL_START[col + 1];
+    for (UINT8 id = MAP_OBJECT_COL_START[col]; id != end; ++id) {
+        if ((UINT16)(MAP_OBJECT_TILE_Y[id] - tile_y) < MAP_OBJECT_WINDOW_H) {
+            map_object_spawn(id);
+        }
+    }
+}
+
+void map_objects_enter_row(UINT16 row, UINT16 tile_x) {
+    if (row >= MAP_OBJECT_ROWS) {
+        return;
+    }
+
+    UINT8 end = MAP_OBJECT_ROW_START[row + 1];
+    for (UINT8 i = MAP_OBJECT_ROW_START[row]; i != end; ++i) {
+        UINT8 id = MAP_OBJECT_ROW_ORDER[i];
+        if ((UINT16)(MAP_OBJECT_TILE_X[id] - tile_x) < MAP_OBJECT_WINDOW_W) {
+            map_object_spawn(id);
+        }
+    }
+}
+
+void map_objects_leave_column(UINT16 col) {
+    if (col >= MAP_OBJECT_COLUMNS) {
+        return;
+    }
+
+    UINT8 end = MAP_OBJECT_COL_START[col + 1];
+    for (UINT8 id = MAP_OBJECT_COL_START[col]; id != end; ++id) {
+        map_object_release(id);
+    }
+}
+
+void map_objects_leave_row(UINT16 row) {
+    if (row >= MAP_OBJECT_ROWS) {
+        return;
+    }
+
+    UINT8 end = MAP_OBJECT_ROW_START[row + 1];
+    for (UINT8 i = MAP_OBJECT_ROW_START[row]; i != end; ++i) {
+        map_object_release(MAP_OBJECT_ROW_ORDER[i]);
+    }
+}
+
+void map_objects_activate_window(UINT16 tile_x, UINT16 tile_y) {
+    for (UINT8 x = 0; x < MAP_OBJECT_WINDOW_W; ++x) {
+        map_objects_enter_column(tile_x + x, tile_y);
+    }
+}
+
+#if defined(GAME_SNAPSHOT)
+void map_objects_save(UINT8* out) {
+    for (UINT8 i = 0; i < MAP_OBJECT_SPAWNED_BYTES_MAX; ++i) {
+        *out++ = (i < (UINT8)sizeof(g_map_object_spawned)) ? g_map_object_spawned[i] : 0u;
+    }
+    *out++ = g_map_object_live_count;
+    for (UINT8 i = 0; i < ACTOR_CAPACITY; ++i) {
+        ActorHandle h = (i < g_map_object_live_count) ? g_map_object_live_actor[i] : ACTOR_HANDLE_NONE;
+        *out++ = (i < g_map_object_live_count) ? g_map_object_live_id[i] : MAP_OBJECT_NONE;
+        *out++ = (UINT8)h;
+        *out++ = (UINT8)(h >> 8);
+    }
+}
+
+#ifndef __SDCC
+void map_objects_load(const UINT8* in) {
+    for (UINT8 i = 0; i < (UINT8)sizeof(g_map_object_spawned); ++i) {
+        g_map_object_spawned[i] = in[i];
+    }
+    in += MAP_OBJECT_SPAWNED_BYTES_MAX;
+    for (UINT16 id = 0; id <= MAP_OBJECT_COUNT; ++id) {
+        g_map_object_actor[id] = ACTOR_HANDLE_NONE;
+    }
+
+    UINT8 count = *in++;
+    g_map_object_live_count = 0;
+    for (UINT8 i = 0; i < count && i < ACTOR_CAPACITY; ++i) {
+        UINT8 id = in[0];
+        ActorHandle h = (ActorHandle)(in[1] | ((UINT16)in[2] << 8));
+        in += 3;
+        if (id >= MAP_OBJECT_COUNT) {
+            continue;
+        }
+        g_map_object_live_id[g_map_object_live_count] = id;
+        g_map_object_live_actor[g_map_object_live_count++] = h;
+        g_map_object_actor[id] = h;
+    }
+}
+#endif
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "game_types.h"
+#include "actor.h"
+
+#define MAP_OBJECT_NONE 0xFFu
+
+#define MAP_OBJECT_SPAWNED_BYTES_MAX 33u
+#define MAP_OBJECTS_SAVE_SIZE (MAP_OBJECT_SPAWNED_BYTES_MAX + 1u + ACTOR_CAPACITY * 3u)
+
+#ifndef MAP_OBJECT_DESPAWN_MARGIN
+#define MAP_OBJECT_DESPAWN_MARGIN 4
+#endif
+
+#ifdef ACTORS
+
+void map_objects_init(void);
+
+void map_objects_activate_window(UINT16 tile_x, UINT16 tile_y);
+
+void map_objects_enter_column(UINT16 col, UINT16 tile_y);
+
+void map_objects_enter_row(UINT16 row, UINT16 tile_x);
+
+void map_objects_leave_column(UINT16 col);
+
+void map_objects_leave_row(UINT16 row);
+
+void map_objects_release_outside(UINT16 tile_x, UINT16 tile_y);
+
+BOOLEAN map_object_is_spawned(UINT8 id);
+
+#ifdef GAME_SNAPSHOT
+void map_objects_save(UINT8* out);
+#endif
+
+#ifndef __SDCC
+void map_objects_load(const UINT8* in);
+#endif
+
+#else
+
+#define map_objects_init() ((void)0)
+#define map_objects_activate_window(tile_x, tile_y) ((void)0)
+#define map_objects_enter_column(col, tile_y) ((void)0)
+#define map_objects_enter_row(row, tile_x) ((void)0)
+#define map_objects_leave_column(col) ((void)0)
+#define map_objects_leave_row(row) ((void)0)
+#define map_objects_release_outside(tile_x, tile_y) ((void)0)
+
+#endif
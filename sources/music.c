@@ -1,23 +1,80 @@
 #include <gb/gb.h>
 #include <gbdk/platform.h>
 #include "music.h"
+#include "bank_scope.h"
 #include "hUGEDriver.h"
+#include "sfx.h"
+#include "phase_prof.h"
+#include "speed_gov.h"
 
+#ifdef MUSIC_TICK_PROFILE
+#include <gbdk/emu_debug.h>
+#endif
+
+#ifndef MUSIC_BANK
 #define MUSIC_BANK 3u
+#endif
 
 void music3_init(void);
 
-void vbl_music(void) NONBANKED {
-    UINT8 old_bank = _current_bank;
-    SWITCH_ROM(MUSIC_BANK);
+#ifdef MUSIC_TICK_PROFILE
+volatile UINT8 g_music_tick_div_last;
+volatile UINT8 g_music_tick_div_max;
+volatile UINT8 g_sfx_tick_div_max;
+#endif
+
+void music_tick_isr(void) NONBANKED {
+    PHASE_PROF_ISR_BEGIN();
+
+#ifdef MUSIC_TICK_PROFILE
+    UINT8 div_start = DIV_REG;
+#endif
+
+    BANK_SCOPE_ENTER(BANK_ASSET_MUSIC, MUSIC_BANK);
     hUGE_dosound();
-    SWITCH_ROM(old_bank);
+    BANK_SCOPE_EXIT();
+
+#ifdef MUSIC_TICK_PROFILE
+    UINT8 div_sfx = DIV_REG;
+    UINT8 div_delta = SPEED_DIV_NORMALIZE((UINT8)(div_sfx - div_start));
+    g_music_tick_div_last = div_delta;
+    if (div_delta > g_music_tick_div_max) {
+        g_music_tick_div_max = div_delta;
+    }
+#endif
+
+    sfx_tick();
+
+#ifdef MUSIC_TICK_PROFILE
+    div_delta = SPEED_DIV_NORMALIZE((UINT8)(DIV_REG - div_sfx));
+    if (div_delta > g_sfx_tick_div_max) {
+        g_sfx_tick_div_max = div_delta;
+    }
+#endif
+
+    PHASE_PROF_ISR_END(PHASE_PROF_MUSIC);
 }
 
 void music_init(void)
 {
-    UINT8 old_bank = _current_bank;
-    SWITCH_ROM(MUSIC_BANK);
+    BANK_SCOPE_ENTER(BANK_ASSET_MUSIC, MUSIC_BANK);
     music3_init();
-    SWITCH_ROM(old_bank);
+    BANK_SCOPE_EXIT();
+}
+
+void music_timer_set_speed(BOOLEAN fast) {
+#ifdef MUSIC_ON_VBL
+    (void)fast;
+#else
+    TMA_REG = fast ? MUSIC_TIMER_TMA_FAST : MUSIC_TIMER_TMA;
+#endif
+}
+
+#ifdef MUSIC_TICK_PROFILE
+void music_tick_profile_report(void) {
+    UINT8 max = g_music_tick_div_max;
+    UINT8 sfx_max = g_sfx_tick_div_max;
+    EMU_printf("MUSICPROF last=%u max=%u div, max<=%u M-cycles", g_music_tick_div_last, max, (UINT16)(max + 1u) * MUSIC_DIV_M_CYCLES);
+    EMU_printf("SFXPROF max=%u div, max<=%u M-cycles, worst tick %u writes", sfx_max, (UINT16)(sfx_max + 1u) * MUSIC_DIV_M_CYCLES, SFX_TICK_WORST_WRITES);
 }
+#endif
@@ -4,8 +4,36 @@
 #include <gb/gb.h>
 #include <gbdk/platform.h>
 
+#if defined(PHASE_PROFILE) && !defined(MUSIC_ON_VBL)
+#define MUSIC_ON_VBL
+#endif
+
+#ifndef MUSIC_TIMER_DIVIDER
+#define MUSIC_TIMER_DIVIDER 69u
+#endif
+
+#if MUSIC_TIMER_DIVIDER > 128
+#error "MUSIC_TIMER_DIVIDER must be doubled in CGB double speed and fit TMA"
+#endif
+
+#define MUSIC_TIMER_TMA ((UINT8)(256u - MUSIC_TIMER_DIVIDER))
+#define MUSIC_TIMER_TMA_FAST ((UINT8)(256u - 2u * MUSIC_TIMER_DIVIDER))
+#define MUSIC_TIMER_TAC (TACF_START | TACF_4KHZ)
+
+#define MUSIC_DIV_M_CYCLES 64u
+
 void music_init(void);
 
-void vbl_music(void) NONBANKED;
+void music_tick_isr(void) NONBANKED;
+
+void music_timer_set_speed(BOOLEAN fast);
+
+#ifdef MUSIC_TICK_PROFILE
+extern volatile UINT8 g_music_tick_div_last;
+extern volatile UINT8 g_music_tick_div_max;
+extern volatile UINT8 g_sfx_tick_div_max;
+
+void music_tick_profile_report(void);
+#endif
 
 #endif
@@ -16,10 +16,20 @@ void music3_init(void)
     NR50_REG = 0x77;
 
     disable_interrupts();
+#ifdef MUSIC_ON_VBL
     set_interrupts(VBL_IFLAG);
+#else
+    TMA_REG = MUSIC_TIMER_TMA;
+    TAC_REG = MUSIC_TIMER_TAC;
+    set_interrupts(VBL_IFLAG | TIM_IFLAG);
+#endif
 
     hUGE_init(&crateria_music);
 
-    add_VBL(vbl_music);
+#ifdef MUSIC_ON_VBL
+    add_VBL(music_tick_isr);
+#else
+    add_TIM(music_tick_isr);
+#endif
     enable_interrupts();
 }
@@ -0,0 +1,156 @@
+#include "oam.h"
+
+#include <string.h>
+
+#if defined(__SDCC)
+#include <gb/gb.h>
+#else
+#include "host_hw.h"
+
+#define move_metasprite_ex(metasprite, base_tile, base_prop, base_sprite, x, y) \
+    host_hw_move_metasprite((metasprite), (base_tile), (base_prop), (base_sprite), (x), (y))
+#define hide_sprites_range(from, to) host_hw_hide_sprites((from), (to))
+#endif
+
+typedef struct OamDraw {
+    const metasprite_t* metasprite;
+    UINT8 base_tile;
+    UINT8 base_prop;
+    UINT8 x;
+    UINT8 y;
+    UINT8 count;
+    INT8 top;
+    INT8 bottom;
+} OamDraw;
+
+static OamDraw g_oam_draws[OAM_MAX_DRAWS];
+static UINT8 g_oam_draw_count;
+
+static OamDraw g_oam_placed[OAM_MAX_DRAWS];
+static UINT8 g_oam_placed_slot[OAM_MAX_DRAWS];
+static UINT8 g_oam_placed_count;
+
+static UINT8 g_oam_band[OAM_BANDS];
+static UINT8 g_oam_rotate;
+
+UINT8 g_oam_sprites_used;
+UINT8 g_oam_writes_last_frame;
+UINT8 g_oam_dropped_last_frame;
+
+void oam_init(void) {
+    hide_sprites_range(0, OAM_RESERVED_FIRST);
+    g_oam_draw_count = 0;
+    g_oam_placed_count = 0;
+    g_oam_rotate = 0;
+    g_oam_sprites_used = 0;
+    g_oam_writes_last_frame = 0;
+    g_oam_dropped_last_frame = 0;
+}
+
+void oam_begin(void) {
+    g_oam_draw_count = 0;
+}
+
+static void oam_measure(OamDraw* d) {
+    const metasprite_t* item = d->metasprite;
+    INT8 y = 0;
+    INT8 top = 127;
+    INT8 bottom = -128;
+    UINT8 count = 0;
+
+    while (item->dy != (INT8)metasprite_end) {
+        y += item->dy;
+        if (y < top) top = y;
+        if (y > bottom) bottom = y;
+        ++count;
+        ++item;
+    }
+
+    d->count = count;
+    d->top = top;
+    d->bottom = bottom;
+}
+
+void oam_draw(const metasprite_t* metasprite, UINT8 base_tile, UINT8 base_prop, UINT8 x, UINT8 y) {
+    if (g_oam_draw_count == OAM_MAX_DRAWS) {
+        return;
+    }
+
+    OamDraw* d = &g_oam_draws[g_oam_draw_count++];
+    if (d->metasprite != metasprite) {
+        d->metasprite = metasprite;
+        oam_measure(d);
+    }
+    d->base_tile = base_tile;
+    d->base_prop = base_prop;
+    d->x = x;
+    d->y = y;
+}
+
+static BOOLEAN oam_count_bands(void) {
+    BOOLEAN crowded = 0;
+
+    memset(g_oam_band, 0, sizeof(g_oam_band));
+    for (UINT8 i = 0; i < g_oam_draw_count; ++i) {
+        const OamDraw* d = &g_oam_draws[i];
+        INT16 top = (INT16)d->y + d->top;
+        INT16 bottom = (INT16)d->y + d->bottom + 7;
+        if (top < 0) top = 0;
+        if (bottom > 255) bottom = 255;
+
+        for (UINT8 b = (UINT8)top >> OAM_BAND_SHIFT; b <= ((UINT8)bottom >> OAM_BAND_SHIFT); ++b) {
+            g_oam_band[b] += d->count;
+            if (g_oam_band[b] > OAM_LINE_LIMIT) {
+                crowded = 1;
+            }
+        }
+    }
+
+    return crowded;
+}
+
+void oam_end(void) {
+    UINT8 n = g_oam_draw_count;
+    UINT8 k = 0;
+    UINT8 slot = 0;
+    UINT8 placed = 0;
+    UINT8 writes = 0;
+    UINT8 dropped = 0;
+
+    if (n > 1 && oam_count_bands()) {
+        if (g_oam_rotate >= n) {
+            g_oam_rotate = 0;
+        }
+        k = g_oam_rotate++;
+    }
+
+    for (UINT8 i = 0; i < n; ++i) {
+        const OamDraw* d = &g_oam_draws[k];
+        if (++k == n) {
+            k = 0;
+        }
+
+        if ((UINT8)(slot + d->count) > OAM_RESERVED_FIRST) {
+            ++dropped;
+            continue;
+        }
+
+        if (placed >= g_oam_placed_count || g_oam_placed_slot[placed] != slot || memcmp(&g_oam_placed[placed], d, sizeof(OamDraw)) != 0) {
+            move_metasprite_ex(d->metasprite, d->base_tile, d->base_prop, slot, d->x, d->y);
+            memcpy(&g_oam_placed[placed], d, sizeof(OamDraw));
+            g_oam_placed_slot[placed] = slot;
+            ++writes;
+        }
+        ++placed;
+        slot += d->count;
+    }
+
+    if (slot < g_oam_sprites_used) {
+        hide_sprites_range(slot, g_oam_sprites_used);
+    }
+
+    g_oam_sprites_used = slot;
+    g_oam_placed_count = placed;
+    g_oam_writes_last_frame = writes;
+    g_oam_dropped_last_frame = dropped;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "game_types.h"
+
+#define OAM_SPRITE_COUNT 40u
+
+#ifdef VBLANK_BENCH
+#define OAM_RESERVED_FIRST 36u
+#else
+#define OAM_RESERVED_FIRST OAM_SPRITE_COUNT
+#endif
+
+#ifndef OAM_MAX_DRAWS
+#define OAM_MAX_DRAWS 16
+#endif
+
+#define OAM_LINE_LIMIT 10u
+#define OAM_BAND_SHIFT 4
+#define OAM_BANDS (256u >> OAM_BAND_SHIFT)
+
+#if defined(__SDCC)
+#include <gbdk/metasprites.h>
+#else
+typedef struct metasprite_t {
+    INT8 dy;
+    INT8 dx;
+    UINT8 dtile;
+    UINT8 props;
+} metasprite_t;
+
+#define metasprite_end -128
+#define METASPR_ITEM(dy, dx, dt, a) { (dy), (dx), (dt), (a) }
+#define METASPR_TERM { metasprite_end, 0, 0, 0 }
+#endif
+
+extern UINT8 g_oam_sprites_used;
+extern UINT8 g_oam_writes_last_frame;
+extern UINT8 g_oam_dropped_last_frame;
+
+void oam_init(void);
+
+void oam_begin(void);
+
+void oam_draw(const metasprite_t* metasprite, UINT8 base_tile, UINT8 base_prop, UINT8 x, UINT8 y);
+
+void oam_end(void);
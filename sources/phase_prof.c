@@ -0,0 +1,193 @@
+#if defined(PHASE_PROFILE) && defined(__SDCC)
+
+#include <gb/gb.h>
+#include <string.h>
+
+#include "phase_prof.h"
+#include "frame.h"
+#include "speed_gov.h"
+
+#define PHASE_PROF_SRAM_HEADER ((PhaseProfSramHeader*)PHASE_PROF_SRAM_BASE)
+#define PHASE_PROF_SRAM_RECORDS ((PhaseProfRecord*)(PHASE_PROF_SRAM_BASE + sizeof(PhaseProfSramHeader)))
+
+static const char PHASE_PROF_MAGIC[4] = { 'P', 'P', 'R', 'F' };
+
+static volatile UINT8 g_prof_tima_hi;
+static volatile UINT16 g_prof_isr_ticks;
+static volatile UINT16 g_prof_acc[PHASE_PROF_COUNT];
+
+static UINT16 g_prof_mark;
+static UINT16 g_prof_frame_start;
+static BOOLEAN g_prof_running;
+static BOOLEAN g_prof_frame_fast;
+
+static UINT16 g_prof_min[PHASE_PROF_COUNT];
+static UINT16 g_prof_max[PHASE_PROF_COUNT];
+static UINT32 g_prof_sum[PHASE_PROF_COUNT];
+static UINT8 g_prof_frames;
+static UINT8 g_prof_lag_start;
+
+UINT16 g_phase_prof_last[PHASE_PROF_COUNT];
+
+static void phase_prof_tim_isr(void) {
+    ++g_prof_tima_hi;
+}
+
+static void phase_prof_window_reset(void) {
+    for (UINT8 p = 0; p < PHASE_PROF_COUNT; ++p) {
+        g_prof_min[p] = 0xFFFFu;
+        g_prof_max[p] = 0;
+        g_prof_sum[p] = 0;
+    }
+    g_prof_frames = 0;
+    g_prof_lag_start = g_frame_lag_count;
+}
+
+static void phase_prof_flush(void) {
+    ENABLE_RAM;
+    SWITCH_RAM(0);
+
+    PhaseProfSramHeader* h = PHASE_PROF_SRAM_HEADER;
+    PhaseProfRecord* r = &PHASE_PROF_SRAM_RECORDS[h->head];
+
+    r->seq = h->seq++;
+    r->frames = g_prof_frames;
+    r->lag_frames = (UINT8)(g_frame_lag_count - g_prof_lag_start);
+    for (UINT8 p = 0; p < PHASE_PROF_COUNT; ++p) {
+        r->phase[p].min = g_prof_min[p];
+        r->phase[p].avg = (UINT16)(g_prof_sum[p] >> PHASE_PROF_WINDOW_SHIFT);
+        r->phase[p].max = g_prof_max[p];
+    }
+
+    if (++h->head == h->capacity) {
+        h->head = 0;
+    }
+    if (h->count < h->capacity) {
+        ++h->count;
+    }
+
+    DISABLE_RAM;
+}
+
+void phase_prof_init(void) {
+    ENABLE_RAM;
+    SWITCH_RAM(0);
+
+    PhaseProfSramHeader* h = PHASE_PROF_SRAM_HEADER;
+    if (memcmp(h->magic, PHASE_PROF_MAGIC, sizeof(PHASE_PROF_MAGIC)) != 0 || h->version != PHASE_PROF_SRAM_VERSION ||
+        h->phase_count != PHASE_PROF_COUNT || h->record_size != sizeof(PhaseProfRecord) ||
+        h->window_frames != PHASE_PROF_WINDOW) {
+        memcpy(h->magic, PHASE_PROF_MAGIC, sizeof(PHASE_PROF_MAGIC));
+        h->version = PHASE_PROF_SRAM_VERSION;
+        h->phase_count = PHASE_PROF_COUNT;
+        h->record_size = sizeof(PhaseProfRecord);
+        h->window_frames = PHASE_PROF_WINDOW;
+        h->capacity = PHASE_PROF_SRAM_CAPACITY;
+        h->head = 0;
+        h->count = 0;
+        h->seq = 0;
+    }
+
+    DISABLE_RAM;
+
+    phase_prof_window_reset();
+    g_prof_running = 0;
+
+    CRITICAL {
+        g_prof_tima_hi = 0;
+        g_prof_isr_ticks = 0;
+        TMA_REG = 0;
+        TIMA_REG = 0;
+        TAC_REG = TACF_START | TACF_262KHZ;
+        add_TIM(phase_prof_tim_isr);
+        set_interrupts(VBL_IFLAG | TIM_IFLAG);
+    }
+}
+
+UINT16 phase_prof_now(void) {
+    UINT8 hi;
+    UINT8 lo;
+
+    do {
+        hi = g_prof_tima_hi;
+        lo = TIMA_REG;
+    } while (hi != g_prof_tima_hi);
+
+    if ((IF_REG & TIM_IFLAG) && lo < 0x80u) {
+        ++hi;
+    }
+    return ((UINT16)hi << 8) | lo;
+}
+
+void phase_prof_isr_add(UINT8 phase, UINT16 start) {
+    UINT16 ticks = (UINT16)(phase_prof_now() - start);
+    g_prof_acc[phase] += ticks;
+    g_prof_isr_ticks += ticks;
+}
+
+void phase_prof_stall(UINT16 m_cycles) {
+    UINT16 ticks = (UINT16)((m_cycles + PHASE_PROF_M_CYCLES_PER_TICK / 2u) / PHASE_PROF_M_CYCLES_PER_TICK);
+    if (g_prof_frame_fast) {
+        ticks <<= 1;
+    }
+    g_prof_mark -= ticks;
+    g_prof_frame_start -= ticks;
+}
+
+void phase_prof_mark(UINT8 phase) {
+    UINT16 now = phase_prof_now();
+    UINT16 isr;
+
+    CRITICAL {
+        isr = g_prof_isr_ticks;
+        g_prof_isr_ticks = 0;
+        g_prof_acc[phase] += (UINT16)(now - g_prof_mark) - isr;
+    }
+    g_prof_mark = now;
+}
+
+void phase_prof_frame(void) {
+    UINT16 now = phase_prof_now();
+    UINT16 acc[PHASE_PROF_COUNT];
+
+    CRITICAL {
+        for (UINT8 p = 0; p < PHASE_PROF_COUNT; ++p) {
+            acc[p] = g_prof_acc[p];
+            g_prof_acc[p] = 0;
+        }
+        g_prof_isr_ticks = 0;
+    }
+
+    if (!g_prof_running) {
+        g_prof_running = 1;
+        g_prof_frame_start = now;
+        g_prof_frame_fast = g_speed_fast;
+        g_prof_mark = now;
+        return;
+    }
+
+    acc[PHASE_PROF_FRAME] = (UINT16)(now - g_prof_frame_start);
+    g_prof_frame_start = now;
+
+    for (UINT8 p = 0; p < PHASE_PROF_COUNT; ++p) {
+        UINT16 v = g_prof_frame_fast ? (UINT16)(acc[p] >> 1) : acc[p];
+        g_phase_prof_last[p] = v;
+        if (v < g_prof_min[p]) g_prof_min[p] = v;
+        if (v > g_prof_max[p]) g_prof_max[p] = v;
+        g_prof_sum[p] += v;
+    }
+
+    if (++g_prof_frames == PHASE_PROF_WINDOW) {
+        phase_prof_flush();
+        phase_prof_window_reset();
+    }
+
+    g_prof_frame_fast = g_speed_fast;
+
+    CRITICAL {
+        g_prof_isr_ticks = 0;
+        g_prof_mark = phase_prof_now();
+    }
+}
+
+#endif
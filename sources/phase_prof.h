@@ -0,0 +1,81 @@
+#pragma once
+
+#include "game_types.h"
+
+typedef enum PhaseProfPhase {
+    PHASE_PROF_INPUT = 0,
+    PHASE_PROF_PLAYER,
+    PHASE_PROF_ACTORS,
+    PHASE_PROF_CAMERA,
+    PHASE_PROF_DRAW,
+    PHASE_PROF_WAIT,
+    PHASE_PROF_VRAM,
+    PHASE_PROF_MUSIC,
+    PHASE_PROF_FRAME,
+    PHASE_PROF_COUNT
+} PhaseProfPhase;
+
+#define PHASE_PROF_WINDOW_SHIFT 6
+#define PHASE_PROF_WINDOW (1u << PHASE_PROF_WINDOW_SHIFT)
+
+#define PHASE_PROF_M_CYCLES_PER_TICK 4u
+
+#define PHASE_PROF_SRAM_BASE 0xA000u
+#define PHASE_PROF_SRAM_SIZE 0x2000u
+#define PHASE_PROF_SRAM_VERSION 1u
+
+typedef struct PhaseProfStat {
+    UINT16 min;
+    UINT16 avg;
+    UINT16 max;
+} PhaseProfStat;
+
+typedef struct PhaseProfRecord {
+    UINT16 seq;
+    UINT8 frames;
+    UINT8 lag_frames;
+    PhaseProfStat phase[PHASE_PROF_COUNT];
+} PhaseProfRecord;
+
+typedef struct PhaseProfSramHeader {
+    char magic[4];
+    UINT8 version;
+    UINT8 phase_count;
+    UINT8 record_size;
+    UINT8 window_frames;
+    UINT16 capacity;
+    UINT16 head;
+    UINT16 count;
+    UINT16 seq;
+} PhaseProfSramHeader;
+
+#define PHASE_PROF_SRAM_CAPACITY ((PHASE_PROF_SRAM_SIZE - sizeof(PhaseProfSramHeader)) / sizeof(PhaseProfRecord))
+
+#ifdef PHASE_PROFILE
+
+extern UINT16 g_phase_prof_last[PHASE_PROF_COUNT];
+
+void phase_prof_init(void);
+
+UINT16 phase_prof_now(void);
+
+void phase_prof_frame(void);
+
+void phase_prof_mark(UINT8 phase);
+
+void phase_prof_isr_add(UINT8 phase, UINT16 start);
+
+void phase_prof_stall(UINT16 m_cycles);
+
+#define PHASE_PROF_FRAME() phase_prof_frame()
+#define PHASE_PROF_MARK(phase) phase_prof_mark((phase))
+#define PHASE_PROF_ISR_BEGIN() UINT16 phase_prof_isr_start = phase_prof_now()
+#define PHASE_PROF_ISR_END(phase) phase_prof_isr_add((phase), phase_prof_isr_start)
+#define PHASE_PROF_STALL(m_cycles) phase_prof_stall((m_cycles))
+#else
+#define PHASE_PROF_FRAME() ((void)0)
+#define PHASE_PROF_MARK(phase) ((void)0)
+#define PHASE_PROF_ISR_BEGIN() ((void)0)
+#define PHASE_PROF_ISR_END(phase) ((void)0)
+#define PHASE_PROF_STALL(m_cycles) ((void)0)
+#endif
@@ -1,34 +1,65 @@
 #include "player.h"
 
 #include "map.h"
+#include "bank_scope.h"
+#include "player_arc_data.h"
+#include "sfx.h"
+#include "host_prof.h"
 #include <string.h>
 
+#include "oam.h"
+#include "sprite_stream.h"
+
 #if defined(__SDCC)
 #include <gb/gb.h>
 #include <gbdk/platform.h>
 #include <gbdk/metasprites.h>
 
+#include "player_frames_data.h"
+
 BANKREF_EXTERN(player_animations)
 extern const palette_color_t player_animations_palettes[];
-extern const uint8_t player_animations_tiles[];
-extern const metasprite_t* const player_animations_metasprites[];
 
-#define PLAYER_ANIM_TILES_COUNT ((UINT8)80u)
 #define PLAYER_ANIM_PALETTE_COUNT ((UINT8)7u)
+#define PLAYER_FRAME_TILES_BANK BANK(player_frame_tiles)
+#else
+#include "player_frames_sample.h"
+
+#define PLAYER_FRAME_TILES_BANK 0u
 #endif
 
-const UINT8 idle_sequence[IDLE_SEQ_LEN] = {0, 1, 2, 1};
+#define PLAYER_SPRITE_TILE_BASE ((UINT8)IDLE_TILE_BASE)
+
+static SpriteStream g_player_sprites;
+static UINT8 g_player_shown_frame;
+
+#if ANIM_CLIP_PLAYER_IDLE != PLAYER_FRAME_STATE_IDLE || ANIM_CLIP_PLAYER_RUN != PLAYER_FRAME_STATE_RUN || ANIM_CLIP_PLAYER_JUMP != PLAYER_FRAME_STATE_JUMP
+#error "player animation clips must match the PLAYER_FRAME_STATE_* rows"
+#endif
+
+static UINT8 player_frame_index(const Player* player) {
+    UINT8 dir = player->facing_left ? PLAYER_FRAME_DIR_LEFT : PLAYER_FRAME_DIR_RIGHT;
+    return PLAYER_FRAME_INDEX(player->anim.clip, dir, anim_frame(&player->anim));
+}
+
+static UINT8 player_anim_clip(const Player* player) {
+    if (!player->on_ground) {
+        return ANIM_CLIP_PLAYER_JUMP;
+    }
+    return player->is_moving ? ANIM_CLIP_PLAYER_RUN : ANIM_CLIP_PLAYER_IDLE;
+}
 
 void player_init_state(Player* player, INT16 start_x, INT16 start_y) {
     player->x = start_x;
     player->y = start_y;
-    player->vel_x = 0;
+    player->vel_x_fp = 0;
     player->vel_y = 0;
     player->x_subpixel = 0;
-    player->vel_x_subpixel = 0;
     player->y_subpixel = 0;
     player->y_speed_fp = 0;
     player->y_dir = 2;
+    player->y_arc = PLAYER_ARC_FALL;
+    player->y_arc_step = 0;
     player->accel_mode = 2;
     player->facing_left = 1;
     player->on_ground = 0;
@@ -36,9 +67,7 @@ void player_init_state(Player* player, INT16 start_x, INT16 start_y) {
     player->is_moving = 0;
     player->sprinting = 0;
     player->in_water = 0;
-    player->anim_frame = 0;
-    player->anim_timer = 0;
-    player->anim_speed = IDLE_ANIM_SPEED;
+    anim_play(&player->anim, player_anim_clip(player));
 }
 
 void player_init(Player* player, INT16 start_x, INT16 start_y) {
@@ -47,13 +76,15 @@ void player_init(Player* player, INT16 start_x, INT16 start_y) {
 #if defined(__SDCC)
 
     {
-        UINT8 old_bank = _current_bank;
-        SWITCH_ROM(BANK(player_animations));
-        set_sprite_data(IDLE_TILE_BASE, PLAYER_ANIM_TILES_COUNT, player_animations_tiles);
+        BANK_SCOPE_ENTER(BANK_ASSET_PLAYER_ANIM, BANK(player_animations));
         set_sprite_palette(0, PLAYER_ANIM_PALETTE_COUNT, player_animations_palettes);
-        SWITCH_ROM(old_bank);
+        BANK_SCOPE_EXIT();
     }
 #endif
+
+    sprite_stream_init(&g_player_sprites, PLAYER_SPRITE_TILE_BASE, PLAYER_FRAME_MAX_TILES, BANK_ASSET_PLAYER_ANIM, PLAYER_FRAME_TILES_BANK);
+    g_player_shown_frame = player_frame_index(player);
+    sprite_stream_prime(&g_player_sprites, PLAYER_FRAME_TILE_DATA[g_player_shown_frame], PLAYER_FRAME_TILE_COUNT[g_player_shown_frame]);
 }
 
 void player_input_left(Player* player, BOOLEAN just_pressed, BOOLEAN sprint_held) {
@@ -65,9 +96,7 @@ void player_input_left(Player* player, BOOLEAN just_pressed, BOOLEAN sprint_held
 
     if (just_pressed) {
         player->is_moving = 1;
-        player->anim_timer = 0;
-        player->anim_frame = 0;
-        player->anim_speed = RUN_ANIM_SPEED;
+        anim_play(&player->anim, player_anim_clip(player));
     }
 }
 
@@ -80,9 +109,7 @@ void player_input_right(Player* player, BOOLEAN just_pressed, BOOLEAN sprint_hel
 
     if (just_pressed) {
         player->is_moving = 1;
-        player->anim_timer = 0;
-        player->anim_frame = 0;
-        player->anim_speed = RUN_ANIM_SPEED;
+        anim_play(&player->anim, player_anim_clip(player));
     }
 }
 
@@ -92,21 +119,27 @@ void player_input_none(Player* player, BOOLEAN just_released) {
     player->sprinting = 0;
 
     if (just_released) {
-        player->anim_timer = 0;
-        player->anim_frame = 0;
-        player->anim_speed = IDLE_ANIM_SPEED;
+        anim_play(&player->anim, player_anim_clip(player));
     }
 }
 
+#define PLAYER_ARC_MEDIUM(player) ((player)->in_water ? PLAYER_ARC_WATER : 0)
+
+static void player_start_fall(Player* player) {
+    player->y_speed_fp = 0;
+    player->y_dir = 2;
+    player->y_arc = PLAYER_ARC_FALL | PLAYER_ARC_MEDIUM(player);
+    player->y_arc_step = 0;
+}
+
 void player_input_jump(Player* player) {
     if (player->on_ground) {
         player->on_ground = 0;
         player->y_dir = 1;
-        player->y_speed_fp = player->in_water ? PLAYER_JUMP_INIT_SPEED_FP_WATER : PLAYER_JUMP_INIT_SPEED_FP_NORMAL;
-        player->anim_frame = 2;
-        player->anim_timer = 0;
-        player->anim_speed = JUMP_ANIM_SPEED;
-
+        player->y_arc = PLAYER_ARC_RISE | PLAYER_ARC_MEDIUM(player);
+        player->y_arc_step = 0;
+        anim_play(&player->anim, ANIM_CLIP_PLAYER_JUMP);
+        sfx_play(SFX_JUMP);
     }
 }
 
@@ -137,11 +170,11 @@ static void player_apply_y_displacement_fp(Player* player, INT16 amt_fp) {
     }
 }
 
-static void player_check_start_falling(Player* player) {
-    if (player->y_dir == 1 && player->y_speed_fp < 0) {
-        player->y_speed_fp = 0;
-        player->y_dir = 2;
+static BOOLEAN player_rise_done(const Player* player) {
+    if (player->y_arc == PLAYER_ARC_FREE) {
+        return player->y_speed_fp < 0;
     }
+    return player->y_arc_step >= PLAYER_ARC_STEP_LIMIT[player->y_arc];
 }
 
 static void player_move_y_with_speed_calc(Player* player) {
@@ -169,101 +202,59 @@ static void player_move_y_with_speed_calc(Player* player) {
     player_apply_y_displacement_fp(player, amt_fp);
 }
 
-static void player_calc_horizontal_speed(Player* player) {
-    UINT16 temp_subpixel;
-    INT8 temp_speed;
-
-    if (player->accel_mode == 2) {
-
-        if (player->vel_x > 0) {
+static void player_move_y(Player* player) {
+    UINT8 arc = player->y_arc;
 
-            temp_subpixel = player->vel_x_subpixel;
-            if (temp_subpixel < PLAYER_DECEL_SUB) {
+    if (arc != PLAYER_ARC_FREE && (arc & PLAYER_ARC_WATER) != PLAYER_ARC_MEDIUM(player)) {
 
-                if (player->vel_x > 0) {
-                    player->vel_x--;
-                    temp_subpixel += 256;
-                }
-            }
-            temp_subpixel -= PLAYER_DECEL_SUB;
-            player->vel_x_subpixel = (UINT8)temp_subpixel;
-
-            if (player->vel_x == 0 && player->vel_x_subpixel == 0) {
-                player->is_moving = 0;
-            }
-        } else if (player->vel_x < 0) {
-
-            temp_subpixel = player->vel_x_subpixel;
-            if (temp_subpixel < PLAYER_DECEL_SUB) {
+        INT16 amt_fp = PLAYER_ARC_TABLES[arc][player->y_arc_step];
+        player->y_speed_fp = (amt_fp < 0) ? -amt_fp : amt_fp;
+        player->y_arc = arc = PLAYER_ARC_FREE;
+    }
 
-                player->vel_x++;
-                temp_subpixel += 256;
-            }
-            temp_subpixel -= PLAYER_DECEL_SUB;
-            player->vel_x_subpixel = (UINT8)temp_subpixel;
+    if (arc == PLAYER_ARC_FREE) {
+        player_move_y_with_speed_calc(player);
+        return;
+    }
 
-            if (player->vel_x == 0) {
-                player->vel_x_subpixel = 0;
-            }
+    UINT8 step = player->y_arc_step;
+    if (step < PLAYER_ARC_STEP_LIMIT[arc]) {
+        player->y_arc_step = step + 1;
+    }
+    player_apply_y_displacement_fp(player, PLAYER_ARC_TABLES[arc][step]);
+}
 
-            if (player->vel_x == 0 && player->vel_x_subpixel == 0) {
-                player->is_moving = 0;
-            }
-        } else if (player->vel_x_subpixel != 0) {
+static void player_calc_horizontal_speed(Player* player) {
+    INT16 vel = player->vel_x_fp;
+    INT16 max_fp = player->sprinting ? PLAYER_SPRINT_SPEED_FP : PLAYER_MAX_SPEED_FP;
 
-            if (player->vel_x_subpixel <= PLAYER_DECEL_SUB) {
-                player->vel_x_subpixel = 0;
-            } else {
-                player->vel_x_subpixel -= PLAYER_DECEL_SUB;
-            }
-            if (player->vel_x_subpixel == 0) {
-                player->is_moving = 0;
-            }
+    if (player->accel_mode == 2) {
+        if (vel == 0) {
+            return;
         }
-    } else if (player->accel_mode == 0) {
 
-        temp_subpixel = player->vel_x_subpixel + PLAYER_ACCEL_SUB;
-        temp_speed = player->vel_x;
+        if (vel < 0) {
 
-        if (temp_subpixel >= 256) {
-            temp_speed++;
-            temp_subpixel -= 256;
+            vel = (INT16)(FP_MIRROR(vel) - PLAYER_DECEL_SUB);
+            vel = (vel < FP_ONE) ? 0 : FP_MIRROR(vel);
+        } else {
+            vel = FP_SUB_FLOOR0(vel, PLAYER_DECEL_SUB);
         }
 
-        INT8 max_speed = player->sprinting ? PLAYER_SPRINT_SPEED : PLAYER_MAX_SPEED;
-        UINT8 max_speed_sub = player->sprinting ? PLAYER_SPRINT_SPEED_SUB : PLAYER_MAX_SPEED_SUB;
-
-        if (temp_speed > max_speed ||
-            (temp_speed == max_speed && temp_subpixel > max_speed_sub)) {
-            temp_speed = max_speed;
-            temp_subpixel = max_speed_sub;
+        if (vel == 0) {
+            player->is_moving = 0;
         }
-
-        player->vel_x = temp_speed;
-        player->vel_x_subpixel = (UINT8)temp_subpixel;
+    } else if (player->accel_mode == 0) {
+        vel = (INT16)(vel + PLAYER_ACCEL_SUB);
+        vel = FP_CLAMP_MAX(vel, max_fp);
     } else {
 
-        temp_subpixel = player->vel_x_subpixel + PLAYER_ACCEL_SUB;
-        temp_speed = player->vel_x;
-
-        if (temp_subpixel >= 256) {
-
-            temp_speed--;
-            temp_subpixel -= 256;
-        }
-
-        INT8 max_speed = player->sprinting ? PLAYER_SPRINT_SPEED : PLAYER_MAX_SPEED;
-        UINT8 max_speed_sub = player->sprinting ? PLAYER_SPRINT_SPEED_SUB : PLAYER_MAX_SPEED_SUB;
-
-        if (temp_speed < -max_speed ||
-            (temp_speed == -max_speed && temp_subpixel > max_speed_sub)) {
-            temp_speed = -max_speed;
-            temp_subpixel = max_speed_sub;
-        }
-
-        player->vel_x = temp_speed;
-        player->vel_x_subpixel = (UINT8)temp_subpixel;
+        vel = (INT16)(FP_MIRROR(vel) + PLAYER_ACCEL_SUB);
+        vel = FP_CLAMP_MAX(vel, max_fp);
+        vel = FP_MIRROR(vel);
     }
+
+    player->vel_x_fp = vel;
 }
 
 static void player_resolve_horizontal_collision(Player* player, INT16 old_x) {
@@ -284,8 +275,7 @@ static void player_resolve_horizontal_collision(Player* player, INT16 old_x) {
             if (map_is_solid_at(tile_x, tile_y)) {
                 player->x = (INT16)(tile_x * 8 - PLAYER_COLLISION_W);
                 player->x_subpixel = 0;
-                player->vel_x = 0;
-                player->vel_x_subpixel = 0;
+                player->vel_x_fp = 0;
                 player->accel_mode = 2;
                 return;
             }
@@ -299,8 +289,7 @@ static void player_resolve_horizontal_collision(Player* player, INT16 old_x) {
             if (map_is_solid_at(tile_x, tile_y)) {
                 player->x = (INT16)((tile_x + 1) * 8);
                 player->x_subpixel = 0;
-                player->vel_x = 0;
-                player->vel_x_subpixel = 0;
+                player->vel_x_fp = 0;
                 player->accel_mode = 2;
                 return;
             }
@@ -326,8 +315,7 @@ static BOOLEAN player_resolve_vertical_collision(Player* player, BOOLEAN was_on_
             if (map_is_solid_at(tile_x, tile_y)) {
                 player->y = (INT16)(tile_y * 8 - PLAYER_COLLISION_HALF_H);
                 player->y_subpixel = 0;
-                player->y_speed_fp = 0;
-                player->y_dir = 2;
+                player_start_fall(player);
                 player->on_ground = 1;
                 landed = !was_on_ground;
                 return landed;
@@ -340,8 +328,7 @@ static BOOLEAN player_resolve_vertical_collision(Player* player, BOOLEAN was_on_
             if (map_is_solid_at(tile_x, tile_y)) {
                 player->y = (INT16)(((tile_y + 1) * 8) + PLAYER_COLLISION_HALF_H);
                 player->y_subpixel = 0;
-                player->y_speed_fp = 0;
-                player->y_dir = 2;
+                player_start_fall(player);
                 player->on_ground = 0;
                 return 0;
             }
@@ -370,147 +357,67 @@ static BOOLEAN player_is_supported(const Player* player) {
     return 0;
 }
 
+HOST_PROF_ZONE(g_prof_player_update, "player_update");
+
 void player_update(Player* player) {
     BOOLEAN was_on_ground = player->on_ground;
 
+    HOST_PROF_BEGIN(g_prof_player_update);
+
     INT16 old_x;
 
     player_calc_horizontal_speed(player);
 
     old_x = player->x;
-    player->x += player->vel_x;
-    if (player->vel_x < 0 || (player->vel_x == 0 && player->vel_x_subpixel != 0 && player->facing_left)) {
-
-        if (player->x_subpixel < player->vel_x_subpixel) {
-            player->x--;
-            player->x_subpixel = (UINT8)(256 + player->x_subpixel - player->vel_x_subpixel);
-        } else {
-            player->x_subpixel = (UINT8)(player->x_subpixel - player->vel_x_subpixel);
-        }
-    } else {
+    {
+        INT16 dx_fp = player->vel_x_fp;
+        if (dx_fp < 0 || (dx_fp < FP_ONE && dx_fp != 0 && player->facing_left)) {
 
-        UINT16 new_subpixel = player->x_subpixel + player->vel_x_subpixel;
-        if (new_subpixel >= 256) {
-            player->x++;
-            new_subpixel -= 256;
+            dx_fp = (INT16)-FP_MIRROR(dx_fp);
         }
-        player->x_subpixel = (UINT8)new_subpixel;
+        FP_POS_ADD(player->x, player->x_subpixel, dx_fp);
     }
 
     player_resolve_horizontal_collision(player, old_x);
 
     if (!player->on_ground) {
-        player_check_start_falling(player);
-        if (player->y_dir == 1 && (!player->jumping || player->y_speed_fp < 0)) {
-            player->y_speed_fp = 0;
-            player->y_dir = 2;
+        if (player->y_dir == 1 && (!player->jumping || player_rise_done(player))) {
+            player_start_fall(player);
         }
-        player_move_y_with_speed_calc(player);
+        player_move_y(player);
 
         BOOLEAN landed = player_resolve_vertical_collision(player, was_on_ground);
         if (landed) {
-            player->anim_frame = 0;
-            player->anim_timer = 0;
-            player->anim_speed = player->is_moving ? RUN_ANIM_SPEED : IDLE_ANIM_SPEED;
-
+            anim_play(&player->anim, player_anim_clip(player));
+            sfx_play(SFX_LAND);
         }
     }
 
     else if (!player_is_supported(player)) {
         player->on_ground = 0;
-        player->y_dir = 2;
+        player_start_fall(player);
     }
 
-    if (++player->anim_timer >= player->anim_speed) {
-        player->anim_timer = 0;
-        player->anim_frame++;
-        if (!player->on_ground) {
-            if (player->anim_frame >= JUMP_FRAMES_PER_DIR) {
-                player->anim_frame = 0;
-            }
-        } else if (player->is_moving) {
-            if (player->anim_frame >= RUN_FRAMES_PER_DIR) {
-                player->anim_frame = 0;
-            }
-        } else {
-            if (player->anim_frame >= IDLE_SEQ_LEN) {
-                player->anim_frame = 0;
-            }
-        }
+    if (player_anim_clip(player) != player->anim.clip) {
+        anim_play(&player->anim, player_anim_clip(player));
     }
+    anim_tick(&player->anim);
+
+    HOST_PROF_END(g_prof_player_update);
 }
 
-#if defined(__SDCC)
 void player_draw(const Player* player, INT16 screen_x, INT16 screen_y) {
-    UINT8 sprites_used;
-
-    UINT8 old_bank = _current_bank;
-    SWITCH_ROM(BANK(player_animations));
+    UINT8 frame = player_frame_index(player);
 
-    if (!player->on_ground) {
-        if (player->facing_left) {
-            sprites_used = move_metasprite_ex(
-                player_animations_metasprites[16 + player->anim_frame],
-                IDLE_TILE_BASE,
-                0,
-                0,
-                screen_x,
-                screen_y
-            );
-        }
-        else {
-            sprites_used = move_metasprite_flipx(
-                player_animations_metasprites[16 + player->anim_frame],
-                IDLE_TILE_BASE,
-                0,
-                0,
-                screen_x,
-                screen_y
-            );
-        }
-    } else if (player->is_moving) {
-        if (player->facing_left) {
-            sprites_used = move_metasprite_ex(
-                player_animations_metasprites[6 + player->anim_frame],
-                IDLE_TILE_BASE,
-                0,
-                0,
-                screen_x,
-                screen_y
-            );
-        }
-        else {
-            sprites_used = move_metasprite_flipx(
-                player_animations_metasprites[6 + player->anim_frame],
-                IDLE_TILE_BASE,
-                0,
-                0,
-                screen_x,
-                screen_y
-            );
-        }
-    } else {
-
-        UINT8 idle_base = player->facing_left ? 0 : IDLE_FRAMES_PER_DIR;
-        UINT8 frame_idx = idle_base + idle_sequence[player->anim_frame];
-        sprites_used = move_metasprite_ex(
-            player_animations_metasprites[frame_idx],
-            IDLE_TILE_BASE,
-            0,
-            0,
-            screen_x,
-            screen_y
-        );
+    if (sprite_stream_request(&g_player_sprites, PLAYER_FRAME_TILE_DATA[frame], PLAYER_FRAME_TILE_COUNT[frame])) {
+        g_player_shown_frame = frame;
     }
 
-#ifdef VBLANK_BENCH
-
-    hide_sprites_range(sprites_used, 36u);
-#else
-    hide_sprites_range(sprites_used, 40u);
-#endif
-
-    SWITCH_ROM(old_bank);
+    oam_draw(
+        PLAYER_FRAMES[g_player_shown_frame],
+        sprite_stream_base_tile(&g_player_sprites),
+        0,
+        (UINT8)screen_x,
+        (UINT8)screen_y
+    );
 }
-
-#endif
@@ -1,27 +1,28 @@
 #pragma once
 
 #include "game_types.h"
+#include "fixed.h"
+#include "anim.h"
 
 struct Map;
 
 typedef struct {
     INT16 x;
     INT16 y;
-    INT8 vel_x;
+    INT16 vel_x_fp;
     INT8 vel_y;
 
     UINT8 x_subpixel;
-    UINT8 vel_x_subpixel;
 
     UINT8 y_subpixel;
     INT16 y_speed_fp;
     UINT8 y_dir;
+    UINT8 y_arc;
+    UINT8 y_arc_step;
 
     UINT8 gravity_timer;
 
-    UINT8 anim_frame;
-    UINT8 anim_timer;
-    UINT8 anim_speed;
+    Anim anim;
 
     UINT8 accel_mode;
 
@@ -43,12 +44,20 @@ typedef struct {
 #define PLAYER_GRAVITY_ACCEL_FP_NORMAL ((INT16)21)
 #define PLAYER_GRAVITY_ACCEL_FP_WATER  ((INT16)6)
 
+#define PLAYER_ARC_RISE  0
+#define PLAYER_ARC_WATER 1
+#define PLAYER_ARC_FALL  2
+#define PLAYER_ARC_FREE  4
+
 #define PLAYER_ACCEL_SUB        48
 #define PLAYER_MAX_SPEED        2
 #define PLAYER_MAX_SPEED_SUB    192
 #define PLAYER_SPRINT_SPEED     4
 #define PLAYER_SPRINT_SPEED_SUB 0
 #define PLAYER_DECEL_SUB        64
+
+#define PLAYER_MAX_SPEED_FP    FP_MAKE(PLAYER_MAX_SPEED, PLAYER_MAX_SPEED_SUB)
+#define PLAYER_SPRINT_SPEED_FP FP_MAKE(PLAYER_SPRINT_SPEED, PLAYER_SPRINT_SPEED_SUB)
 #define PLAYER_HALF_WIDTH       8
 
 #define PLAYER_COLLISION_W      (PLAYER_HALF_WIDTH * 2)
@@ -70,9 +79,7 @@ void player_init(Player* player, INT16 start_x, INT16 start_y);
 
 void player_update(Player* player);
 
-#if defined(__SDCC)
 void player_draw(const Player* player, INT16 screen_x, INT16 screen_y);
-#endif
 
 void player_input_left(Player* player, BOOLEAN just_pressed, BOOLEAN sprint_held);
 void player_input_right(Player* player, BOOLEAN just_pressed, BOOLEAN sprint_held);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "game_types.h"
+
+static const INT16 PLAYER_ARC_RISE_NORMAL[45] = {
+    -936, -915, -894, -873, -852, -831, -810, -789, -768, -747, -726, -705,
+    -684, -663, -642, -621, -600, -579, -558, -537, -516, -495, -474, -453,
+    -432, -411, -390, -369, -348, -327, -306, -285, -264, -243, -222, -201,
+    -180, -159, -138, -117, -96, -75, -54, -33, -12,
+};
+
+static const INT16 PLAYER_ARC_RISE_WATER[57] = {
+    -336, -330, -324, -318, -312, -306, -300, -294, -288, -282, -276, -270,
+    -264, -258, -252, -246, -240, -234, -228, -222, -216, -210, -204, -198,
+    -192, -186, -180, -174, -168, -162, -156, -150, -144, -138, -132, -126,
+    -120, -114, -108, -102, -96, -90, -84, -78, -72, -66, -60, -54,
+    -48, -42, -36, -30, -24, -18, -12, -6, 0,
+};
+
+static const INT16 PLAYER_ARC_FALL_NORMAL[47] = {
+    0, 21, 42, 63, 84, 105, 126, 147, 168, 189, 210, 231,
+    252, 273, 294, 315, 336, 357, 378, 399, 420, 441, 462, 483,
+    504, 525, 546, 567, 588, 609, 630, 651, 672, 693, 714, 735,
+    756, 777, 798, 819, 840, 861, 882, 903, 924, 945, 960,
+};
+
+static const INT16 PLAYER_ARC_FALL_WATER[161] = {
+    0, 6, 12, 18, 24, 30, 36, 42, 48, 54, 60, 66,
+    72, 78, 84, 90, 96, 102, 108, 114, 120, 126, 132, 138,
+    144, 150, 156, 162, 168, 174, 180, 186, 192, 198, 204, 210,
+    216, 222, 228, 234, 240, 246, 252, 258, 264, 270, 276, 282,
+    288, 294, 300, 306, 312, 318, 324, 330, 336, 342, 348, 354,
+    360, 366, 372, 378, 384, 390, 396, 402, 408, 414, 420, 426,
+    432, 438, 444, 450, 456, 462, 468, 474, 480, 486, 492, 498,
+    504, 510, 516, 522, 528, 534, 540, 546, 552, 558, 564, 570,
+    576, 582, 588, 594, 600, 606, 612, 618, 624, 630, 636, 642,
+    648, 654, 660, 666, 672, 678, 684, 690, 696, 702, 708, 714,
+    720, 726, 732, 738, 744, 750, 756, 762, 768, 774, 780, 786,
+    792, 798, 804, 810, 816, 822, 828, 834, 840, 846, 852, 858,
+    864, 870, 876, 882, 888, 894, 900, 906, 912, 918, 924, 930,
+    936, 942, 948, 954, 960,
+};
+
+static const INT16* const PLAYER_ARC_TABLES[4] = {
+    PLAYER_ARC_RISE_NORMAL,
+    PLAYER_ARC_RISE_WATER,
+    PLAYER_ARC_FALL_NORMAL,
+    PLAYER_ARC_FALL_WATER,
+};
+
+static const UINT8 PLAYER_ARC_STEP_LIMIT[4] = {
+    45, 57, 46, 160,
+};
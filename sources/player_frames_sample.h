@@ -0,0 +1,104 @@
+#pragma once
+
+#include "game_types.h"
+#include "oam.h"
+
+#define PLAYER_FRAME_STATE_IDLE 0
+#define PLAYER_FRAME_STATE_RUN 1
+#define PLAYER_FRAME_STATE_JUMP 2
+#define PLAYER_FRAME_DIR_LEFT 0
+#define PLAYER_FRAME_DIR_RIGHT 1
+#define PLAYER_FRAME_STRIDE_SHIFT 4
+#define PLAYER_FRAME_INDEX(state, dir, frame) \
+    ((UINT8)((((state) << 1) | (dir)) << PLAYER_FRAME_STRIDE_SHIFT) + (frame))
+#define PLAYER_FRAME_MAX_TILES 4
+
+static const UINT8 player_frame_tiles[192] = {
+    0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF,
+    0x01, 0xFE, 0x01, 0xFE, 0x01, 0xFE, 0x01, 0xFE, 0x01, 0xFE, 0x01, 0xFE, 0x01, 0xFE, 0x01, 0xFE,
+    0x02, 0xFD, 0x02, 0xFD, 0x02, 0xFD, 0x02, 0xFD, 0x02, 0xFD, 0x02, 0xFD, 0x02, 0xFD, 0x02, 0xFD,
+    0x03, 0xFC, 0x03, 0xFC, 0x03, 0xFC, 0x03, 0xFC, 0x03, 0xFC, 0x03, 0xFC, 0x03, 0xFC, 0x03, 0xFC,
+    0x04, 0xFB, 0x04, 0xFB, 0x04, 0xFB, 0x04, 0xFB, 0x04, 0xFB, 0x04, 0xFB, 0x04, 0xFB, 0x04, 0xFB,
+    0x05, 0xFA, 0x05, 0xFA, 0x05, 0xFA, 0x05, 0xFA, 0x05, 0xFA, 0x05, 0xFA, 0x05, 0xFA, 0x05, 0xFA,
+    0x06, 0xF9, 0x06, 0xF9, 0x06, 0xF9, 0x06, 0xF9, 0x06, 0xF9, 0x06, 0xF9, 0x06, 0xF9, 0x06, 0xF9,
+    0x07, 0xF8, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xF8,
+    0x08, 0xF7, 0x08, 0xF7, 0x08, 0xF7, 0x08, 0xF7, 0x08, 0xF7, 0x08, 0xF7, 0x08, 0xF7, 0x08, 0xF7,
+    0x09, 0xF6, 0x09, 0xF6, 0x09, 0xF6, 0x09, 0xF6, 0x09, 0xF6, 0x09, 0xF6, 0x09, 0xF6, 0x09, 0xF6,
+    0x0A, 0xF5, 0x0A, 0xF5, 0x0A, 0xF5, 0x0A, 0xF5, 0x0A, 0xF5, 0x0A, 0xF5, 0x0A, 0xF5, 0x0A, 0xF5,
+    0x0B, 0xF4, 0x0B, 0xF4, 0x0B, 0xF4, 0x0B, 0xF4, 0x0B, 0xF4, 0x0B, 0xF4, 0x0B, 0xF4, 0x0B, 0xF4,
+};
+
+static const metasprite_t player_frame_0[] = {
+    METASPR_ITEM(0, 0, 0, 0x00),
+    METASPR_ITEM(0, 8, 1, 0x00),
+    METASPR_ITEM(8, -8, 2, 0x00),
+    METASPR_ITEM(0, 8, 3, 0x00),
+    METASPR_TERM
+};
+
+static const metasprite_t player_frame_0_fx[] = {
+    METASPR_ITEM(0, -8, 0, 0x20),
+    METASPR_ITEM(0, -8, 1, 0x20),
+    METASPR_ITEM(8, 8, 2, 0x20),
+    METASPR_ITEM(0, -8, 3, 0x20),
+    METASPR_TERM
+};
+
+static const metasprite_t player_frame_1[] = {
+    METASPR_ITEM(0, 0, 0, 0x00),
+    METASPR_ITEM(0, 8, 1, 0x00),
+    METASPR_ITEM(8, -8, 2, 0x00),
+    METASPR_ITEM(0, 8, 3, 0x00),
+    METASPR_TERM
+};
+
+static const metasprite_t player_frame_1_fx[] = {
+    METASPR_ITEM(0, -8, 0, 0x20),
+    METASPR_ITEM(0, -8, 1, 0x20),
+    METASPR_ITEM(8, 8, 2, 0x20),
+    METASPR_ITEM(0, -8, 3, 0x20),
+    METASPR_TERM
+};
+
+static const metasprite_t player_frame_2[] = {
+    METASPR_ITEM(0, 0, 0, 0x00),
+    METASPR_ITEM(0, 8, 1, 0x00),
+    METASPR_ITEM(8, -8, 2, 0x00),
+    METASPR_ITEM(0, 8, 3, 0x00),
+    METASPR_TERM
+};
+
+static const metasprite_t player_frame_2_fx[] = {
+    METASPR_ITEM(0, -8, 0, 0x20),
+    METASPR_ITEM(0, -8, 1, 0x20),
+    METASPR_ITEM(8, 8, 2, 0x20),
+    METASPR_ITEM(0, -8, 3, 0x20),
+    METASPR_TERM
+};
+
+static const metasprite_t* const PLAYER_FRAMES[96] = {
+    player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0, player_frame_0,
+    player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx, player_frame_0_fx,
+    player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1, player_frame_1,
+    player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx, player_frame_1_fx,
+    player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2, player_frame_2,
+    player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx, player_frame_2_fx,
+};
+
+static const UINT8* const PLAYER_FRAME_TILE_DATA[96] = {
+    player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000,
+    player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000, player_frame_tiles + 0x0000,
+    player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040,
+    player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040, player_frame_tiles + 0x0040,
+    player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080,
+    player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080, player_frame_tiles + 0x0080,
+};
+
+static const UINT8 PLAYER_FRAME_TILE_COUNT[96] = {
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+};
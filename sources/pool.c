@@ -0,0 +1,58 @@
+#if defined(ACTORS) || !defined(__SDCC)
+
+#include "pool.h"
+
+void pool_init(Pool* pool, UINT8* next, UINT8* gen, UINT8 first, UINT8 capacity) {
+    pool->next = next;
+    pool->gen = gen;
+    pool->live = 0;
+    pool->first = first;
+    pool->capacity = capacity;
+    pool->free_head = capacity ? first : POOL_INDEX_NONE;
+
+    UINT8 last = (UINT8)(first + capacity - 1u);
+    for (UINT8 i = first; i != (UINT8)(first + capacity); ++i) {
+        next[i] = (i == last) ? POOL_INDEX_NONE : (UINT8)(i + 1u);
+        gen[i] = 0;
+    }
+}
+
+PoolHandle pool_alloc(Pool* pool) {
+    UINT8 index = pool->free_head;
+    if (index == POOL_INDEX_NONE) {
+        return POOL_HANDLE_NONE;
+    }
+
+    pool->free_head = pool->next[index];
+    pool->next[index] = POOL_INDEX_LIVE;
+    pool->live++;
+
+    return POOL_HANDLE(pool->gen[index], index);
+}
+
+UINT8 pool_resolve(const Pool* pool, PoolHandle handle) {
+    UINT8 index = POOL_HANDLE_INDEX(handle);
+    if (handle == POOL_HANDLE_NONE || (UINT8)(index - pool->first) >= pool->capacity) {
+        return POOL_INDEX_NONE;
+    }
+    if (pool->next[index] != POOL_INDEX_LIVE || pool->gen[index] != POOL_HANDLE_GEN(handle)) {
+        return POOL_INDEX_NONE;
+    }
+    return index;
+}
+
+BOOLEAN pool_free(Pool* pool, PoolHandle handle) {
+    UINT8 index = pool_resolve(pool, handle);
+    if (index == POOL_INDEX_NONE) {
+        return 0;
+    }
+
+    pool->gen[index]++;
+    pool->next[index] = pool->free_head;
+    pool->free_head = index;
+    pool->live--;
+
+    return 1;
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "game_types.h"
+
+typedef UINT16 PoolHandle;
+
+#define POOL_HANDLE_NONE ((PoolHandle)0xFFFFu)
+#define POOL_INDEX_NONE 0xFFu
+#define POOL_INDEX_LIVE 0xFEu
+
+#define POOL_HANDLE(gen, index) ((PoolHandle)(((UINT16)(gen) << 8) | (UINT8)(index)))
+#define POOL_HANDLE_INDEX(h) ((UINT8)(h))
+#define POOL_HANDLE_GEN(h) ((UINT8)((UINT16)(h) >> 8))
+
+typedef struct Pool {
+    UINT8* next;
+    UINT8* gen;
+    UINT8 free_head;
+    UINT8 live;
+    UINT8 first;
+    UINT8 capacity;
+} Pool;
+
+void pool_init(Pool* pool, UINT8* next, UINT8* gen, UINT8 first, UINT8 capacity);
+
+PoolHandle pool_alloc(Pool* pool);
+
+BOOLEAN pool_free(Pool* pool, PoolHandle handle);
+
+UINT8 pool_resolve(const Pool* pool, PoolHandle handle);
+
+#define pool_handle_of(pool, index) POOL_HANDLE((pool)->gen[(index)], (index))
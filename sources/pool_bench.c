@@ -0,0 +1,205 @@
+#if defined(POOL_BENCH) && !defined(__SDCC)
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "actor.h"
+#include "host_prof.h"
+#include "host_rand.h"
+#include "map.h"
+#include "pool.h"
+
+#define POOL_BENCH_FPS 60u
+#define POOL_BENCH_RAW_CAPACITY 254u
+#define POOL_BENCH_SPAWNS_PER_FRAME 40u
+#define POOL_BENCH_FILL(capacity) ((UINT8)(((capacity) * 3u) / 4u))
+
+static uint32_t g_bench_rng = 0x9E3779B9u;
+
+static void bench_pool_raw(uint32_t ops) {
+    static UINT8 next[POOL_BENCH_RAW_CAPACITY];
+    static UINT8 gen[POOL_BENCH_RAW_CAPACITY];
+    static PoolHandle held[POOL_BENCH_RAW_CAPACITY];
+    Pool pool;
+    uint32_t held_count = 0;
+    uint32_t allocs = 0;
+    uint32_t frees = 0;
+    uint32_t full = 0;
+    uint32_t stale_rejected = 0;
+    PoolHandle stale = POOL_HANDLE_NONE;
+
+    pool_init(&pool, next, gen, 0, POOL_BENCH_RAW_CAPACITY);
+
+    uint64_t t0 = host_prof_now_ns();
+    for (uint32_t i = 0; i < ops; i++) {
+        if (held_count == 0u || (held_count < POOL_BENCH_RAW_CAPACITY && (host_rand_next(&g_bench_rng) & 1u))) {
+            PoolHandle h = pool_alloc(&pool);
+            if (h == POOL_HANDLE_NONE) {
+                full++;
+                continue;
+            }
+            held[held_count++] = h;
+            allocs++;
+        } else {
+            uint32_t k = host_rand_next(&g_bench_rng) % held_count;
+            PoolHandle h = held[k];
+            held[k] = held[--held_count];
+            if (!pool_free(&pool, h)) {
+                fprintf(stderr, "pool_free rejected a live handle %04x\n", (unsigned)h);
+                exit(1);
+            }
+            frees++;
+            if (stale != POOL_HANDLE_NONE && !pool_free(&pool, stale)) {
+                stale_rejected++;
+            }
+            stale = h;
+        }
+    }
+    uint64_t dt = host_prof_now_ns() - t0;
+
+    if (pool_resolve(&pool, POOL_HANDLE(0, POOL_BENCH_RAW_CAPACITY)) != POOL_INDEX_NONE) {
+        fprintf(stderr, "pool_resolve accepted an index past the pool\n");
+        exit(1);
+    }
+    if (pool.live != held_count) {
+        fprintf(stderr, "pool live %u != held %u\n", (unsigned)pool.live, (unsigned)held_count);
+        exit(1);
+    }
+
+    printf("raw pool: %u ops, %u alloc, %u free, %u full, %u stale frees rejected, %.2f ns/op\n",
+        (unsigned)ops, (unsigned)allocs, (unsigned)frees, (unsigned)full, (unsigned)stale_rejected,
+        ops ? (double)dt / (double)ops : 0.0);
+}
+
+static ActorHandle g_bench_held[ACTOR_CAPACITY];
+static uint32_t g_bench_held_count;
+
+static uint32_t bench_prune(void) {
+    uint32_t stale = 0;
+    for (uint32_t k = 0; k < g_bench_held_count;) {
+        if (actor_resolve(g_bench_held[k]) == ACTOR_NONE) {
+            g_bench_held[k] = g_bench_held[--g_bench_held_count];
+            stale++;
+        } else {
+            k++;
+        }
+    }
+    return stale;
+}
+
+static BOOLEAN bench_kill_from(UINT8 pool_id) {
+    const Pool* pool = &g_actor_pools[pool_id];
+    uint32_t picks = 0;
+    uint32_t pick = 0;
+
+    for (uint32_t k = 0; k < g_bench_held_count; k++) {
+        UINT8 slot = POOL_HANDLE_INDEX(g_bench_held[k]);
+        if ((UINT8)(slot - pool->first) < pool->capacity && (host_rand_next(&g_bench_rng) % ++picks) == 0u) {
+            pick = k;
+        }
+    }
+    if (picks == 0u) {
+        return 0;
+    }
+
+    ActorHandle h = g_bench_held[pick];
+    g_bench_held[pick] = g_bench_held[--g_bench_held_count];
+    actor_despawn(actor_resolve(h));
+    if (actor_resolve(h) != ACTOR_NONE) {
+        fprintf(stderr, "handle %04x still resolves after despawn\n", (unsigned)h);
+        exit(1);
+    }
+    return 1;
+}
+
+static void bench_actors(uint32_t seconds, uint32_t spawns_per_frame) {
+    uint32_t frames = seconds * POOL_BENCH_FPS;
+    uint32_t spawned = 0;
+    uint32_t spawn_failed = 0;
+    uint32_t killed = 0;
+    uint32_t stale = 0;
+    uint32_t peak = 0;
+    uint64_t total_ns = 0;
+    uint64_t min_ns = ~0ull;
+    uint64_t max_ns = 0;
+
+    for (UINT16 x = 0; x < 256u; x++) {
+        map_test_set_block_type_at(0, x, 30, MAP_BLOCKTYPE_SOLID);
+    }
+    for (UINT16 y = 0; y < 30u; y++) {
+        map_test_set_block_type_at(0, 0, y, MAP_BLOCKTYPE_SOLID);
+        map_test_set_block_type_at(0, 255, y, MAP_BLOCKTYPE_SOLID);
+    }
+    g_bench_held_count = 0;
+
+    actor_system_init();
+    for (UINT8 i = 0; i < ACTOR_ENEMY_CAPACITY / 2u; i++) {
+        actor_spawn(ACTOR_KIND_WALKER, (INT16)(64 + i * 96), 64);
+    }
+
+    for (uint32_t f = 0; f < frames; f++) {
+        uint64_t t0 = host_prof_now_ns();
+
+        for (uint32_t s = 0; s < spawns_per_frame; s++) {
+            UINT8 kind = (host_rand_next(&g_bench_rng) & 1u) ? ACTOR_KIND_PROJECTILE : ACTOR_KIND_PARTICLE;
+            UINT8 pool_id = (kind == ACTOR_KIND_PROJECTILE) ? ACTOR_POOL_PROJECTILE : ACTOR_POOL_PARTICLE;
+            const Pool* pool = &g_actor_pools[pool_id];
+
+            if (pool->live >= POOL_BENCH_FILL(pool->capacity)) {
+                stale += bench_prune();
+                killed += bench_kill_from(pool_id);
+            }
+
+            ActorHandle h = actor_spawn(kind, (INT16)(16 + (host_rand_next(&g_bench_rng) % 1984u)), (INT16)(32 + (host_rand_next(&g_bench_rng) % 160u)));
+            if (h == ACTOR_HANDLE_NONE) {
+                spawn_failed++;
+                continue;
+            }
+            spawned++;
+            if (g_bench_held_count == ACTOR_CAPACITY) {
+                stale += bench_prune();
+            }
+            g_bench_held[g_bench_held_count++] = h;
+        }
+
+        actor_update_all();
+
+        uint64_t dt = host_prof_now_ns() - t0;
+        total_ns += dt;
+        if (dt < min_ns) min_ns = dt;
+        if (dt > max_ns) max_ns = dt;
+        if (actor_active_count > peak) peak = actor_active_count;
+
+        {
+            uint32_t live = 0;
+            for (UINT8 p = 0; p < ACTOR_POOL_COUNT; p++) {
+                live += g_actor_pools[p].live;
+            }
+            if (live != actor_active_count) {
+                fprintf(stderr, "frame %u: pool live %u != active %u\n", (unsigned)f, (unsigned)live, (unsigned)actor_active_count);
+                exit(1);
+            }
+        }
+    }
+
+    printf("actors: %u frames (%u s), %u spawned (%.1f/s), %u pool full, %u killed by handle (%.1f/s), %u expired\n",
+        (unsigned)frames, (unsigned)seconds, (unsigned)spawned, seconds ? (double)spawned / (double)seconds : 0.0,
+        (unsigned)spawn_failed, (unsigned)killed, seconds ? (double)killed / (double)seconds : 0.0, (unsigned)stale);
+    printf("actors: peak %u/%u live, frame ns min %llu avg %.1f max %llu\n",
+        (unsigned)peak, (unsigned)ACTOR_CAPACITY, (unsigned long long)min_ns,
+        frames ? (double)total_ns / (double)frames : 0.0, (unsigned long long)max_ns);
+}
+
+int main(int argc, char** argv) {
+    uint32_t seconds = (argc > 1) ? (uint32_t)strtoul(argv[1], 0, 0) : 600u;
+    uint32_t spawns = (argc > 2) ? (uint32_t)strtoul(argv[2], 0, 0) : POOL_BENCH_SPAWNS_PER_FRAME;
+    if (argc > 3) {
+        g_bench_rng = host_rand_seed((uint32_t)strtoul(argv[3], 0, 0));
+    }
+
+    bench_pool_raw(seconds * POOL_BENCH_FPS * spawns * 2u);
+    bench_actors(seconds, spawns);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,188 @@
+#if defined(REPLAY_BENCH) && !defined(__SDCC)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_prof.h"
+#include "host_rand.h"
+#include "input.h"
+#include "map.h"
+#include "player.h"
+
+#define REPLAY_BENCH_FRAMES 20000u
+#define REPLAY_BENCH_LEVEL_W 128u
+#define REPLAY_BENCH_LEVEL_H 48u
+#define REPLAY_BENCH_FLOOR_Y 40u
+#define REPLAY_BENCH_START_TX 8u
+#define REPLAY_BENCH_START_TY 30u
+
+#define REPLAY_BENCH_FNV_BASIS 2166136261u
+#define REPLAY_BENCH_FNV(hash, v) (((hash) ^ (uint32_t)(v)) * 16777619u)
+
+typedef struct ReplayBenchGolden {
+    uint32_t seed;
+    uint32_t physics;
+    uint32_t anim;
+} ReplayBenchGolden;
+
+static const ReplayBenchGolden REPLAY_BENCH_GOLDEN[] = {
+    { 0x00000001u, 0x85365fa3u, 0x1fd1ccd2u },
+    { 0x00000003u, 0x391556f2u, 0x4704d825u },
+    { 0x00000005u, 0x68414980u, 0x5c684efbu },
+    { 0x00000007u, 0xab9bce99u, 0x16c48e99u },
+    { 0x00000009u, 0x80d2f192u, 0x609c052cu },
+    { 0x0000000bu, 0x3d5d7f5cu, 0xc0ad1bb8u },
+    { 0x0000000du, 0x8e147281u, 0x6b40820bu },
+    { 0x0000000fu, 0xdffc34a4u, 0x7503ad0cu },
+    { 0x00000011u, 0xd1b65ac6u, 0x99411c39u },
+    { 0x00000013u, 0x8d324336u, 0x9e9a662fu },
+    { 0x00000015u, 0x83b06f41u, 0x83a9e75du },
+    { 0x00000017u, 0x72fae401u, 0x67b65355u },
+};
+
+#define REPLAY_BENCH_SEEDS (sizeof(REPLAY_BENCH_GOLDEN) / sizeof(REPLAY_BENCH_GOLDEN[0]))
+
+static UINT8 g_bench_level[REPLAY_BENCH_LEVEL_W * REPLAY_BENCH_LEVEL_H];
+
+static void bench_build_level(uint32_t* rng) {
+    memset(g_bench_level, MAP_BLOCKTYPE_AIR, sizeof(g_bench_level));
+
+    for (UINT16 y = 0; y < REPLAY_BENCH_LEVEL_H; y++) {
+        for (UINT16 x = 0; x < REPLAY_BENCH_LEVEL_W; x++) {
+            BOOLEAN edge = x == 0u || x == REPLAY_BENCH_LEVEL_W - 1u || y == 0u || y >= REPLAY_BENCH_FLOOR_Y;
+            if (edge || (host_rand_next(rng) % 14u) == 0u) {
+                g_bench_level[y * REPLAY_BENCH_LEVEL_W + x] = MAP_BLOCKTYPE_SOLID;
+            }
+        }
+    }
+    for (UINT16 y = REPLAY_BENCH_START_TY - 6u; y < REPLAY_BENCH_START_TY; y++) {
+        for (UINT16 x = REPLAY_BENCH_START_TX - 2u; x < REPLAY_BENCH_START_TX + 4u; x++) {
+            g_bench_level[y * REPLAY_BENCH_LEVEL_W + x] = MAP_BLOCKTYPE_AIR;
+        }
+    }
+    map_test_load(g_bench_level, REPLAY_BENCH_LEVEL_W, REPLAY_BENCH_LEVEL_H);
+}
+
+static UINT8 bench_next_joy(uint32_t* rng, UINT8 joy) {
+    uint32_t r = host_rand_next(rng);
+
+    if ((r & 15u) == 0u) {
+        joy &= (UINT8)~(J_LEFT | J_RIGHT);
+        switch ((r >> 4) % 3u) {
+            case 0: joy |= J_LEFT; break;
+            case 1: joy |= J_RIGHT; break;
+            default: break;
+        }
+    }
+    if (((r >> 8) & 7u) == 0u) {
+        joy ^= J_A;
+    }
+    if (((r >> 11) & 31u) == 0u) {
+        joy ^= J_B;
+    }
+    joy &= (UINT8)~J_SELECT;
+    if (((r >> 16) & 511u) == 0u) {
+        joy |= J_SELECT;
+    }
+    return joy;
+}
+
+static void bench_input(Player* p, UINT8 joy, UINT8 prev) {
+    if ((joy & J_SELECT) && !(prev & J_SELECT)) {
+        p->in_water = !p->in_water;
+    }
+
+    p->jumping = (joy & J_A) != 0;
+    if ((joy & J_A) && !(prev & J_A)) {
+        player_input_jump(p);
+    }
+
+    BOOLEAN sprint_held = (joy & J_B) && p->on_ground;
+    if (joy & J_LEFT) {
+        player_input_left(p, !(prev & J_LEFT), sprint_held);
+    } else if (joy & J_RIGHT) {
+        player_input_right(p, !(prev & J_RIGHT), sprint_held);
+    } else {
+        player_input_none(p, (prev & (J_LEFT | J_RIGHT)) != 0);
+    }
+}
+
+static uint32_t bench_hash_physics(uint32_t hash, const Player* p) {
+    hash = REPLAY_BENCH_FNV(hash, (UINT16)p->x);
+    hash = REPLAY_BENCH_FNV(hash, p->x_subpixel);
+    hash = REPLAY_BENCH_FNV(hash, (UINT16)p->y);
+    hash = REPLAY_BENCH_FNV(hash, p->y_subpixel);
+    hash = REPLAY_BENCH_FNV(hash, p->y_dir);
+    hash = REPLAY_BENCH_FNV(hash, p->on_ground);
+    hash = REPLAY_BENCH_FNV(hash, p->is_moving);
+    return REPLAY_BENCH_FNV(hash, p->facing_left);
+}
+
+static uint32_t bench_hash_anim(uint32_t hash, const Player* p) {
+    hash = REPLAY_BENCH_FNV(hash, p->anim.clip);
+    hash = REPLAY_BENCH_FNV(hash, p->anim.step);
+    return REPLAY_BENCH_FNV(hash, p->anim.timer);
+}
+
+static BOOLEAN bench_replay(const ReplayBenchGolden* g, BOOLEAN print, uint64_t* ns) {
+    uint32_t rng = host_rand_seed(g->seed);
+    uint32_t physics = REPLAY_BENCH_FNV_BASIS;
+    uint32_t anim = REPLAY_BENCH_FNV_BASIS;
+    UINT8 joy = 0;
+    UINT8 prev = 0;
+    Player p;
+
+    bench_build_level(&rng);
+    player_init_state(&p, (INT16)(REPLAY_BENCH_START_TX * 8u), (INT16)(REPLAY_BENCH_START_TY * 8u - PLAYER_COLLISION_HALF_H));
+
+    for (uint32_t f = 0; f < REPLAY_BENCH_FRAMES; f++) {
+        joy = bench_next_joy(&rng, joy);
+
+        uint64_t t0 = host_prof_now_ns();
+        bench_input(&p, joy, prev);
+        player_update(&p);
+        *ns += host_prof_now_ns() - t0;
+
+        prev = joy;
+        physics = bench_hash_physics(physics, &p);
+        anim = bench_hash_anim(anim, &p);
+    }
+
+    BOOLEAN ok = physics == g->physics && anim == g->anim;
+    if (print) {
+        printf("    { 0x%08xu, 0x%08xu, 0x%08xu },\n", (unsigned)g->seed, (unsigned)physics, (unsigned)anim);
+    } else {
+        printf("seed %08x: physics %08x%s anim %08x%s, end %d,%d\n", (unsigned)g->seed, (unsigned)physics,
+            physics == g->physics ? "" : " MISMATCH", (unsigned)anim, anim == g->anim ? "" : " MISMATCH", p.x, p.y);
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    BOOLEAN print = argc > 1 && strcmp(argv[1], "-print") == 0;
+    if (argc > 1 && !print) {
+        fprintf(stderr, "usage: %s [-print]\n", argv[0]);
+        return 2;
+    }
+
+    uint32_t failures = 0;
+    uint64_t ns = 0;
+    for (uint32_t i = 0; i < REPLAY_BENCH_SEEDS; i++) {
+        if (!bench_replay(&REPLAY_BENCH_GOLDEN[i], print, &ns)) {
+            failures++;
+        }
+    }
+
+    double frames = (double)REPLAY_BENCH_SEEDS * REPLAY_BENCH_FRAMES;
+    printf("%u seeds x %u frames, %.1f ns/frame in input + player_update\n", (unsigned)REPLAY_BENCH_SEEDS,
+        (unsigned)REPLAY_BENCH_FRAMES, (double)ns / frames);
+    if (print) {
+        return 0;
+    }
+    printf("%s: %u of %u seeds differ from the recorded replay\n", failures ? "FAIL" : "ok", (unsigned)failures,
+        (unsigned)REPLAY_BENCH_SEEDS);
+    return failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include "sfx.h"
+
+#if defined(__SDCC)
+#include <gb/gb.h>
+#include "hUGEDriver.h"
+
+#define SFX_APU_REG(lo) (*(volatile UINT8*)(0xFF00u | (lo)))
+#else
+#define CRITICAL
+#endif
+
+static const UINT8* g_sfx_ptr[SFX_CHANNELS];
+static UINT8 g_sfx_wait[SFX_CHANNELS];
+UINT8 g_sfx_playing[SFX_CHANNELS];
+
+static void sfx_release(UINT8 channel) {
+    g_sfx_ptr[channel] = 0;
+    g_sfx_playing[channel] = SFX_NONE;
+#if defined(__SDCC)
+    if (channel == 2u) {
+        NR30_REG = 0x00;
+        hUGE_current_wave = hUGE_NO_WAVE;
+    } else {
+        SFX_APU_REG(0x12u + (UINT8)(channel * 5u)) = 0x00;
+    }
+    hUGE_mute_channel((enum hUGE_channel_t)channel, HT_CH_PLAY);
+#endif
+}
+
+void sfx_init(void) {
+    for (UINT8 ch = 0; ch < SFX_CHANNELS; ++ch) {
+        g_sfx_ptr[ch] = 0;
+        g_sfx_wait[ch] = 0;
+        g_sfx_playing[ch] = SFX_NONE;
+    }
+}
+
+BOOLEAN sfx_play(UINT8 id) {
+    UINT8 ch = SFX_CHANNEL[id];
+    BOOLEAN started = 0;
+
+    CRITICAL {
+        UINT8 playing = g_sfx_playing[ch];
+        if (playing == SFX_NONE || SFX_PRIORITY[playing] <= SFX_PRIORITY[id]) {
+#if defined(__SDCC)
+            if (playing == SFX_NONE) {
+                hUGE_mute_channel((enum hUGE_channel_t)ch, HT_CH_MUTE);
+            }
+#endif
+            g_sfx_playing[ch] = id;
+            g_sfx_wait[ch] = 0;
+            g_sfx_ptr[ch] = SFX_STREAM[id];
+            started = 1;
+        }
+    }
+    return started;
+}
+
+void sfx_stop(UINT8 channel) {
+    CRITICAL {
+        if (g_sfx_playing[channel] != SFX_NONE) {
+            sfx_release(channel);
+        }
+    }
+}
+
+void sfx_tick(void) {
+    for (UINT8 ch = 0; ch < SFX_CHANNELS; ++ch) {
+        const UINT8* p = g_sfx_ptr[ch];
+        if (!p) {
+            continue;
+        }
+        if (g_sfx_wait[ch]) {
+            --g_sfx_wait[ch];
+            continue;
+        }
+
+        UINT8 header = *p++;
+        if (header == SFX_END) {
+            sfx_release(ch);
+            continue;
+        }
+
+        g_sfx_wait[ch] = header >> SFX_HEADER_WAIT_SHIFT;
+        for (UINT8 n = header & SFX_HEADER_WRITES_MASK; n; --n) {
+#if defined(__SDCC)
+            SFX_APU_REG(p[0]) = p[1];
+#endif
+            p += 2;
+        }
+        g_sfx_ptr[ch] = p;
+    }
+}
+
+#if defined(GAME_SNAPSHOT)
+void sfx_save(UINT8* out) {
+    CRITICAL {
+        for (UINT8 ch = 0; ch < SFX_CHANNELS; ++ch) {
+            UINT8 id = g_sfx_playing[ch];
+            *out++ = id;
+            *out++ = g_sfx_wait[ch];
+            *out++ = (g_sfx_ptr[ch] && id != SFX_NONE) ? (UINT8)(g_sfx_ptr[ch] - SFX_STREAM[id]) : 0u;
+        }
+    }
+}
+
+#ifndef __SDCC
+void sfx_load(const UINT8* in) {
+    for (UINT8 ch = 0; ch < SFX_CHANNELS; ++ch) {
+        UINT8 id = *in++;
+        g_sfx_playing[ch] = id;
+        g_sfx_wait[ch] = *in++;
+        g_sfx_ptr[ch] = (id != SFX_NONE) ? SFX_STREAM[id] + *in : 0;
+        ++in;
+    }
+}
+#endif
+#endif
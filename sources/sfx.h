@@ -0,0 +1,31 @@
+#pragma once
+
+#include "game_types.h"
+#include "sfx_data.h"
+
+#define SFX_CHANNELS 4u
+#define SFX_END 0xFFu
+#define SFX_HEADER_WRITES_MASK 0x07u
+#define SFX_HEADER_WAIT_SHIFT 3
+
+#define SFX_NONE 0xFFu
+
+#define SFX_SAVE_SIZE (SFX_CHANNELS * 3u)
+
+void sfx_init(void);
+
+BOOLEAN sfx_play(UINT8 id);
+
+void sfx_stop(UINT8 channel);
+
+void sfx_tick(void);
+
+extern UINT8 g_sfx_playing[SFX_CHANNELS];
+
+#ifdef GAME_SNAPSHOT
+void sfx_save(UINT8* out);
+#endif
+
+#ifndef __SDCC
+void sfx_load(const UINT8* in);
+#endif
@@ -0,0 +1,28 @@
+#include "sfx_data.h"
+
+const UINT8 SFX_STREAM_LAND[10] = {
+    0x34, 0x20, 0x3A, 0x21, 0x81, 0x22, 0x71, 0x23, 0x80, 0xFF,
+};
+
+const UINT8 SFX_STREAM_JUMP[19] = {
+    0x1D, 0x10, 0x15, 0x11, 0x80, 0x12, 0xA2, 0x13, 0x00, 0x14, 0x86, 0x2B, 0x12, 0x62, 0x13, 0x40,
+    0x14, 0x86, 0xFF,
+};
+
+const UINT8 SFX_STREAM_HIT[13] = {
+    0x14, 0x20, 0x00, 0x21, 0xF3, 0x22, 0x52, 0x23, 0x80, 0x41, 0x22, 0x64, 0xFF,
+};
+
+const UINT8* const SFX_STREAM[SFX_COUNT] = {
+    SFX_STREAM_LAND,
+    SFX_STREAM_JUMP,
+    SFX_STREAM_HIT,
+};
+
+const UINT8 SFX_CHANNEL[3] = {
+    3, 0, 3,
+};
+
+const UINT8 SFX_PRIORITY[3] = {
+    1, 2, 3,
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "game_types.h"
+
+#define SFX_LAND 0
+#define SFX_JUMP 1
+#define SFX_HIT 2
+#define SFX_COUNT 3
+#define SFX_MAX_WRITES_PER_TICK 5
+#define SFX_TICK_WORST_WRITES 9
+
+extern const UINT8* const SFX_STREAM[SFX_COUNT];
+extern const UINT8 SFX_CHANNEL[SFX_COUNT];
+extern const UINT8 SFX_PRIORITY[SFX_COUNT];
@@ -0,0 +1,117 @@
+#include "speed_gov.h"
+
+#if defined(__SDCC)
+#include <gb/gb.h>
+#include <gb/cgb.h>
+
+#include "music.h"
+#include "frame.h"
+#include "phase_prof.h"
+#endif
+
+volatile BOOLEAN g_speed_fast;
+UINT8 g_speed_gov_slack;
+UINT8 g_speed_gov_switches;
+
+static UINT8 g_speed_gov_calm_frames;
+static UINT8 g_speed_gov_lag_seen;
+
+/*
+ * cpu_fast()/cpu_slow() switch through STOP: they clear IF, which drops a
+ * pending music or profiler TIMA tick, and the switch resets DIV and halts the
+ * timer for about SPEED_GOV_SWITCH_M_CYCLES. Pending flags are re-raised here
+ * and the stall is credited back to the phase profiler.
+ */
+static void speed_gov_set(BOOLEAN fast) {
+#if defined(__SDCC)
+    if (_cpu != CGB_TYPE) {
+        return;
+    }
+
+    CRITICAL {
+        UINT8 pending = IF_REG;
+        if (fast) {
+            cpu_fast();
+        } else {
+            cpu_slow();
+        }
+        IF_REG |= pending;
+        music_timer_set_speed(fast);
+    }
+    PHASE_PROF_STALL(SPEED_GOV_SWITCH_M_CYCLES);
+#endif
+    g_speed_fast = fast;
+    g_speed_gov_calm_frames = 0;
+    ++g_speed_gov_switches;
+}
+
+void speed_gov_init(void) {
+#if defined(__SDCC)
+    cpu_slow();
+#endif
+    g_speed_fast = 0;
+    g_speed_gov_slack = 0;
+    g_speed_gov_switches = 0;
+    g_speed_gov_calm_frames = 0;
+    g_speed_gov_lag_seen = 0;
+}
+
+UINT8 speed_gov_wait_vbl(void) {
+#if defined(__SDCC)
+    UINT8 ly = LY_REG;
+    UINT8 div_start = DIV_REG;
+
+    wait_vbl_done();
+
+    UINT8 ticks = (UINT8)(DIV_REG - div_start);
+    if (ly >= SPEED_GOV_LY_VBLANK) {
+        return 0;
+    }
+    if ((UINT8)(SPEED_GOV_LY_VBLANK - ly) > SPEED_GOV_LY_EXACT_LINES) {
+        UINT16 est = SPEED_GOV_LINES_TO_TICKS(SPEED_GOV_LY_VBLANK - ly);
+        return (est > 255u) ? 255u : (UINT8)est;
+    }
+    return SPEED_DIV_NORMALIZE(ticks);
+#else
+    return 255u;
+#endif
+}
+
+void speed_gov_update(UINT8 slack) {
+    BOOLEAN lagged = 0;
+#if defined(__SDCC)
+    lagged = (g_frame_lag_count != g_speed_gov_lag_seen);
+    g_speed_gov_lag_seen = g_frame_lag_count;
+#endif
+    g_speed_gov_slack = slack;
+
+    if (!g_speed_fast) {
+        if (lagged || slack < SPEED_GOV_FAST_BELOW) {
+            speed_gov_set(1);
+        }
+        return;
+    }
+
+    INT16 slow_slack = (INT16)(2 * (INT16)slack - SPEED_GOV_FRAME_TICKS);
+    if (lagged || slow_slack < SPEED_GOV_SLOW_ABOVE) {
+        g_speed_gov_calm_frames = 0;
+        return;
+    }
+    if (++g_speed_gov_calm_frames >= SPEED_GOV_SLOW_FRAMES) {
+        speed_gov_set(0);
+    }
+}
+
+#if defined(GAME_SNAPSHOT)
+void speed_gov_save(UINT8* out) {
+    out[0] = g_speed_fast;
+    out[1] = g_speed_gov_calm_frames;
+}
+
+#ifndef __SDCC
+void speed_gov_load(const UINT8* in) {
+    g_speed_fast = in[0];
+    g_speed_gov_calm_frames = in[1];
+}
+#endif
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "game_types.h"
+
+#ifndef SPEED_GOV_FAST_BELOW
+#define SPEED_GOV_FAST_BELOW 16
+#endif
+
+#ifndef SPEED_GOV_SLOW_ABOVE
+#define SPEED_GOV_SLOW_ABOVE 48
+#endif
+
+#ifndef SPEED_GOV_SLOW_FRAMES
+#define SPEED_GOV_SLOW_FRAMES 90u
+#endif
+
+#define SPEED_GOV_FRAME_TICKS 274
+#define SPEED_GOV_LY_VBLANK 144u
+#define SPEED_GOV_LY_EXACT_LINES 64u
+
+#define SPEED_GOV_SWITCH_M_CYCLES 2050u
+
+#define SPEED_GOV_SAVE_SIZE 2u
+
+#define SPEED_GOV_LINES_TO_TICKS(lines) (((UINT16)(lines) * 57u) >> 5)
+
+extern volatile BOOLEAN g_speed_fast;
+extern UINT8 g_speed_gov_slack;
+extern UINT8 g_speed_gov_switches;
+
+#define SPEED_DIV_NORMALIZE(ticks) (g_speed_fast ? (UINT8)((ticks) >> 1) : (UINT8)(ticks))
+#define SPEED_TICKS_NORMALIZE(ticks) (g_speed_fast ? (UINT16)((ticks) >> 1) : (UINT16)(ticks))
+
+void speed_gov_init(void);
+
+UINT8 speed_gov_wait_vbl(void);
+
+void speed_gov_update(UINT8 slack);
+
+#ifdef GAME_SNAPSHOT
+void speed_gov_save(UINT8* out);
+#endif
+
+#ifndef __SDCC
+void speed_gov_load(const UINT8* in);
+#endif
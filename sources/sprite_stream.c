@@ -0,0 +1,127 @@
+#include "sprite_stream.h"
+
+#include "bank_scope.h"
+
+#if defined(__SDCC)
+#include <gb/gb.h>
+#include <gb/cgb.h>
+#else
+#define CRITICAL
+#endif
+
+static SpriteStream* g_sprite_streams[SPRITE_STREAM_MAX];
+static UINT8 g_sprite_stream_count;
+
+#if defined(__SDCC)
+#define sprite_stream_gdma(data) (_cpu == CGB_TYPE && ((UINT16)(data) & 0x0Fu) == 0)
+#else
+#define sprite_stream_gdma(data) ((void)(data), 1)
+#endif
+
+static void sprite_stream_upload(const SpriteStream* s, UINT8 tile, const UINT8* data, UINT8 count) {
+#if defined(__SDCC)
+    BANK_SCOPE_ENTER(s->asset, s->bank);
+    UINT8 old_vbk = VBK_REG;
+    VBK_REG = VBK_TILES;
+
+    if (sprite_stream_gdma(data)) {
+        UINT16 dst = 0x8000u + ((UINT16)tile << 4);
+        HDMA1_REG = (UINT8)((UINT16)data >> 8);
+        HDMA2_REG = (UINT8)(UINT16)data;
+        HDMA3_REG = (UINT8)(dst >> 8);
+        HDMA4_REG = (UINT8)dst;
+        HDMA5_REG = (UINT8)(count - 1u);
+    } else {
+        set_sprite_data(tile, count, data);
+    }
+
+    VBK_REG = old_vbk;
+    BANK_SCOPE_EXIT();
+#else
+    (void)s;
+    (void)tile;
+    (void)data;
+    (void)count;
+#endif
+}
+
+void sprite_stream_init(SpriteStream* s, UINT8 vram_tile, UINT8 slot_tiles, UINT8 asset, UINT8 bank) {
+    s->shown_data = 0;
+    s->ready_data = 0;
+    s->pending_data = 0;
+    s->pending_count = 0;
+    s->pending_sent = 0;
+    s->bank = bank;
+    s->asset = asset;
+    s->front_tile = vram_tile;
+    s->back_tile = (UINT8)(vram_tile + slot_tiles);
+
+    if (g_sprite_stream_count < SPRITE_STREAM_MAX) {
+        g_sprite_streams[g_sprite_stream_count++] = s;
+    }
+}
+
+void sprite_stream_prime(SpriteStream* s, const UINT8* data, UINT8 count) {
+    sprite_stream_upload(s, s->front_tile, data, count);
+    s->shown_data = data;
+    s->ready_data = 0;
+    s->pending_data = 0;
+}
+
+BOOLEAN sprite_stream_request(SpriteStream* s, const UINT8* data, UINT8 count) {
+    BOOLEAN shown = 1;
+
+    if (data == s->shown_data) {
+        return 1;
+    }
+
+    CRITICAL {
+        if (data == s->ready_data) {
+            UINT8 t = s->front_tile;
+            s->front_tile = s->back_tile;
+            s->back_tile = t;
+            s->shown_data = data;
+            s->ready_data = 0;
+        } else {
+            shown = 0;
+            if (data != s->pending_data) {
+                s->pending_data = data;
+                s->pending_count = count;
+                s->pending_sent = 0;
+            }
+        }
+    }
+    return shown;
+}
+
+UINT8 sprite_stream_vblank(UINT8 budget) {
+    for (UINT8 i = 0; i < g_sprite_stream_count; ++i) {
+        SpriteStream* s = g_sprite_streams[i];
+        if (!s->pending_data) {
+            continue;
+        }
+
+        UINT8 cost = sprite_stream_gdma(s->pending_data) ? SPRITE_STREAM_GDMA_TILE_COST : SPRITE_STREAM_COPY_TILE_COST;
+        UINT8 n = (UINT8)(s->pending_count - s->pending_sent);
+        if ((UINT8)(budget / cost) < n) {
+            n = (UINT8)(budget / cost);
+        }
+        if (n == 0) {
+            continue;
+        }
+        budget -= (UINT8)(n * cost);
+
+        sprite_stream_upload(
+            s,
+            (UINT8)(s->back_tile + s->pending_sent),
+            s->pending_data + (UINT16)s->pending_sent * SPRITE_STREAM_TILE_BYTES,
+            n
+        );
+        s->pending_sent += n;
+        if (s->pending_sent == s->pending_count) {
+            s->ready_data = s->pending_data;
+            s->pending_data = 0;
+        }
+    }
+    return budget;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "game_types.h"
+
+#ifndef SPRITE_STREAM_MAX
+#define SPRITE_STREAM_MAX 4
+#endif
+
+#define SPRITE_STREAM_TILE_BYTES 16u
+
+#ifndef SPRITE_STREAM_GDMA_TILE_COST
+#define SPRITE_STREAM_GDMA_TILE_COST 1u
+#endif
+
+#ifndef SPRITE_STREAM_COPY_TILE_COST
+#define SPRITE_STREAM_COPY_TILE_COST 16u
+#endif
+
+typedef struct SpriteStream {
+    const UINT8* shown_data;
+    const UINT8* ready_data;
+    const UINT8* pending_data;
+    UINT8 pending_count;
+    UINT8 pending_sent;
+    UINT8 bank;
+    UINT8 asset;
+    UINT8 front_tile;
+    UINT8 back_tile;
+} SpriteStream;
+
+void sprite_stream_init(SpriteStream* s, UINT8 vram_tile, UINT8 slot_tiles, UINT8 asset, UINT8 bank);
+
+void sprite_stream_prime(SpriteStream* s, const UINT8* data, UINT8 count);
+
+BOOLEAN sprite_stream_request(SpriteStream* s, const UINT8* data, UINT8 count);
+
+UINT8 sprite_stream_vblank(UINT8 budget);
+
+#define sprite_stream_base_tile(s) ((s)->front_tile)
@@ -0,0 +1,231 @@
+#if defined(TILEMAP_BENCH) && !defined(__SDCC)
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_perf.h"
+#include "host_prof.h"
+#include "host_rand.h"
+#include "map.h"
+
+#if defined(TILEMAP_QUAD)
+#include "tilemap_quad.h"
+#elif defined(TILEMAP_MACRO)
+#include "tilemap_macro.h"
+#else
+#error "TILEMAP_BENCH needs TILEMAP_QUAD or TILEMAP_MACRO"
+#endif
+
+#ifndef TILEMAP_BENCH_MAP_W
+#define TILEMAP_BENCH_MAP_W 256u
+#endif
+#ifndef TILEMAP_BENCH_MAP_H
+#define TILEMAP_BENCH_MAP_H 256u
+#endif
+
+#define TILEMAP_BENCH_POINTS 4096u
+
+#if TILEMAP_BENCH_MAP_W < ROW_WIDTH || TILEMAP_BENCH_MAP_H < COL_HEIGHT || TILEMAP_BENCH_MAP_W > 256 || TILEMAP_BENCH_MAP_H > 256
+#error "TILEMAP_BENCH_MAP_W/H must hold one screen strip and fit the 8-bit cursor coordinates"
+#endif
+
+typedef enum TilemapBenchKind {
+    BENCH_BASELINE = 0,
+    BENCH_SEEK,
+    BENCH_SEEK_RIGHT,
+    BENCH_SEEK_DOWN,
+    BENCH_KIND_COUNT
+} TilemapBenchKind;
+
+typedef struct TilemapBenchResult {
+    uint64_t ns;
+    HostPerfSample perf;
+} TilemapBenchResult;
+
+#if defined(TILEMAP_QUAD)
+typedef TilemapQuadCursor BenchCursor;
+#define BENCH_DECODER "tilemap_quad"
+#else
+typedef TilemapMacroCursor BenchCursor;
+#define BENCH_DECODER "tilemap_macro"
+#endif
+
+static uint32_t g_bench_rng = 0x6C8E9CF5u;
+static uint8_t g_bench_x[TILEMAP_BENCH_POINTS];
+static uint8_t g_bench_y[TILEMAP_BENCH_POINTS];
+static volatile uint16_t g_bench_sink;
+
+static void bench_decoder_init(BenchCursor* c) {
+#if defined(TILEMAP_QUAD)
+    tilemap_quad_init(c);
+#else
+    tilemap_macro_init(c);
+#endif
+}
+
+static uint16_t bench_seek(BenchCursor* c, uint8_t x, uint8_t y) {
+#if defined(TILEMAP_QUAD)
+    tilemap_quad_seek_xy(c, x, y);
+    return c->leaf_x;
+#else
+    return tilemap_macro_seek_xy(c, x, y);
+#endif
+}
+
+static uint16_t bench_next_right(BenchCursor* c) {
+#if defined(TILEMAP_QUAD)
+    uint8_t tile;
+    uint8_t attr;
+    tilemap_quad_next_right(c, &tile, &attr);
+    return (uint16_t)(tile | ((uint16_t)attr << 8));
+#else
+    return tilemap_macro_next_right(c);
+#endif
+}
+
+static uint16_t bench_next_down(BenchCursor* c) {
+#if defined(TILEMAP_QUAD)
+    uint8_t tile;
+    uint8_t attr;
+    tilemap_quad_next_down(c, &tile, &attr);
+    return (uint16_t)(tile | ((uint16_t)attr << 8));
+#else
+    return tilemap_macro_next_down(c);
+#endif
+}
+
+static void bench_points(void) {
+    for (uint32_t i = 0; i < TILEMAP_BENCH_POINTS; i++) {
+        g_bench_x[i] = (uint8_t)(host_rand_next(&g_bench_rng) % (TILEMAP_BENCH_MAP_W - ROW_WIDTH + 1u));
+        g_bench_y[i] = (uint8_t)(host_rand_next(&g_bench_rng) % (TILEMAP_BENCH_MAP_H - COL_HEIGHT + 1u));
+    }
+}
+
+static void bench_run(TilemapBenchKind kind, uint32_t reps, TilemapBenchResult* out) {
+    BenchCursor c;
+    uint16_t acc = 0;
+
+    bench_decoder_init(&c);
+#if defined(TILEMAP_QUAD_INSTRUMENT)
+    tilemap_quad_instr_reset();
+#endif
+#if defined(TILEMAP_MACRO_INSTRUMENT)
+    tilemap_macro_instr_reset();
+#endif
+
+    host_perf_start();
+    uint64_t t0 = host_prof_now_ns();
+    for (uint32_t r = 0; r < reps; r++) {
+        for (uint32_t i = 0; i < TILEMAP_BENCH_POINTS; i++) {
+            uint8_t x = g_bench_x[i];
+            uint8_t y = g_bench_y[i];
+            switch (kind) {
+                case BENCH_BASELINE:
+                    acc ^= (uint16_t)(x | ((uint16_t)y << 8));
+                    break;
+                case BENCH_SEEK:
+                    acc ^= bench_seek(&c, x, y);
+                    break;
+                case BENCH_SEEK_RIGHT:
+                    acc ^= bench_seek(&c, x, y);
+                    for (uint8_t k = 0; k < ROW_WIDTH; k++) {
+                        acc ^= bench_next_right(&c);
+                    }
+                    break;
+                case BENCH_SEEK_DOWN:
+                    acc ^= bench_seek(&c, x, y);
+                    for (uint8_t k = 0; k < COL_HEIGHT; k++) {
+                        acc ^= bench_next_down(&c);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        g_bench_sink = acc;
+    }
+    out->ns = host_prof_now_ns() - t0;
+    host_perf_stop(&out->perf);
+}
+
+static double bench_delta(uint64_t a, uint64_t b, uint64_t calls) {
+    return calls ? ((double)a - (double)b) / (double)calls : 0.0;
+}
+
+static void bench_report(const char* name, const TilemapBenchResult* r, const TilemapBenchResult* base, uint64_t calls) {
+    printf("%-11s %10llu calls %8.2f ns", name, (unsigned long long)calls, bench_delta(r->ns, base->ns, calls));
+    for (uint8_t e = 0; e < HOST_PERF_COUNT; e++) {
+        if (r->perf.valid[e] && base->perf.valid[e]) {
+            printf("  %s %.2f", host_perf_name((HostPerfEvent)e), bench_delta(r->perf.value[e], base->perf.value[e], calls));
+        }
+    }
+    printf("\n");
+}
+
+#if defined(TILEMAP_QUAD_INSTRUMENT)
+static void bench_report_traverse(void) {
+    uint32_t calls = tilemap_quad_instr_traverse_calls();
+    printf("            traverse: %u calls, avg %.2f iters, max %u, hist",
+        (unsigned)calls, calls ? (double)tilemap_quad_instr_traverse_total_iters() / (double)calls : 0.0,
+        (unsigned)tilemap_quad_instr_traverse_max_iters());
+    for (uint8_t i = 0; i <= 8u; i++) {
+        printf(" %u%s:%u", (unsigned)i, (i == 8u) ? "+" : "", (unsigned)tilemap_quad_instr_traverse_hist(i));
+    }
+    printf("\n");
+}
+#else
+#define bench_report_traverse() ((void)0)
+#endif
+
+#if defined(TILEMAP_QUAD_INSTRUMENT) || defined(TILEMAP_MACRO_INSTRUMENT)
+#define bench_report_zones() host_prof_report(stdout)
+#else
+#define bench_report_zones() ((void)0)
+#endif
+
+int main(int argc, char** argv) {
+    uint32_t reps = (argc > 1) ? (uint32_t)strtoul(argv[1], 0, 0) : 200u;
+    if (argc > 2) {
+        g_bench_rng = host_rand_seed((uint32_t)strtoul(argv[2], 0, 0));
+    }
+
+    TilemapBenchResult base;
+    TilemapBenchResult seek;
+    TilemapBenchResult right;
+    TilemapBenchResult down;
+    uint64_t seeks = (uint64_t)reps * TILEMAP_BENCH_POINTS;
+
+    uint8_t counters = host_perf_open();
+    printf("%s: %ux%u tiles, %u points x %u reps, %u/%u perf counters",
+        BENCH_DECODER, (unsigned)TILEMAP_BENCH_MAP_W, (unsigned)TILEMAP_BENCH_MAP_H, (unsigned)TILEMAP_BENCH_POINTS,
+        (unsigned)reps, (unsigned)counters, (unsigned)HOST_PERF_COUNT);
+    if (counters == 0u) {
+        printf(" (perf_event_open unavailable; check kernel.perf_event_paranoid)");
+    }
+    printf("\n");
+#if defined(TILEMAP_QUAD_INSTRUMENT) || defined(TILEMAP_MACRO_INSTRUMENT)
+    printf("note: instrumented build, per-call counts include the profiler\n");
+#endif
+
+    bench_points();
+    bench_run(BENCH_BASELINE, reps, &base);
+    bench_run(BENCH_SEEK, reps, &seek);
+    bench_report("seek", &seek, &base, seeks);
+    bench_report_traverse();
+    bench_report_zones();
+
+    bench_run(BENCH_SEEK_RIGHT, reps, &right);
+    bench_report("next_right", &right, &seek, seeks * ROW_WIDTH);
+    bench_report_traverse();
+    bench_report_zones();
+
+    bench_run(BENCH_SEEK_DOWN, reps, &down);
+    bench_report("next_down", &down, &seek, seeks * COL_HEIGHT);
+    bench_report_traverse();
+    bench_report_zones();
+
+    host_perf_close();
+    return 0;
+}
+
+#endif
@@ -13,7 +13,48 @@ static uint8_t prof_div_delta(uint8_t start, uint8_t end) {
 }
 #endif
 
+#if defined(TILEMAP_COMP_INSTRUMENT) && !defined(__SDCC)
+#include "host_prof.h"
+
+enum {
+    INSTR_TREE_GET = 0,
+    INSTR_RUN_LEN = 1,
+    INSTR_SET_RUN_FOR_GROUP = 2,
+    INSTR_CURSOR_SEEK = 3,
+    INSTR_CURSOR_NEXT = 4,
+    INSTR_COUNT = 5,
+};
+
+static HostProfZone g_zones[INSTR_COUNT] = {
+    HOST_PROF_ZONE_INIT("tilemap_comp_tree_get"),
+    HOST_PROF_ZONE_INIT("tilemap_comp_run_len"),
+    HOST_PROF_ZONE_INIT("tilemap_comp_set_run_for_group"),
+    HOST_PROF_ZONE_INIT("tilemap_comp_cursor_seek"),
+    HOST_PROF_ZONE_INIT("tilemap_comp_cursor_next"),
+};
+
+void tilemap_comp_instr_reset(void) {
+    host_prof_init();
+    host_prof_zones_reset(g_zones, (uint8_t)INSTR_COUNT);
+}
+
+const HostProfZone* tilemap_comp_instr_zones(uint8_t* count) {
+    *count = (uint8_t)INSTR_COUNT;
+    return g_zones;
+}
+
+#define INSTR_ENTER(id) host_prof_enter(&g_zones[(id)])
+#define INSTR_EXIT(id) host_prof_exit(&g_zones[(id)])
+
+#else
+
+#define INSTR_ENTER(id) ((void)0)
+#define INSTR_EXIT(id) ((void)0)
+
+#endif
+
 static uint16_t tilemap_comp_tree_get(uint8_t level, uint16_t pos) {
+    INSTR_ENTER(INSTR_TREE_GET);
 #ifdef TILEMAP_COMP_PROFILE
     uint8_t prof_start = DIV_REG;
 #endif
@@ -32,10 +73,12 @@ static uint16_t tilemap_comp_tree_get(uint8_t level, uint16_t pos) {
 #ifdef TILEMAP_COMP_PROFILE
     tilemap_prof_tree_get_div_total = (uint32_t)(tilemap_prof_tree_get_div_total + prof_div_delta(prof_start, DIV_REG));
 #endif
+    INSTR_EXIT(INSTR_TREE_GET);
     return out;
 }
 
 static uint8_t tilemap_comp_run_len(uint16_t run) {
+    INSTR_ENTER(INSTR_RUN_LEN);
 #ifdef TILEMAP_COMP_PROFILE
     uint8_t prof_start = DIV_REG;
 #endif
@@ -46,11 +89,12 @@ static uint8_t tilemap_comp_run_len(uint16_t run) {
 #ifdef TILEMAP_COMP_PROFILE
     tilemap_prof_run_len_div_total = (uint32_t)(tilemap_prof_run_len_div_total + prof_div_delta(prof_start, DIV_REG));
 #endif
+    INSTR_EXIT(INSTR_RUN_LEN);
     return out;
 }
 
 static void tilemap_comp_set_run_for_group(TilemapCompCursor* c, uint16_t group_index) {
-
+    INSTR_ENTER(INSTR_SET_RUN_FOR_GROUP);
     uint16_t idx = group_index;
     uint16_t pos = 0;
     for (uint8_t level = 0; level < (uint8_t)(TILEMAP_RLE_TREE_DEPTH - 1u); level++) {
@@ -75,9 +119,11 @@ static void tilemap_comp_set_run_for_group(TilemapCompCursor* c, uint16_t group_
     c->run_len = (c->run < TILEMAP_RLE_RUN_COUNT) ? tilemap_comp_run_len(c->run) : 0u;
     c->group_in_run = (uint8_t)idx;
     c->run_start_group_index = (uint16_t)(group_index - (uint16_t)c->group_in_run);
+    INSTR_EXIT(INSTR_SET_RUN_FOR_GROUP);
 }
 
 void tilemap_comp_cursor_seek(TilemapCompCursor* c, uint16_t tile_index) {
+    INSTR_ENTER(INSTR_CURSOR_SEEK);
 #ifdef TILEMAP_COMP_PROFILE
     uint8_t prof_start = DIV_REG;
 #endif
@@ -96,6 +142,7 @@ void tilemap_comp_cursor_seek(TilemapCompCursor* c, uint16_t tile_index) {
 #ifdef TILEMAP_COMP_PROFILE
         tilemap_prof_cursor_seek_div_total = (uint32_t)(tilemap_prof_cursor_seek_div_total + prof_div_delta(prof_start, DIV_REG));
 #endif
+        INSTR_EXIT(INSTR_CURSOR_SEEK);
         return;
     }
 
@@ -111,12 +158,16 @@ void tilemap_comp_cursor_seek(TilemapCompCursor* c, uint16_t tile_index) {
 #ifdef TILEMAP_COMP_PROFILE
     tilemap_prof_cursor_seek_div_total = (uint32_t)(tilemap_prof_cursor_seek_div_total + prof_div_delta(prof_start, DIV_REG));
 #endif
+    INSTR_EXIT(INSTR_CURSOR_SEEK);
 }
 
 uint8_t tilemap_comp_cursor_next(TilemapCompCursor* c) {
+    INSTR_ENTER(INSTR_CURSOR_NEXT);
 
-    if (c->tile_index >= TILEMAP_TILE_COUNT) return 0;
-    if (c->run >= TILEMAP_RLE_RUN_COUNT) return 0;
+    if (c->tile_index >= TILEMAP_TILE_COUNT || c->run >= TILEMAP_RLE_RUN_COUNT) {
+        INSTR_EXIT(INSTR_CURSOR_NEXT);
+        return 0;
+    }
 
     uint16_t base = (uint16_t)(c->run * TILEMAP_GROUP_SIZE);
     uint8_t out = TILEMAP_RLE_GROUPS[(uint16_t)(base + c->group_offset)];
@@ -133,6 +184,7 @@ uint8_t tilemap_comp_cursor_next(TilemapCompCursor* c) {
         c->run_len = 0;
         c->group_in_run = 0;
         c->group_offset = 0;
+        INSTR_EXIT(INSTR_CURSOR_NEXT);
         return out;
     }
 
@@ -155,5 +207,6 @@ uint8_t tilemap_comp_cursor_next(TilemapCompCursor* c) {
         c->group_offset = new_group_offset;
     }
 
+    INSTR_EXIT(INSTR_CURSOR_NEXT);
     return out;
 }
@@ -24,4 +24,12 @@ void tilemap_comp_cursor_seek(TilemapCompCursor* c, uint16_t tile_index);
 
 uint8_t tilemap_comp_cursor_next(TilemapCompCursor* c);
 
+#if defined(TILEMAP_COMP_INSTRUMENT) && !defined(__SDCC)
+#include "host_prof.h"
+
+void tilemap_comp_instr_reset(void);
+const HostProfZone* tilemap_comp_instr_zones(uint8_t* count);
+
+#endif
+
 #endif
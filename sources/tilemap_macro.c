@@ -2,15 +2,17 @@
 
 #ifdef TILEMAP_MACRO
 
-#if defined(TILEMAP_MACRO_INSTRUMENT) && !defined(__SDCC)
-#include <sys/time.h>
+#if !defined(TILEMAP_MACRO_HRAM) || defined(TILEMAP_MACRO_VERIFY)
 
-static uint64_t now_ns(void) {
+#ifdef TILEMAP_MACRO_HRAM
+#define tilemap_macro_init tilemap_macro_ref_init
+#define tilemap_macro_seek_xy tilemap_macro_ref_seek_xy
+#define tilemap_macro_next_right tilemap_macro_ref_next_right
+#define tilemap_macro_next_down tilemap_macro_ref_next_down
+#endif
 
-    struct timeval tv;
-    gettimeofday(&tv, 0);
-    return ((uint64_t)tv.tv_sec * 1000000000ull) + ((uint64_t)tv.tv_usec * 1000ull);
-}
+#if defined(TILEMAP_MACRO_INSTRUMENT) && !defined(__SDCC)
+#include "host_prof.h"
 
 enum {
     INSTR_MACROTILE_PTR_FOR = 0,
@@ -21,110 +23,26 @@ enum {
     INSTR_COUNT = 5,
 };
 
-static uint32_t g_calls[INSTR_COUNT];
-static uint64_t g_total_ns[INSTR_COUNT];
-static uint64_t g_excl_ns[INSTR_COUNT];
-
-static uint8_t g_stack[16];
-static uint64_t g_stack_t0[16];
-static uint8_t g_sp;
-
-static void instr_enter(uint8_t id) {
-    uint64_t t = now_ns();
-    if (g_sp < (uint8_t)(sizeof(g_stack) / sizeof(g_stack[0]))) {
-        g_stack[g_sp] = id;
-        g_stack_t0[g_sp] = t;
-        g_sp++;
-    }
-}
-
-static void instr_exit(uint8_t id) {
-    uint64_t t1 = now_ns();
-    if (g_sp == 0u) {
-        return;
-    }
-    g_sp--;
-
-    uint64_t t0 = g_stack_t0[g_sp];
-    uint64_t dt = (t1 >= t0) ? (t1 - t0) : 0ull;
-
-    g_calls[id]++;
-    g_total_ns[id] += dt;
-    g_excl_ns[id] += dt;
-
-    if (g_sp > 0u) {
-        uint8_t parent = g_stack[g_sp - 1u];
-        g_excl_ns[parent] -= dt;
-    }
-}
+static HostProfZone g_zones[INSTR_COUNT] = {
+    HOST_PROF_ZONE_INIT("macrotile_ptr_for"),
+    HOST_PROF_ZONE_INIT("tilemap_macro_init"),
+    HOST_PROF_ZONE_INIT("tilemap_macro_seek_xy"),
+    HOST_PROF_ZONE_INIT("tilemap_macro_next_right"),
+    HOST_PROF_ZONE_INIT("tilemap_macro_next_down"),
+};
 
 void tilemap_macro_instr_reset(void) {
-    for (uint8_t i = 0; i < (uint8_t)INSTR_COUNT; ++i) {
-        g_calls[i] = 0u;
-        g_total_ns[i] = 0ull;
-        g_excl_ns[i] = 0ull;
-    }
-    g_sp = 0u;
-}
-
-uint8_t tilemap_macro_instr_func_count(void) {
-    return (uint8_t)INSTR_COUNT;
-}
-
-uint32_t tilemap_macro_instr_call_count(uint8_t func_id) {
-    if (func_id >= (uint8_t)INSTR_COUNT) return 0u;
-    return g_calls[func_id];
-}
-
-uint64_t tilemap_macro_instr_total_ns(uint8_t func_id) {
-    if (func_id >= (uint8_t)INSTR_COUNT) return 0ull;
-    return g_total_ns[func_id];
-}
-
-uint64_t tilemap_macro_instr_excl_ns(uint8_t func_id) {
-    if (func_id >= (uint8_t)INSTR_COUNT) return 0ull;
-    return g_excl_ns[func_id];
-}
-
-const char* tilemap_macro_instr_func_name(uint8_t func_id) {
-    switch (func_id) {
-        case INSTR_MACROTILE_PTR_FOR:
-            return "macrotile_ptr_for";
-        case INSTR_INIT:
-            return "tilemap_macro_init";
-        case INSTR_SEEK_XY:
-            return "tilemap_macro_seek_xy";
-        case INSTR_NEXT_RIGHT:
-            return "tilemap_macro_next_right";
-        case INSTR_NEXT_DOWN:
-            return "tilemap_macro_next_down";
-        default:
-            return "?";
-    }
+    host_prof_init();
+    host_prof_zones_reset(g_zones, (uint8_t)INSTR_COUNT);
 }
 
-#define INSTR_ENTER(id) instr_enter((id))
-#define INSTR_EXIT(id) instr_exit((id))
-
-#elif defined(TILEMAP_MACRO_INSTRUMENT)
-
-void tilemap_macro_instr_reset(void) {}
-uint8_t tilemap_macro_instr_func_count(void) { return 0u; }
-uint32_t tilemap_macro_instr_call_count(uint8_t func_id) {
-    (void)func_id;
-    return 0u;
-}
-uint64_t tilemap_macro_instr_total_ns(uint8_t func_id) {
-    (void)func_id;
-    return 0ull;
-}
-uint64_t tilemap_macro_instr_excl_ns(uint8_t func_id) {
-    (void)func_id;
-    return 0ull;
+const HostProfZone* tilemap_macro_instr_zones(uint8_t* count) {
+    *count = (uint8_t)INSTR_COUNT;
+    return g_zones;
 }
 
-#define INSTR_ENTER(id) ((void)0)
-#define INSTR_EXIT(id) ((void)0)
+#define INSTR_ENTER(id) host_prof_enter(&g_zones[(id)])
+#define INSTR_EXIT(id) host_prof_exit(&g_zones[(id)])
 
 #else
 
@@ -219,3 +137,5 @@ uint16_t tilemap_macro_next_down(TilemapMacroCursor* c) {
 }
 
 #endif
+
+#endif
@@ -28,18 +28,28 @@ uint16_t tilemap_macro_next_right(TilemapMacroCursor* c);
 
 uint16_t tilemap_macro_next_down(TilemapMacroCursor* c);
 
-#if defined(TILEMAP_MACRO_INSTRUMENT)
+#ifdef TILEMAP_MACRO_HRAM
 
-void tilemap_macro_instr_reset(void);
-uint8_t tilemap_macro_instr_func_count(void);
-uint32_t tilemap_macro_instr_call_count(uint8_t func_id);
-uint64_t tilemap_macro_instr_total_ns(uint8_t func_id);
-uint64_t tilemap_macro_instr_excl_ns(uint8_t func_id);
+extern TilemapMacroCursor tilemap_macro_hram_cursor;
+extern uint8_t tilemap_macro_hram_width;
+
+#ifdef TILEMAP_MACRO_VERIFY
+void tilemap_macro_ref_init(TilemapMacroCursor* c);
+uint16_t tilemap_macro_ref_seek_xy(TilemapMacroCursor* c, uint8_t x, uint8_t y);
+uint16_t tilemap_macro_ref_next_right(TilemapMacroCursor* c);
+uint16_t tilemap_macro_ref_next_down(TilemapMacroCursor* c);
+
+uint16_t tilemap_macro_verify(void);
+#endif
 
-#ifndef __SDCC
-const char* tilemap_macro_instr_func_name(uint8_t func_id);
 #endif
 
+#if defined(TILEMAP_MACRO_INSTRUMENT) && !defined(__SDCC)
+#include "host_prof.h"
+
+void tilemap_macro_instr_reset(void);
+const HostProfZone* tilemap_macro_instr_zones(uint8_t* count);
+
 #endif
 
 #endif
@@ -0,0 +1,152 @@
+#include "tilemap_macro.h"
+
+#if defined(TILEMAP_MACRO) && defined(TILEMAP_MACRO_HRAM)
+
+#include "bank_scope.h"
+
+#if TILEMAP_MACRO_GROUP_SIDE != 3
+#error "tilemap_macro_hram.s steps 3x3 macrotiles; TILEMAP_MACRO_GROUP_SIDE must be 3"
+#endif
+
+#if TILEMAP_MACRO_WIDTH > 255
+#error "tilemap_macro_hram.s keeps the macrotile row stride in one byte; TILEMAP_MACRO_WIDTH must be <= 255"
+#endif
+
+#ifndef __SDCC
+
+TilemapMacroCursor tilemap_macro_hram_cursor;
+uint8_t tilemap_macro_hram_width;
+
+static uint16_t macrotile_base_for_id(uint8_t id) {
+    return (uint16_t)(((uint16_t)id << 3) + (uint16_t)id);
+}
+
+uint16_t tilemap_macro_next_right(TilemapMacroCursor* c) {
+    (void)c;
+
+    if ((uint8_t)(tilemap_macro_hram_cursor.ox + 1u) >= TILEMAP_MACRO_GROUP_SIDE) {
+        tilemap_macro_hram_cursor.ox = 0;
+        tilemap_macro_hram_cursor.mx++;
+
+        tilemap_macro_hram_cursor.cell = (uint8_t)((tilemap_macro_hram_cursor.oy << 1) + tilemap_macro_hram_cursor.oy);
+        tilemap_macro_hram_cursor.macro_id_ptr++;
+        tilemap_macro_hram_cursor.macro_base = macrotile_base_for_id(*tilemap_macro_hram_cursor.macro_id_ptr);
+    } else {
+        tilemap_macro_hram_cursor.ox++;
+        tilemap_macro_hram_cursor.cell++;
+    }
+
+    return (uint16_t)(tilemap_macro_hram_cursor.macro_base + (uint16_t)tilemap_macro_hram_cursor.cell);
+}
+
+uint16_t tilemap_macro_next_down(TilemapMacroCursor* c) {
+    (void)c;
+
+    if ((uint8_t)(tilemap_macro_hram_cursor.oy + 1u) >= TILEMAP_MACRO_GROUP_SIDE) {
+        tilemap_macro_hram_cursor.oy = 0;
+        tilemap_macro_hram_cursor.my++;
+
+        tilemap_macro_hram_cursor.cell = tilemap_macro_hram_cursor.ox;
+        tilemap_macro_hram_cursor.macro_id_ptr = &tilemap_macro_hram_cursor.macro_id_ptr[tilemap_macro_hram_width];
+        tilemap_macro_hram_cursor.macro_base = macrotile_base_for_id(*tilemap_macro_hram_cursor.macro_id_ptr);
+    } else {
+        tilemap_macro_hram_cursor.oy++;
+        tilemap_macro_hram_cursor.cell = (uint8_t)(tilemap_macro_hram_cursor.cell + 3u);
+    }
+
+    return (uint16_t)(tilemap_macro_hram_cursor.macro_base + (uint16_t)tilemap_macro_hram_cursor.cell);
+}
+
+#endif
+
+void tilemap_macro_init(TilemapMacroCursor* c) {
+    (void)c;
+    tilemap_macro_hram_width = (uint8_t)TILEMAP_MACRO_WIDTH;
+    tilemap_macro_hram_cursor.mx = 0;
+    tilemap_macro_hram_cursor.my = 0;
+    tilemap_macro_hram_cursor.ox = 0;
+    tilemap_macro_hram_cursor.oy = 0;
+    tilemap_macro_hram_cursor.cell = 0;
+    tilemap_macro_hram_cursor.macro_id_ptr = TILEMAP_MACRO_ID_MAP;
+    tilemap_macro_hram_cursor.macro_base = 0;
+}
+
+uint16_t tilemap_macro_seek_xy(TilemapMacroCursor* c, uint8_t x, uint8_t y) {
+    (void)c;
+
+    uint8_t mx = TILEMAP_MACRO_X_TO_MX[x];
+    uint8_t ox = TILEMAP_MACRO_X_TO_OX[x];
+    uint8_t my = TILEMAP_MACRO_Y_TO_MY[y];
+    uint8_t oy = TILEMAP_MACRO_Y_TO_OY[y];
+    uint8_t cell = (uint8_t)((uint8_t)((oy << 1) + oy) + ox);
+
+    const uint8_t* macro_id_ptr = &TILEMAP_MACRO_ID_MAP[(uint16_t)TILEMAP_MACRO_MY_TO_ROW_OFF[my] + (uint16_t)mx];
+    uint8_t id = *macro_id_ptr;
+    uint16_t macro_base = (uint16_t)(((uint16_t)id << 3) + (uint16_t)id);
+
+    tilemap_macro_hram_cursor.mx = mx;
+    tilemap_macro_hram_cursor.my = my;
+    tilemap_macro_hram_cursor.ox = ox;
+    tilemap_macro_hram_cursor.oy = oy;
+    tilemap_macro_hram_cursor.cell = cell;
+    tilemap_macro_hram_cursor.macro_id_ptr = macro_id_ptr;
+    tilemap_macro_hram_cursor.macro_base = macro_base;
+
+    return (uint16_t)(macro_base + (uint16_t)cell);
+}
+
+#ifdef TILEMAP_MACRO_VERIFY
+
+#define TILEMAP_MACRO_VERIFY_W ((uint16_t)TILEMAP_MACRO_WIDTH * TILEMAP_MACRO_GROUP_SIDE)
+#define TILEMAP_MACRO_VERIFY_H ((uint16_t)TILEMAP_MACRO_HEIGHT * TILEMAP_MACRO_GROUP_SIDE)
+
+uint16_t tilemap_macro_verify(void) {
+    TilemapMacroCursor ref;
+    TilemapMacroCursor hram;
+    uint16_t mismatches = 0;
+    uint16_t x;
+    uint16_t y;
+
+    BANK_SCOPE_ENTER(BANK_ASSET_TILEMAP, TILEMAP_MACRO_DATA_BANK);
+
+    tilemap_macro_ref_init(&ref);
+    tilemap_macro_init(&hram);
+
+    for (y = 0; y < TILEMAP_MACRO_VERIFY_H; ++y) {
+        for (x = 0; x < TILEMAP_MACRO_VERIFY_W; ++x) {
+            if (tilemap_macro_ref_seek_xy(&ref, (uint8_t)x, (uint8_t)y) != tilemap_macro_seek_xy(&hram, (uint8_t)x, (uint8_t)y)) {
+                mismatches++;
+            }
+        }
+    }
+
+    for (y = 0; y < TILEMAP_MACRO_VERIFY_H; ++y) {
+        if (tilemap_macro_ref_seek_xy(&ref, 0, (uint8_t)y) != tilemap_macro_seek_xy(&hram, 0, (uint8_t)y)) {
+            mismatches++;
+        }
+        for (x = 1; x < TILEMAP_MACRO_VERIFY_W; ++x) {
+            if (tilemap_macro_ref_next_right(&ref) != tilemap_macro_next_right(&hram)) {
+                mismatches++;
+            }
+        }
+    }
+
+    for (x = 0; x < TILEMAP_MACRO_VERIFY_W; ++x) {
+        if (tilemap_macro_ref_seek_xy(&ref, (uint8_t)x, 0) != tilemap_macro_seek_xy(&hram, (uint8_t)x, 0)) {
+            mismatches++;
+        }
+        for (y = 1; y < TILEMAP_MACRO_VERIFY_H; ++y) {
+            if (tilemap_macro_ref_next_down(&ref) != tilemap_macro_next_down(&hram)) {
+                mismatches++;
+            }
+        }
+    }
+
+    BANK_SCOPE_EXIT();
+
+    return mismatches;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,123 @@
+        .module tilemap_macro_hram
+
+        .globl  _tilemap_macro_hram_cursor
+        .globl  _tilemap_macro_hram_width
+        .globl  _tilemap_macro_next_right
+        .globl  _tilemap_macro_next_down
+
+;; The step routines hardcode the 3x3 macrotile layout (x9 base, +3 per
+;; row) and keep the map width in one byte; tilemap_macro_hram.c refuses to
+;; build against data that breaks either assumption.
+;;
+;; crt0 places _HRAM absolutely: the OAM DMA routine at 0xFF80 and
+;; __current_bank / __vbl_done at 0xFF90. The cursor sits at the top of
+;; HRAM, clear of both; check the .map for _tilemap_macro_hram_cursor =
+;; 0xFFF0 when the crt0 layout changes.
+;;
+;; This file is checked against the C reference only on target, by the
+;; TILEMAP_MACRO_VERIFY build; the host suite runs the C model in
+;; tilemap_macro_hram.c.
+
+        TM_GROUP_SIDE = 3
+        TM_HRAM_CURSOR = 0xFFF0
+
+        .area   _HRAM (ABS)
+        .org    TM_HRAM_CURSOR
+
+_tilemap_macro_hram_cursor::
+        .ds     9
+_tilemap_macro_hram_width::
+        .ds     1
+
+        TM_MX   = _tilemap_macro_hram_cursor + 0
+        TM_MY   = _tilemap_macro_hram_cursor + 1
+        TM_OX   = _tilemap_macro_hram_cursor + 2
+        TM_OY   = _tilemap_macro_hram_cursor + 3
+        TM_CELL = _tilemap_macro_hram_cursor + 4
+        TM_PTR  = _tilemap_macro_hram_cursor + 5
+        TM_BASE = _tilemap_macro_hram_cursor + 7
+
+        .area   _CODE
+
+_tilemap_macro_next_right::
+        ldh     a, (TM_OX)
+        inc     a
+        cp      #TM_GROUP_SIDE
+        jr      nc, 1$
+        ldh     (TM_OX), a
+        ldh     a, (TM_CELL)
+        inc     a
+        ldh     (TM_CELL), a
+        jr      tm_hram_index
+1$:
+        xor     a
+        ldh     (TM_OX), a
+        ldh     a, (TM_MX)
+        inc     a
+        ldh     (TM_MX), a
+        ldh     a, (TM_PTR)
+        ld      l, a
+        ldh     a, (TM_PTR + 1)
+        ld      h, a
+        inc     hl
+        ldh     a, (TM_OY)
+        ld      c, a
+        add     a, a
+        add     a, c
+        jr      tm_hram_load_macro
+
+_tilemap_macro_next_down::
+        ldh     a, (TM_OY)
+        inc     a
+        cp      #TM_GROUP_SIDE
+        jr      nc, 2$
+        ldh     (TM_OY), a
+        ldh     a, (TM_CELL)
+        add     a, #TM_GROUP_SIDE
+        ldh     (TM_CELL), a
+        jr      tm_hram_index
+2$:
+        xor     a
+        ldh     (TM_OY), a
+        ldh     a, (TM_MY)
+        inc     a
+        ldh     (TM_MY), a
+        ldh     a, (TM_PTR)
+        ld      l, a
+        ldh     a, (TM_PTR + 1)
+        ld      h, a
+        ldh     a, (_tilemap_macro_hram_width)
+        ld      e, a
+        ld      d, #0
+        add     hl, de
+        ldh     a, (TM_OX)
+
+tm_hram_load_macro:
+        ldh     (TM_CELL), a
+        ld      a, l
+        ldh     (TM_PTR), a
+        ld      a, h
+        ldh     (TM_PTR + 1), a
+        ld      l, (hl)
+        ld      h, #0
+        ld      e, l
+        ld      d, h
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        add     hl, de
+        ld      a, l
+        ldh     (TM_BASE), a
+        ld      a, h
+        ldh     (TM_BASE + 1), a
+        ldh     a, (TM_CELL)
+
+tm_hram_index:
+        ld      c, a
+        ldh     a, (TM_BASE)
+        add     a, c
+        ld      c, a
+        ldh     a, (TM_BASE + 1)
+        adc     a, #0
+        ld      b, a
+        ret
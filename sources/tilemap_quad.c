@@ -4,7 +4,9 @@
 
 #include "tilemap_quad_data.h"
 
-#if defined(TILEMAP_QUAD_INSTRUMENT)
+#if defined(TILEMAP_QUAD_INSTRUMENT) && !defined(__SDCC)
+
+#include "host_prof.h"
 
 typedef enum TilemapQuadInstrFuncId {
     TQI_msb_index_u8 = 0,
@@ -23,28 +25,20 @@ typedef enum TilemapQuadInstrFuncId {
     TQI_FUNC_COUNT
 } TilemapQuadInstrFuncId;
 
-#if defined(__SDCC)
-
-void tilemap_quad_instr_reset(void) { }
-uint8_t tilemap_quad_instr_func_count(void) { return (uint8_t)TQI_FUNC_COUNT; }
-uint32_t tilemap_quad_instr_call_count(uint8_t func_id) { (void)func_id; return 0u; }
-uint64_t tilemap_quad_instr_total_ns(uint8_t func_id) { (void)func_id; return 0ull; }
-uint64_t tilemap_quad_instr_excl_ns(uint8_t func_id) { (void)func_id; return 0ull; }
-uint32_t tilemap_quad_instr_traverse_calls(void) { return 0u; }
-uint32_t tilemap_quad_instr_traverse_total_iters(void) { return 0u; }
-uint8_t tilemap_quad_instr_traverse_max_iters(void) { return 0u; }
-uint32_t tilemap_quad_instr_traverse_hist(uint8_t iters) { (void)iters; return 0u; }
-
-#define TQI_BEGIN(_id) do { (void)(_id); } while (0)
-#define TQI_END(_id) do { (void)(_id); } while (0)
-
-#else
-
-#include <sys/time.h>
-
-static uint32_t g_tqi_calls[TQI_FUNC_COUNT];
-static uint64_t g_tqi_total_ns[TQI_FUNC_COUNT];
-static uint64_t g_tqi_excl_ns[TQI_FUNC_COUNT];
+static HostProfZone g_tqi_zones[TQI_FUNC_COUNT] = {
+    HOST_PROF_ZONE_INIT("msb_index_u8"),
+    HOST_PROF_ZONE_INIT("ensure_cached"),
+    HOST_PROF_ZONE_INIT("csm_cache_check"),
+    HOST_PROF_ZONE_INIT("csm_finger_seek"),
+    HOST_PROF_ZONE_INIT("csm_start_node"),
+    HOST_PROF_ZONE_INIT("csm_traverse"),
+    HOST_PROF_ZONE_INIT("csm_leaf_setup"),
+    HOST_PROF_ZONE_INIT("csm_leafk_setup"),
+    HOST_PROF_ZONE_INIT("tilemap_quad_init"),
+    HOST_PROF_ZONE_INIT("tilemap_quad_seek_xy_idx"),
+    HOST_PROF_ZONE_INIT("tilemap_quad_next_right"),
+    HOST_PROF_ZONE_INIT("tilemap_quad_next_down"),
+};
 
 static uint32_t g_tqi_traverse_calls;
 static uint32_t g_tqi_traverse_total_iters;
@@ -52,81 +46,18 @@ static uint8_t g_tqi_traverse_max_iters;
 
 static uint32_t g_tqi_traverse_hist[9];
 
-#ifndef TILEMAP_QUAD_INSTR_STACK_MAX
-#define TILEMAP_QUAD_INSTR_STACK_MAX 32
-#endif
-
-static uint8_t g_tqi_stack_ids[TILEMAP_QUAD_INSTR_STACK_MAX];
-static uint64_t g_tqi_stack_start_ns[TILEMAP_QUAD_INSTR_STACK_MAX];
-static uint64_t g_tqi_stack_child_ns[TILEMAP_QUAD_INSTR_STACK_MAX];
-static uint8_t g_tqi_sp;
-
-static uint64_t tqi_now_ns(void) {
-    struct timeval tv;
-    gettimeofday(&tv, 0);
-    return ((uint64_t)tv.tv_sec * 1000000000ull) + ((uint64_t)tv.tv_usec * 1000ull);
-}
-
-static void tilemap_quad_instr_enter(uint8_t func_id) {
-    if (g_tqi_sp >= (uint8_t)TILEMAP_QUAD_INSTR_STACK_MAX) return;
-    g_tqi_stack_ids[g_tqi_sp] = func_id;
-    g_tqi_stack_start_ns[g_tqi_sp] = tqi_now_ns();
-    g_tqi_stack_child_ns[g_tqi_sp] = 0ull;
-    g_tqi_sp++;
-}
-
-static void tilemap_quad_instr_exit(uint8_t func_id) {
-    if (g_tqi_sp == 0u) return;
-    g_tqi_sp--;
-
-    uint8_t popped_id = g_tqi_stack_ids[g_tqi_sp];
-    uint64_t start_ns = g_tqi_stack_start_ns[g_tqi_sp];
-    uint64_t child_ns = g_tqi_stack_child_ns[g_tqi_sp];
-    uint64_t end_ns = tqi_now_ns();
-    uint64_t delta = (end_ns >= start_ns) ? (end_ns - start_ns) : 0ull;
-    uint64_t excl = (delta >= child_ns) ? (delta - child_ns) : 0ull;
-
-    if (popped_id < (uint8_t)TQI_FUNC_COUNT) {
-        g_tqi_calls[popped_id]++;
-        g_tqi_total_ns[popped_id] += delta;
-        g_tqi_excl_ns[popped_id] += excl;
-    }
-
-    if (g_tqi_sp != 0u) {
-        uint8_t parent_sp = (uint8_t)(g_tqi_sp - 1u);
-        g_tqi_stack_child_ns[parent_sp] += delta;
-    }
-
-    (void)func_id;
-}
-
 void tilemap_quad_instr_reset(void) {
-    for (uint8_t i = 0; i < (uint8_t)TQI_FUNC_COUNT; i++) {
-        g_tqi_calls[i] = 0u;
-        g_tqi_total_ns[i] = 0ull;
-        g_tqi_excl_ns[i] = 0ull;
-    }
+    host_prof_init();
+    host_prof_zones_reset(g_tqi_zones, (uint8_t)TQI_FUNC_COUNT);
     g_tqi_traverse_calls = 0u;
     g_tqi_traverse_total_iters = 0u;
     g_tqi_traverse_max_iters = 0u;
     for (uint8_t i = 0; i < (uint8_t)9; i++) g_tqi_traverse_hist[i] = 0u;
-    g_tqi_sp = 0u;
-}
-
-uint8_t tilemap_quad_instr_func_count(void) {
-    return (uint8_t)TQI_FUNC_COUNT;
-}
-
-uint32_t tilemap_quad_instr_call_count(uint8_t func_id) {
-    return (func_id < (uint8_t)TQI_FUNC_COUNT) ? g_tqi_calls[func_id] : 0u;
-}
-
-uint64_t tilemap_quad_instr_total_ns(uint8_t func_id) {
-    return (func_id < (uint8_t)TQI_FUNC_COUNT) ? g_tqi_total_ns[func_id] : 0ull;
 }
 
-uint64_t tilemap_quad_instr_excl_ns(uint8_t func_id) {
-    return (func_id < (uint8_t)TQI_FUNC_COUNT) ? g_tqi_excl_ns[func_id] : 0ull;
+const HostProfZone* tilemap_quad_instr_zones(uint8_t* count) {
+    *count = (uint8_t)TQI_FUNC_COUNT;
+    return g_tqi_zones;
 }
 
 uint32_t tilemap_quad_instr_traverse_calls(void) {
@@ -154,30 +85,10 @@ static void tqi_record_traverse_iters(uint8_t iters) {
     g_tqi_traverse_hist[iters]++;
 }
 
-const char* tilemap_quad_instr_func_name(uint8_t func_id) {
-    static const char* const names[TQI_FUNC_COUNT] = {
-        "msb_index_u8",
-        "ensure_cached",
-        "csm_cache_check",
-        "csm_finger_seek",
-        "csm_start_node",
-        "csm_traverse",
-        "csm_leaf_setup",
-        "csm_leafk_setup",
-        "tilemap_quad_init",
-        "tilemap_quad_seek_xy_idx",
-        "tilemap_quad_next_right",
-        "tilemap_quad_next_down",
-    };
-    return (func_id < (uint8_t)TQI_FUNC_COUNT) ? names[func_id] : "<invalid>";
-}
-
-#define TQI_BEGIN(_id) tilemap_quad_instr_enter((uint8_t)(_id))
-#define TQI_END(_id) tilemap_quad_instr_exit((uint8_t)(_id))
+#define TQI_BEGIN(_id) host_prof_enter(&g_tqi_zones[(_id)])
+#define TQI_END(_id) host_prof_exit(&g_tqi_zones[(_id)])
 #define TQI_RECORD_TRAVERSE_ITERS(_iters) tqi_record_traverse_iters((uint8_t)(_iters))
 
-#endif
-
 #else
 
 #define TQI_BEGIN(_id) do { } while (0)
@@ -34,23 +34,17 @@ void tilemap_quad_next_right(TilemapQuadCursor* c, uint8_t* out_tile, uint8_t* o
 
 void tilemap_quad_next_down(TilemapQuadCursor* c, uint8_t* out_tile, uint8_t* out_attr);
 
-#if defined(TILEMAP_QUAD_INSTRUMENT)
+#if defined(TILEMAP_QUAD_INSTRUMENT) && !defined(__SDCC)
+#include "host_prof.h"
 
 void tilemap_quad_instr_reset(void);
-uint8_t tilemap_quad_instr_func_count(void);
-uint32_t tilemap_quad_instr_call_count(uint8_t func_id);
-uint64_t tilemap_quad_instr_total_ns(uint8_t func_id);
-uint64_t tilemap_quad_instr_excl_ns(uint8_t func_id);
+const HostProfZone* tilemap_quad_instr_zones(uint8_t* count);
 
 uint32_t tilemap_quad_instr_traverse_calls(void);
 uint32_t tilemap_quad_instr_traverse_total_iters(void);
 uint8_t tilemap_quad_instr_traverse_max_iters(void);
 uint32_t tilemap_quad_instr_traverse_hist(uint8_t iters);
 
-#ifndef __SDCC
-const char* tilemap_quad_instr_func_name(uint8_t func_id);
-#endif
-
 #endif
 
 #endif
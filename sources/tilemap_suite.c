@@ -0,0 +1,345 @@
+#if defined(TILEMAP_SUITE) && !defined(__SDCC)
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_perf.h"
+#include "host_prof.h"
+#include "host_rand.h"
+#include "map.h"
+#include "player.h"
+#include "tilemap_suite.h"
+#include "tilemap_suite_map.h"
+
+#if TILEMAP_SUITE_W < ROW_WIDTH || TILEMAP_SUITE_H < COL_HEIGHT || TILEMAP_SUITE_W > 255 || TILEMAP_SUITE_H > 255
+#error "the suite map must hold one screen strip and fit the 8-bit cursor coordinates"
+#endif
+
+#define SUITE_POINTS 4096u
+#define SUITE_MAX_ACCESSES (256u * 256u + 512u)
+#define SUITE_PROBE_FRAMES (SUITE_POINTS / 2u)
+
+typedef enum SuiteAccessKind {
+    SUITE_READ = 0,
+    SUITE_RIGHT,
+    SUITE_DOWN,
+} SuiteAccessKind;
+
+typedef struct SuiteAccess {
+    uint8_t kind;
+    uint8_t x;
+    uint8_t y;
+    uint8_t n;
+} SuiteAccess;
+
+typedef struct SuitePattern {
+    const char* name;
+    SuiteAccess* accesses;
+    uint32_t count;
+    uint64_t cells;
+} SuitePattern;
+
+typedef enum SuitePatternId {
+    SUITE_PATTERN_SEEK = 0,
+    SUITE_PATTERN_ROWS,
+    SUITE_PATTERN_COLS,
+    SUITE_PATTERN_PROBES,
+    SUITE_PATTERN_FULL,
+    SUITE_PATTERN_COUNT
+} SuitePatternId;
+
+static uint32_t g_suite_rng = 0x2545F491u;
+static volatile uint16_t g_suite_sink;
+static SuitePattern g_patterns[SUITE_PATTERN_COUNT];
+
+static uint16_t ref_cell(uint8_t x, uint8_t y) {
+    uint16_t i = (uint16_t)((uint16_t)y * TILEMAP_SUITE_W + x);
+    return TILEMAP_SUITE_CELL(TILEMAP_SUITE_TILES[i], TILEMAP_SUITE_ATTRS[i]);
+}
+
+static void ref_reset(void) { }
+
+static uint16_t ref_read(uint8_t x, uint8_t y) {
+    return ref_cell(x, y);
+}
+
+static void ref_strip_right(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    for (uint8_t i = 0; i < n; i++) {
+        out[i] = ref_cell((uint8_t)(x + i), y);
+    }
+}
+
+static void ref_strip_down(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    for (uint8_t i = 0; i < n; i++) {
+        out[i] = ref_cell(x, (uint8_t)(y + i));
+    }
+}
+
+static const TilemapSuiteBackend g_tilemap_suite_ref = {
+    "raw", (uint32_t)TILEMAP_SUITE_W * TILEMAP_SUITE_H * 2u, 1u, 1u,
+    ref_reset, ref_read, ref_strip_right, ref_strip_down,
+    0, 0,
+};
+
+static const TilemapSuiteBackend* const g_backends[] = {
+    &g_tilemap_suite_ref,
+    &g_tilemap_suite_comp,
+    &g_tilemap_suite_macro,
+    &g_tilemap_suite_hram,
+    &g_tilemap_suite_quad,
+};
+
+#define SUITE_BACKEND_COUNT (sizeof(g_backends) / sizeof(g_backends[0]))
+
+void tilemap_suite_report_zones(FILE* out, uint64_t cells, const HostProfZone* zones, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t n = zones[i].calls;
+        if (n) {
+            fprintf(out, "    %-32s %10u calls %7.3f/cell\n", zones[i].name, (unsigned)n, cells ? (double)n / (double)cells : 0.0);
+        }
+    }
+}
+
+static void pattern_push(SuitePattern* p, SuiteAccessKind kind, uint8_t x, uint8_t y, uint8_t n) {
+    if (p->count >= SUITE_MAX_ACCESSES) return;
+    SuiteAccess* a = &p->accesses[p->count++];
+    a->kind = (uint8_t)kind;
+    a->x = x;
+    a->y = y;
+    a->n = n;
+    p->cells += n;
+}
+
+static uint8_t clamp_tile(int16_t v, uint8_t limit) {
+    if (v < 0) return 0;
+    return (v >= (int16_t)limit) ? (uint8_t)(limit - 1u) : (uint8_t)v;
+}
+
+static void probe_column(SuitePattern* p, int16_t px, int16_t top, int16_t bottom) {
+    for (int16_t ty = (int16_t)(top >> 3); ty <= (int16_t)(bottom >> 3); ++ty) {
+        pattern_push(p, SUITE_READ, clamp_tile((int16_t)(px >> 3), TILEMAP_SUITE_W), clamp_tile(ty, TILEMAP_SUITE_H), 1u);
+    }
+}
+
+static void probe_row(SuitePattern* p, int16_t left, int16_t right, int16_t py) {
+    for (int16_t tx = (int16_t)((left + 1) >> 3); tx <= (int16_t)((right - 1) >> 3); ++tx) {
+        pattern_push(p, SUITE_READ, clamp_tile(tx, TILEMAP_SUITE_W), clamp_tile((int16_t)(py >> 3), TILEMAP_SUITE_H), 1u);
+    }
+}
+
+static void build_probes(SuitePattern* p) {
+    const int16_t max_x = (int16_t)(TILEMAP_SUITE_W * 8u - PLAYER_COLLISION_W);
+    const int16_t max_y = (int16_t)(TILEMAP_SUITE_H * 8u - PLAYER_COLLISION_HALF_H);
+    int16_t x = 0;
+    int16_t y = (int16_t)(max_y / 2);
+    int16_t vy = 0;
+    int16_t vx = 1;
+
+    for (uint32_t frame = 0; frame < SUITE_PROBE_FRAMES; frame++) {
+        if ((host_rand_next(&g_suite_rng) & 63u) == 0u) vx = (int16_t)-vx;
+        if (vy == 0 && (host_rand_next(&g_suite_rng) & 31u) == 0u) vy = -6;
+        x = (int16_t)(x + vx * (int16_t)(1 + (frame & 1u)));
+        y = (int16_t)(y + vy);
+        if (vy != 0) vy = (int16_t)(vy + ((frame & 3u) == 0u));
+        if (vy > 6) vy = 0;
+        if (x < 0) x = max_x;
+        if (x > max_x) x = 0;
+        if (y < PLAYER_COLLISION_HALF_H) y = PLAYER_COLLISION_HALF_H;
+        if (y > max_y) y = max_y;
+
+        int16_t top = (int16_t)(y - PLAYER_COLLISION_HALF_H);
+        int16_t bottom = (int16_t)(top + (PLAYER_COLLISION_H - 1));
+        int16_t left = x;
+        int16_t right = (int16_t)(x + (PLAYER_COLLISION_W - 1));
+
+        probe_column(p, (vx > 0) ? right : left, top, bottom);
+        probe_row(p, left, right, (vy < 0) ? top : bottom);
+        probe_row(p, left, right, (int16_t)(bottom + 1));
+    }
+}
+
+static void build_patterns(void) {
+    static const char* const NAMES[SUITE_PATTERN_COUNT] = { "seek", "rows", "cols", "probes", "full" };
+    for (uint8_t i = 0; i < (uint8_t)SUITE_PATTERN_COUNT; i++) {
+        g_patterns[i].name = NAMES[i];
+        g_patterns[i].accesses = (SuiteAccess*)calloc(SUITE_MAX_ACCESSES, sizeof(SuiteAccess));
+        if (!g_patterns[i].accesses) {
+            fprintf(stderr, "tilemap_suite: out of memory\n");
+            exit(2);
+        }
+    }
+
+    for (uint32_t i = 0; i < SUITE_POINTS; i++) {
+        uint8_t x = (uint8_t)(host_rand_next(&g_suite_rng) % TILEMAP_SUITE_W);
+        uint8_t y = (uint8_t)(host_rand_next(&g_suite_rng) % TILEMAP_SUITE_H);
+        pattern_push(&g_patterns[SUITE_PATTERN_SEEK], SUITE_READ, x, y, 1u);
+    }
+    for (uint32_t i = 0; i < SUITE_POINTS; i++) {
+        uint8_t x = (uint8_t)(host_rand_next(&g_suite_rng) % (TILEMAP_SUITE_W - ROW_WIDTH + 1u));
+        uint8_t y = (uint8_t)(host_rand_next(&g_suite_rng) % TILEMAP_SUITE_H);
+        pattern_push(&g_patterns[SUITE_PATTERN_ROWS], SUITE_RIGHT, x, y, ROW_WIDTH);
+    }
+    for (uint32_t i = 0; i < SUITE_POINTS; i++) {
+        uint8_t x = (uint8_t)(host_rand_next(&g_suite_rng) % TILEMAP_SUITE_W);
+        uint8_t y = (uint8_t)(host_rand_next(&g_suite_rng) % (TILEMAP_SUITE_H - COL_HEIGHT + 1u));
+        pattern_push(&g_patterns[SUITE_PATTERN_COLS], SUITE_DOWN, x, y, COL_HEIGHT);
+    }
+    build_probes(&g_patterns[SUITE_PATTERN_PROBES]);
+
+    SuitePattern* full = &g_patterns[SUITE_PATTERN_FULL];
+    for (uint16_t y = 0; y < TILEMAP_SUITE_H; y++) {
+        pattern_push(full, SUITE_RIGHT, 0u, (uint8_t)y, TILEMAP_SUITE_W);
+    }
+    for (uint16_t x = 0; x < TILEMAP_SUITE_W; x++) {
+        pattern_push(full, SUITE_DOWN, (uint8_t)x, 0u, TILEMAP_SUITE_H);
+    }
+    for (uint16_t y = 0; y < TILEMAP_SUITE_H; y++) {
+        for (uint16_t x = 0; x < TILEMAP_SUITE_W; x++) {
+            pattern_push(full, SUITE_READ, (uint8_t)x, (uint8_t)y, 1u);
+        }
+    }
+}
+
+static void replay_access(const TilemapSuiteBackend* b, const SuiteAccess* a, uint16_t* out) {
+    switch (a->kind) {
+        case SUITE_READ:
+            out[0] = b->read(a->x, a->y);
+            break;
+        case SUITE_RIGHT:
+            b->strip_right(a->x, a->y, a->n, out);
+            break;
+        default:
+            b->strip_down(a->x, a->y, a->n, out);
+            break;
+    }
+}
+
+static uint16_t expected_cell(const SuiteAccess* a, uint8_t i) {
+    if (a->kind == SUITE_RIGHT) return ref_cell((uint8_t)(a->x + i), a->y);
+    if (a->kind == SUITE_DOWN) return ref_cell(a->x, (uint8_t)(a->y + i));
+    return ref_cell(a->x, a->y);
+}
+
+static uint32_t check_backend(const TilemapSuiteBackend* b) {
+    uint16_t out[256];
+    uint16_t mask = b->has_attr ? 0xFFFFu : 0x00FFu;
+    uint32_t mismatches = 0;
+
+    b->reset();
+    for (uint8_t p = 0; p < (uint8_t)SUITE_PATTERN_COUNT; p++) {
+        const SuitePattern* pat = &g_patterns[p];
+        for (uint32_t i = 0; i < pat->count; i++) {
+            const SuiteAccess* a = &pat->accesses[i];
+            replay_access(b, a, out);
+            for (uint8_t k = 0; k < a->n; k++) {
+                uint16_t want = (uint16_t)(expected_cell(a, k) & mask);
+                uint16_t got = (uint16_t)(out[k] & mask);
+                if (got == want) continue;
+                if (mismatches < 8u) {
+                    uint8_t x = (uint8_t)(a->x + ((a->kind == SUITE_RIGHT) ? k : 0u));
+                    uint8_t y = (uint8_t)(a->y + ((a->kind == SUITE_DOWN) ? k : 0u));
+                    printf("  MISMATCH %s %s #%u: (%u,%u) want tile %02X attr %02X, got tile %02X attr %02X\n", b->name,
+                        pat->name, (unsigned)i, (unsigned)x, (unsigned)y, (unsigned)(want & 0xFFu), (unsigned)(want >> 8),
+                        (unsigned)(got & 0xFFu), (unsigned)(got >> 8));
+                }
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+static void time_backend(const TilemapSuiteBackend* b, const SuitePattern* pat, uint32_t reps) {
+    uint16_t out[256];
+    uint16_t acc = 0;
+    HostPerfSample perf;
+
+    b->reset();
+    host_perf_start();
+    uint64_t t0 = host_prof_now_ns();
+    for (uint32_t r = 0; r < reps; r++) {
+        for (uint32_t i = 0; i < pat->count; i++) {
+            replay_access(b, &pat->accesses[i], out);
+            acc ^= out[0];
+        }
+    }
+    uint64_t ns = host_prof_now_ns() - t0;
+    host_perf_stop(&perf);
+    g_suite_sink = acc;
+
+    uint64_t cells = pat->cells * reps;
+    uint64_t accesses = (uint64_t)pat->count * reps;
+    printf("  %-6s %8.2f ns/cell %9.2f ns/access", b->name, (double)ns / (double)cells, (double)ns / (double)accesses);
+    for (uint8_t e = 0; e < HOST_PERF_COUNT; e++) {
+        if (perf.valid[e]) {
+            printf("  %s %.2f", host_perf_name((HostPerfEvent)e), (double)perf.value[e] / (double)cells);
+        }
+    }
+    printf("\n");
+}
+
+static void report_instr(const TilemapSuiteBackend* b) {
+    if (!b->instr_reset || !b->instr_report) return;
+    printf("%s traversal:\n", b->name);
+    for (uint8_t p = 0; p < (uint8_t)SUITE_PATTERN_FULL; p++) {
+        const SuitePattern* pat = &g_patterns[p];
+        uint16_t out[256];
+        b->reset();
+        b->instr_reset();
+        for (uint32_t i = 0; i < pat->count; i++) {
+            replay_access(b, &pat->accesses[i], out);
+        }
+        printf("  %s (%llu cells):\n", pat->name, (unsigned long long)pat->cells);
+        b->instr_report(stdout, pat->cells);
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t reps = (argc > 1) ? (uint32_t)strtoul(argv[1], 0, 0) : 50u;
+    if (argc > 2) {
+        g_suite_rng = host_rand_seed((uint32_t)strtoul(argv[2], 0, 0));
+    }
+
+    uint8_t counters = host_perf_open();
+    printf("tilemap_suite: %ux%u map, %u reps, %u/%u perf counters\n", (unsigned)TILEMAP_SUITE_W,
+        (unsigned)TILEMAP_SUITE_H, (unsigned)reps, (unsigned)counters, (unsigned)HOST_PERF_COUNT);
+
+    build_patterns();
+
+    printf("\n%-7s %9s %6s %6s\n", "decoder", "rom_bytes", "attrs", "down");
+    for (uint8_t b = 0; b < (uint8_t)SUITE_BACKEND_COUNT; b++) {
+        const TilemapSuiteBackend* be = g_backends[b];
+        printf("%-7s %9u %6s %6s\n", be->name, (unsigned)be->rom_bytes, be->has_attr ? "yes" : "no",
+            be->native_down ? "next" : "seek");
+    }
+
+    printf("\nequivalence against the raw map:\n");
+    uint32_t failures = 0;
+    for (uint8_t b = 1; b < (uint8_t)SUITE_BACKEND_COUNT; b++) {
+        uint32_t bad = check_backend(g_backends[b]);
+        printf("  %-6s %s", g_backends[b]->name, bad ? "FAIL" : "ok");
+        if (bad) printf(" (%u cells differ)", (unsigned)bad);
+        printf("\n");
+        failures += bad;
+    }
+
+    for (uint8_t p = 0; reps && p < (uint8_t)SUITE_PATTERN_FULL; p++) {
+        const SuitePattern* pat = &g_patterns[p];
+        printf("\n%s: %u accesses, %llu cells\n", pat->name, (unsigned)pat->count, (unsigned long long)pat->cells);
+        for (uint8_t b = 0; b < (uint8_t)SUITE_BACKEND_COUNT; b++) {
+            time_backend(g_backends[b], pat, reps);
+        }
+    }
+
+#if defined(TILEMAP_COMP_INSTRUMENT) || defined(TILEMAP_MACRO_INSTRUMENT) || defined(TILEMAP_QUAD_INSTRUMENT)
+    printf("\nnote: instrumented build, ns/cell includes the profiler\n");
+#endif
+    for (uint8_t b = 1; b < (uint8_t)SUITE_BACKEND_COUNT; b++) {
+        report_instr(g_backends[b]);
+    }
+
+    host_perf_close();
+    return failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#ifndef __SDCC
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "host_prof.h"
+
+#define TILEMAP_SUITE_CELL(tile, attr) ((uint16_t)((uint16_t)(tile) | ((uint16_t)(attr) << 8)))
+
+typedef struct TilemapSuiteBackend {
+    const char* name;
+    uint32_t rom_bytes;
+    uint8_t has_attr;
+    uint8_t native_down;
+
+    void (*reset)(void);
+    uint16_t (*read)(uint8_t x, uint8_t y);
+    void (*strip_right)(uint8_t x, uint8_t y, uint8_t n, uint16_t* out);
+    void (*strip_down)(uint8_t x, uint8_t y, uint8_t n, uint16_t* out);
+
+    void (*instr_reset)(void);
+    void (*instr_report)(FILE* out, uint64_t cells);
+} TilemapSuiteBackend;
+
+extern const TilemapSuiteBackend g_tilemap_suite_comp;
+extern const TilemapSuiteBackend g_tilemap_suite_macro;
+extern const TilemapSuiteBackend g_tilemap_suite_hram;
+extern const TilemapSuiteBackend g_tilemap_suite_quad;
+
+void tilemap_suite_report_zones(FILE* out, uint64_t cells, const HostProfZone* zones, uint8_t count);
+
+#endif
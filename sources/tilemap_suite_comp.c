@@ -0,0 +1,49 @@
+#if defined(TILEMAP_SUITE) && !defined(TILEMAP_QUAD) && !defined(__SDCC)
+
+#include "tilemap_comp.h"
+#include "tilemap_suite.h"
+
+static TilemapCompCursor g_comp_cursor;
+
+static void comp_reset(void) {
+    tilemap_comp_cursor_seek(&g_comp_cursor, 0);
+}
+
+static uint16_t comp_read(uint8_t x, uint8_t y) {
+    tilemap_comp_cursor_seek(&g_comp_cursor, (uint16_t)((uint16_t)y * TILEMAP_WIDTH + x));
+    return tilemap_comp_cursor_next(&g_comp_cursor);
+}
+
+static void comp_strip_right(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    tilemap_comp_cursor_seek(&g_comp_cursor, (uint16_t)((uint16_t)y * TILEMAP_WIDTH + x));
+    for (uint8_t i = 0; i < n; i++) {
+        out[i] = tilemap_comp_cursor_next(&g_comp_cursor);
+    }
+}
+
+static void comp_strip_down(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    for (uint8_t i = 0; i < n; i++) {
+        out[i] = comp_read(x, (uint8_t)(y + i));
+    }
+}
+
+#if defined(TILEMAP_COMP_INSTRUMENT)
+static void comp_instr_report(FILE* out, uint64_t cells) {
+    uint8_t count;
+    const HostProfZone* zones = tilemap_comp_instr_zones(&count);
+    tilemap_suite_report_zones(out, cells, zones, count);
+}
+#define COMP_INSTR_RESET tilemap_comp_instr_reset
+#define COMP_INSTR_REPORT comp_instr_report
+#else
+#define COMP_INSTR_RESET 0
+#define COMP_INSTR_REPORT 0
+#endif
+
+const TilemapSuiteBackend g_tilemap_suite_comp = {
+    "comp", TILEMAP_COMP_ROM_BYTES, 0u, 0u,
+    comp_reset, comp_read, comp_strip_right, comp_strip_down,
+    COMP_INSTR_RESET, COMP_INSTR_REPORT,
+};
+
+#endif
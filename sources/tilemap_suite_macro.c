@@ -0,0 +1,64 @@
+#if defined(TILEMAP_SUITE) && defined(TILEMAP_MACRO) && !defined(__SDCC)
+
+#include "tilemap_macro.h"
+#include "tilemap_suite.h"
+
+static TilemapMacroCursor g_macro_query;
+static TilemapMacroCursor g_macro_row;
+static TilemapMacroCursor g_macro_col;
+
+static uint16_t macro_cell(uint16_t idx) {
+    return TILEMAP_SUITE_CELL(MACROTILES_IDS[idx], MACROTILES_ATTRS[idx]);
+}
+
+static void macro_reset(void) {
+    tilemap_macro_init(&g_macro_query);
+    tilemap_macro_init(&g_macro_row);
+    tilemap_macro_init(&g_macro_col);
+}
+
+static uint16_t macro_read(uint8_t x, uint8_t y) {
+    return macro_cell(tilemap_macro_seek_xy(&g_macro_query, x, y));
+}
+
+static void macro_strip_right(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    if (n == 0u) return;
+    out[0] = macro_cell(tilemap_macro_seek_xy(&g_macro_row, x, y));
+    for (uint8_t i = 1; i < n; i++) {
+        out[i] = macro_cell(tilemap_macro_next_right(&g_macro_row));
+    }
+}
+
+static void macro_strip_down(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    if (n == 0u) return;
+    out[0] = macro_cell(tilemap_macro_seek_xy(&g_macro_col, x, y));
+    for (uint8_t i = 1; i < n; i++) {
+        out[i] = macro_cell(tilemap_macro_next_down(&g_macro_col));
+    }
+}
+
+#if defined(TILEMAP_MACRO_INSTRUMENT)
+static void macro_instr_report(FILE* out, uint64_t cells) {
+    uint8_t count;
+    const HostProfZone* zones = tilemap_macro_instr_zones(&count);
+    tilemap_suite_report_zones(out, cells, zones, count);
+}
+#define MACRO_INSTR_RESET tilemap_macro_instr_reset
+#define MACRO_INSTR_REPORT macro_instr_report
+#else
+#define MACRO_INSTR_RESET 0
+#define MACRO_INSTR_REPORT 0
+#endif
+
+#if defined(TILEMAP_MACRO_HRAM)
+const TilemapSuiteBackend g_tilemap_suite_hram = {
+    "hram", TILEMAP_MACRO_ROM_BYTES, 1u, 1u,
+#else
+const TilemapSuiteBackend g_tilemap_suite_macro = {
+    "macro", TILEMAP_MACRO_ROM_BYTES, 1u, 1u,
+#endif
+    macro_reset, macro_read, macro_strip_right, macro_strip_down,
+    MACRO_INSTR_RESET, MACRO_INSTR_REPORT,
+};
+
+#endif
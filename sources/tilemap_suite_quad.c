@@ -0,0 +1,71 @@
+#if defined(TILEMAP_SUITE) && defined(TILEMAP_QUAD) && !defined(__SDCC)
+
+#include "tilemap_quad.h"
+#include "tilemap_suite.h"
+
+static TilemapQuadCursor g_quad_query;
+static TilemapQuadCursor g_quad_row;
+static TilemapQuadCursor g_quad_col;
+
+static void quad_reset(void) {
+    tilemap_quad_init(&g_quad_query);
+    tilemap_quad_init(&g_quad_row);
+    tilemap_quad_init(&g_quad_col);
+}
+
+static uint16_t quad_read(uint8_t x, uint8_t y) {
+    uint8_t tile;
+    uint8_t attr;
+    tilemap_quad_seek_xy(&g_quad_query, x, y);
+    tilemap_quad_next_right(&g_quad_query, &tile, &attr);
+    return TILEMAP_SUITE_CELL(tile, attr);
+}
+
+static void quad_strip_right(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    uint8_t tile;
+    uint8_t attr;
+    tilemap_quad_seek_xy(&g_quad_row, x, y);
+    for (uint8_t i = 0; i < n; i++) {
+        tilemap_quad_next_right(&g_quad_row, &tile, &attr);
+        out[i] = TILEMAP_SUITE_CELL(tile, attr);
+    }
+}
+
+static void quad_strip_down(uint8_t x, uint8_t y, uint8_t n, uint16_t* out) {
+    uint8_t tile;
+    uint8_t attr;
+    tilemap_quad_seek_xy(&g_quad_col, x, y);
+    for (uint8_t i = 0; i < n; i++) {
+        tilemap_quad_next_down(&g_quad_col, &tile, &attr);
+        out[i] = TILEMAP_SUITE_CELL(tile, attr);
+    }
+}
+
+#if defined(TILEMAP_QUAD_INSTRUMENT)
+static void quad_instr_report(FILE* out, uint64_t cells) {
+    uint8_t count;
+    const HostProfZone* zones = tilemap_quad_instr_zones(&count);
+    tilemap_suite_report_zones(out, cells, zones, count);
+    uint32_t calls = tilemap_quad_instr_traverse_calls();
+    fprintf(out, "    traverse: %u calls, avg %.2f levels, max %u, hist", (unsigned)calls,
+        calls ? (double)tilemap_quad_instr_traverse_total_iters() / (double)calls : 0.0,
+        (unsigned)tilemap_quad_instr_traverse_max_iters());
+    for (uint8_t i = 0; i <= 2u; i++) {
+        fprintf(out, " %u:%u", (unsigned)i, (unsigned)tilemap_quad_instr_traverse_hist(i));
+    }
+    fprintf(out, "\n");
+}
+#define QUAD_INSTR_RESET tilemap_quad_instr_reset
+#define QUAD_INSTR_REPORT quad_instr_report
+#else
+#define QUAD_INSTR_RESET 0
+#define QUAD_INSTR_REPORT 0
+#endif
+
+const TilemapSuiteBackend g_tilemap_suite_quad = {
+    "quad", TILEMAP_QUAD_ROM_BYTES, 1u, 1u,
+    quad_reset, quad_read, quad_strip_right, quad_strip_down,
+    QUAD_INSTR_RESET, QUAD_INSTR_REPORT,
+};
+
+#endif
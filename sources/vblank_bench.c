@@ -7,6 +7,8 @@
 #include <gb/gb.h>
 #include <gb/cgb.h>
 
+#include "oam.h"
+
 static const uint8_t BENCH_DIGITS_2BPP[11u * 16u] = {
 
     0x3C,0x3C, 0x66,0x66, 0x6E,0x6E, 0x76,0x76, 0x66,0x66, 0x66,0x66, 0x3C,0x3C, 0x00,0x00,
@@ -35,10 +37,10 @@ static const uint8_t BENCH_DIGITS_2BPP[11u * 16u] = {
 #define BENCH_SPR_TILE_BASE 80u
 #define BENCH_SPR_TILE_BLANK (BENCH_SPR_TILE_BASE + 10u)
 
-#define BENCH_SPR_ID_THOUSANDS 36u
-#define BENCH_SPR_ID_HUNDREDS  37u
-#define BENCH_SPR_ID_TENS      38u
-#define BENCH_SPR_ID_ONES      39u
+#define BENCH_SPR_ID_THOUSANDS (OAM_RESERVED_FIRST + 0u)
+#define BENCH_SPR_ID_HUNDREDS  (OAM_RESERVED_FIRST + 1u)
+#define BENCH_SPR_ID_TENS      (OAM_RESERVED_FIRST + 2u)
+#define BENCH_SPR_ID_ONES      (OAM_RESERVED_FIRST + 3u)
 
 void vblank_bench_init(void) __banked {
     uint8_t old_vbk = VBK_REG;
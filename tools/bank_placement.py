@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""Suggest ROM bank assignments from a BANK_PROFILE emulator log.
+
+Build the game with `-DBANK_PROFILE` and run it in Emulicious with debug
+messages logged to a file. Every frame the ROM prints one line per
+asset-to-asset bank transition plus a frame total:
+
+    BANKPROF f=12 1>2 n=1
+    BANKPROF f=12 2>1 n=1
+    BANKPROF f=12 total=4
+
+Asset ids follow `BankAsset` in sources/bank_scope.h. This tool sums the
+transitions into a co-access graph, greedily merges the assets that switch
+between each other most often into the same bank (subject to the 16 KiB bank
+size), and reports how many switches per frame would remain.
+
+Sizes come from `--asset name=bank:size` (size in bytes, from the linker map
+or romusage). Assets without a size are merged without a capacity check.
+
+Output is a text report; `--emit-plan` additionally writes one line per asset
+naming the file or tool that sets its bank and the value to give it. The banks
+are set in several places (a generated header, png2asset, a -D flag and a
+`#pragma bank`), so the plan is applied by hand rather than passed to lcc.
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import DefaultDict, Iterable
+
+ASSET_NAMES = ["home", "tilemap", "player_anim", "music", "bench"]
+
+BANK_SIZE = 0x4000
+
+LINE_RE = re.compile(r"BANKPROF f=(\d+) (\d+)>(\d+) n=(\d+)")
+TOTAL_RE = re.compile(r"BANKPROF f=(\d+) total=(\d+)")
+
+PLAN_TEMPLATES = {
+    "tilemap": "tilemap_macro_data.h: #define TILEMAP_MACRO_DATA_BANK {bank}",
+    "player_anim": "png2asset player_animations: -b {bank}",
+    "music": "music.c: -DMUSIC_BANK={bank}u; music_bank3.c: #pragma bank {bank}",
+    "bench": "vblank_bench.c: #pragma bank {bank}",
+}
+
+
+@dataclass
+class Asset:
+    name: str
+    bank: int | None = None
+    size: int | None = None
+
+
+@dataclass
+class Profile:
+    frames: set[int] = field(default_factory=set)
+    transitions: DefaultDict[tuple[int, int], int] = field(default_factory=lambda: defaultdict(int))
+    totals: dict[int, int] = field(default_factory=dict)
+
+
+@dataclass
+class Cluster:
+    members: list[int]
+    size: int | None
+
+
+def parse_logs(paths: Iterable[Path]) -> Profile:
+    prof = Profile()
+    for path in paths:
+        with path.open("r", encoding="utf-8", errors="replace") as f:
+            for line in f:
+                m = LINE_RE.search(line)
+                if m:
+                    frame, src, dst, n = (int(g) for g in m.groups())
+                    prof.frames.add(frame)
+                    prof.transitions[(src, dst)] += n
+                    continue
+                m = TOTAL_RE.search(line)
+                if m:
+                    frame, total = int(m.group(1)), int(m.group(2))
+                    prof.frames.add(frame)
+                    prof.totals[frame] = total
+    return prof
+
+
+def parse_asset_args(values: list[str]) -> dict[str, Asset]:
+    assets = {name: Asset(name) for name in ASSET_NAMES}
+    for value in values:
+        name, _, rest = value.partition("=")
+        if name not in assets:
+            raise SystemExit(f"Unknown asset '{name}'. Known: {', '.join(ASSET_NAMES)}")
+        bank_s, _, size_s = rest.partition(":")
+        assets[name].bank = int(bank_s, 0) if bank_s else None
+        assets[name].size = int(size_s, 0) if size_s else None
+    return assets
+
+
+def edge_weights(prof: Profile) -> dict[tuple[int, int], int]:
+    weights: DefaultDict[tuple[int, int], int] = defaultdict(int)
+    for (src, dst), n in prof.transitions.items():
+        if src == dst or src == 0 or dst == 0:
+            continue
+        key = (min(src, dst), max(src, dst))
+        weights[key] += n
+    return dict(weights)
+
+
+def merged_size(a: int | None, b: int | None) -> int | None:
+    if a is None or b is None:
+        return None
+    return a + b
+
+
+def cluster_assets(
+    weights: dict[tuple[int, int], int],
+    assets: dict[str, Asset],
+    capacity: int,
+) -> list[Cluster]:
+    ids = range(1, len(ASSET_NAMES))
+    owner = {i: i for i in ids}
+    clusters = {i: Cluster([i], assets[ASSET_NAMES[i]].size) for i in ids}
+
+    for (a, b), _w in sorted(weights.items(), key=lambda kv: (-kv[1], kv[0])):
+        ca, cb = owner[a], owner[b]
+        if ca == cb:
+            continue
+        size = merged_size(clusters[ca].size, clusters[cb].size)
+        if size is not None and size > capacity:
+            continue
+        clusters[ca].members.extend(clusters[cb].members)
+        clusters[ca].size = size
+        for m in clusters[cb].members:
+            owner[m] = ca
+        del clusters[cb]
+
+    return sorted(clusters.values(), key=lambda c: min(c.members))
+
+
+def remaining_switches(weights: dict[tuple[int, int], int], clusters: list[Cluster]) -> int:
+    where = {m: i for i, c in enumerate(clusters) for m in c.members}
+    return sum(w for (a, b), w in weights.items() if where[a] != where[b])
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Suggest ROM bank placement from BANK_PROFILE logs.")
+    parser.add_argument("logs", nargs="+", type=Path, help="Emulicious debug message log file(s)")
+    parser.add_argument(
+        "--asset",
+        action="append",
+        default=[],
+        metavar="NAME=BANK[:SIZE]",
+        help="Current bank and size in bytes of an asset (repeatable)",
+    )
+    parser.add_argument("--first-bank", type=int, default=1, help="First switchable bank to assign (default: 1)")
+    parser.add_argument(
+        "--reserve",
+        type=int,
+        default=0,
+        help="Bytes to keep free in every bank for code that shares it (default: 0)",
+    )
+    parser.add_argument("--emit-plan", type=Path, help="Write where to set each suggested bank to this file")
+
+    args = parser.parse_args()
+
+    prof = parse_logs(args.logs)
+    if not prof.frames:
+        raise SystemExit("No BANKPROF lines found. Was the ROM built with -DBANK_PROFILE?")
+
+    assets = parse_asset_args(args.asset)
+    frame_count = len(prof.frames)
+
+    per_asset: DefaultDict[int, int] = defaultdict(int)
+    for (_src, dst), n in prof.transitions.items():
+        per_asset[dst] += n
+
+    total = sum(prof.totals.values()) if prof.totals else sum(prof.transitions.values())
+    print(f"Frames: {frame_count}")
+    print(f"Bank switches: {total} ({total / frame_count:.2f}/frame, max {max(prof.totals.values(), default=0)})")
+    print()
+    print("Switches into asset:")
+    for i, name in enumerate(ASSET_NAMES):
+        if per_asset[i]:
+            print(f"  {name:<12} {per_asset[i]:>8} ({per_asset[i] / frame_count:.2f}/frame)")
+
+    weights = edge_weights(prof)
+    print()
+    print("Co-access (switches between pairs):")
+    for (a, b), w in sorted(weights.items(), key=lambda kv: -kv[1]):
+        print(f"  {ASSET_NAMES[a]:<12} <-> {ASSET_NAMES[b]:<12} {w:>8} ({w / frame_count:.2f}/frame)")
+
+    missing = [a.name for a in assets.values() if a.name != "home" and a.size is None]
+    if missing:
+        print()
+        print(f"warning: no size for {', '.join(missing)}; capacity not checked for them", file=sys.stderr)
+
+    clusters = cluster_assets(weights, assets, BANK_SIZE - args.reserve)
+    before = sum(weights.values())
+    after = remaining_switches(weights, clusters)
+
+    print()
+    print("Suggested placement:")
+    plan: list[str] = []
+    for offset, cluster in enumerate(clusters):
+        bank = args.first_bank + offset
+        names = [ASSET_NAMES[m] for m in cluster.members]
+        size = f"{cluster.size} bytes" if cluster.size is not None else "size unknown"
+        print(f"  bank {bank}: {', '.join(names)} ({size})")
+        for name in names:
+            current = assets[name].bank
+            if current is not None and current != bank:
+                print(f"    {name}: move from bank {current}")
+            plan.append(PLAN_TEMPLATES[name].format(bank=bank))
+
+    print()
+    print(
+        f"Inter-asset switches: {before} -> {after} "
+        f"({before / frame_count:.2f} -> {after / frame_count:.2f}/frame)"
+    )
+
+    if args.emit_plan:
+        args.emit_plan.write_text("\n".join(plan) + "\n", encoding="utf-8")
+        print(f"Wrote {args.emit_plan}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
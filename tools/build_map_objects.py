@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""Build the streamed object layer (enemies, items) for the map.
+
+Input is a Tiled JSON map (object layers are read, tile layers ignored) or a
+plain JSON list of objects:
+
+    [{"kind": "walker", "x": 40, "y": 12}, ...]          # tile coordinates
+
+Tiled objects use pixel coordinates and their `type` / `class` as the kind;
+they are converted to 8x8 map tiles. Kinds map to `ActorKind` in
+sources/actor.h (`walker` -> ACTOR_KIND_WALKER).
+
+The output header holds the objects sorted by (column, row) plus two indexes:
+
+- MAP_OBJECT_COL_START[c] .. [c + 1] is the id range in tile column c, so
+  map_set_scroll() only visits the objects of the column that streamed in;
+- MAP_OBJECT_ROW_ORDER[MAP_OBJECT_ROW_START[r] .. [r + 1]] lists the ids in
+  tile row r, sorted by column.
+
+Ids are UINT8, so a map carries at most 255 objects (0xFF is "none").
+Output: sources/map_objects_data.h, built from the level's Tiled map. ROM
+and HOST_MAP_DATA builds include it and fail to compile when its size does
+not match the tilemap (TILEMAP_MACRO_WIDTH/HEIGHT x TILEMAP_MACRO_GROUP_SIDE).
+
+The checked-in sources/map_objects_sample.h is built from
+tools/map_objects.json for the host synthetic level
+(`--width 256 --height 256 --out sources/map_objects_sample.h`) and is only
+used by host builds without HOST_MAP_DATA.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+from dataclasses import dataclass
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+TILE_SIZE = 8
+MAX_OBJECTS = 255
+
+KIND_RE = re.compile(r"^\s*(ACTOR_KIND_\w+)\s*(?:=\s*\d+)?\s*,", re.MULTILINE)
+
+
+@dataclass(frozen=True)
+class MapObject:
+    col: int
+    row: int
+    kind: str
+
+
+def read_kinds(path: Path) -> list[str]:
+    return [k for k in KIND_RE.findall(path.read_text(encoding="utf-8")) if k != "ACTOR_KIND_COUNT"]
+
+
+def kind_enum(name: str, kinds: list[str]) -> str:
+    enum = "ACTOR_KIND_" + re.sub(r"[^A-Za-z0-9]+", "_", name).upper()
+    if enum not in kinds:
+        raise SystemExit(f"Unknown object kind '{name}'. Known: {', '.join(k[11:].lower() for k in kinds)}")
+    return enum
+
+
+def load_objects(path: Path, kinds: list[str]) -> tuple[list[MapObject], int | None, int | None]:
+    data = json.loads(path.read_text(encoding="utf-8"))
+    objects: list[MapObject] = []
+
+    if isinstance(data, list):
+        for obj in data:
+            objects.append(MapObject(int(obj["x"]), int(obj["y"]), kind_enum(obj["kind"], kinds)))
+        return objects, None, None
+
+    tile_w = int(data.get("tilewidth", TILE_SIZE))
+    tile_h = int(data.get("tileheight", TILE_SIZE))
+    for layer in data.get("layers", []):
+        if layer.get("type") != "objectgroup":
+            continue
+        for obj in layer.get("objects", []):
+            kind = obj.get("type") or obj.get("class") or obj.get("name")
+            if not kind:
+                raise SystemExit(f"Object {obj.get('id')} in layer '{layer.get('name')}' has no type")
+            col = int(obj["x"]) // TILE_SIZE
+            row = int(obj["y"]) // TILE_SIZE
+            objects.append(MapObject(col, row, kind_enum(kind, kinds)))
+
+    width = int(data["width"]) * tile_w // TILE_SIZE if "width" in data else None
+    height = int(data["height"]) * tile_h // TILE_SIZE if "height" in data else None
+    return objects, width, height
+
+
+def starts(keys: list[int], count: int) -> list[int]:
+    out = [0] * (count + 1)
+    for k in keys:
+        out[k + 1] += 1
+    for i in range(count):
+        out[i + 1] += out[i]
+    return out
+
+
+def c_array(ctype: str, name: str, values: list) -> str:
+    if not values:
+        return f"static const {ctype} {name}[1] = {{ 0 }};\n"
+    rows = []
+    for i in range(0, len(values), 16):
+        rows.append("    " + ", ".join(str(v) for v in values[i : i + 16]) + ",")
+    return f"static const {ctype} {name}[{len(values)}] = {{\n" + "\n".join(rows) + "\n};\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Build the column/row indexed map object layer.")
+    parser.add_argument("objects", type=Path, help="Tiled JSON map or JSON object list")
+    parser.add_argument("--width", type=int, help="Map width in 8x8 tiles (default: from the Tiled map)")
+    parser.add_argument("--height", type=int, help="Map height in 8x8 tiles (default: from the Tiled map)")
+    parser.add_argument(
+        "--out",
+        type=Path,
+        default=SOURCES / "map_objects_data.h",
+        help="Output header (default: sources/map_objects_data.h)",
+    )
+    args = parser.parse_args()
+
+    kinds = read_kinds(SOURCES / "actor.h")
+    objects, width, height = load_objects(args.objects, kinds)
+    width = args.width or width
+    height = args.height or height
+    if width is None or height is None:
+        raise SystemExit("Map size unknown; pass --width and --height")
+
+    for obj in objects:
+        if not (0 <= obj.col < width and 0 <= obj.row < height):
+            raise SystemExit(f"{obj.kind} at ({obj.col}, {obj.row}) is outside the {width}x{height} map")
+    if len(objects) > MAX_OBJECTS:
+        raise SystemExit(f"{len(objects)} objects; the layer holds at most {MAX_OBJECTS}")
+
+    objects = sorted(set(objects), key=lambda o: (o.col, o.row, o.kind))
+    row_order = sorted(range(len(objects)), key=lambda i: (objects[i].row, objects[i].col))
+
+    col_start = starts([o.col for o in objects], width)
+    row_start = starts([objects[i].row for i in row_order], height)
+
+    out = [
+        "#pragma once",
+        "",
+        '#include "game_types.h"',
+        '#include "actor.h"',
+        "",
+        f"#define MAP_OBJECT_COUNT {len(objects)}",
+        f"#define MAP_OBJECT_COLUMNS {width}",
+        f"#define MAP_OBJECT_ROWS {height}",
+        "",
+        c_array("UINT8", "MAP_OBJECT_KIND", [o.kind for o in objects]),
+        c_array("UINT16", "MAP_OBJECT_TILE_X", [o.col for o in objects]),
+        c_array("UINT16", "MAP_OBJECT_TILE_Y", [o.row for o in objects]),
+        c_array("UINT8", "MAP_OBJECT_COL_START", col_start),
+        c_array("UINT8", "MAP_OBJECT_ROW_ORDER", row_order),
+        c_array("UINT8", "MAP_OBJECT_ROW_START", row_start),
+    ]
+    args.out.write_text("\n".join(out).rstrip("\n") + "\n", encoding="utf-8")
+    print(f"Wrote {args.out} ({len(objects)} objects, {width}x{height} tiles)")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
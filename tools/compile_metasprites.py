@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+"""Compile png2asset player metasprites into pre-flipped per-direction frames.
+
+player_draw() used to pick move_metasprite_ex() or move_metasprite_flipx() at
+runtime and derive the metasprite index from the animation state. This tool
+reads the png2asset output for the player sheet and emits, for every
+(state, direction, frame):
+
+- the metasprite in its final orientation. Right-facing run/jump frames are
+  flipped here: dx is negated, the first item also moves 8 px left (what
+  move_metasprite_flipx() does with x - 8), and S_FLIPX is toggled in props;
+- one flat pointer table PLAYER_FRAMES indexed by PLAYER_FRAME_INDEX(), with
+  the idle ping-pong sequence already expanded;
+- for the sprite tile streamer, each source frame's tiles packed into one
+  contiguous run with the metasprite tile indices remapped to 0..n-1, plus
+  PLAYER_FRAME_TILE_DATA/COUNT tables that share the PLAYER_FRAME_INDEX()
+  layout. Only the current frame's tiles need to be resident in VRAM.
+
+The runs go into a single autobanked player_frame_tiles array, written as
+assembly so the area can carry `.bndry 16`: every run is a whole number of
+tiles from an aligned base, so each frame starts on the 16-byte boundary
+sprite_stream.c needs for GDMA. A misaligned frame still uploads, through the
+slower set_sprite_data() path.
+
+Sheet layout (from sources/player.h): IDLE_FRAMES_PER_DIR left-facing idle
+frames, the same number right-facing, then RUN_FRAMES_PER_DIR run frames and
+JUMP_FRAMES_PER_DIR jump frames, all facing left.
+
+Usage:
+    png2asset player_animations.png ... -c build/player_animations.c
+    tools/compile_metasprites.py build/player_animations.c
+
+Output: sources/player_frames_data.h, sources/player_frame_tiles.s
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+from dataclasses import dataclass
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+SPRITE_W = 8
+TILE_BYTES = 16
+S_FLIPX = 0x20
+PROP_FLAGS = {"S_FLIPX": 0x20, "S_FLIPY": 0x40, "S_PRIORITY": 0x80, "S_PALETTE": 0x10, "S_BANK": 0x08}
+
+DEFINE_RE = re.compile(r"^#define\s+(\w+)\s+(\d+)\s*$", re.MULTILINE)
+ARRAY_RE = re.compile(r"metasprite_t\s+(\w+)\s*\[\s*\w*\s*\]\s*=\s*\{(.*?)\};", re.DOTALL)
+TABLE_RE = re.compile(r"metasprite_t\s*\*\s*const\s+(\w+)\s*\[\s*\w*\s*\]\s*=\s*\{(.*?)\};", re.DOTALL)
+TILES_RE = r"uint8_t\s+{name}\s*\[\s*\w*\s*\]\s*=\s*\{{(.*?)\}};"
+ITEM_RE = re.compile(r"METASPR_ITEM\(([^,()]+),([^,()]+),([^,()]+),((?:[^()]|\([^()]*\))+)\)")
+
+STATES = ("IDLE", "RUN", "JUMP")
+DIRS = ("LEFT", "RIGHT")
+
+
+@dataclass(frozen=True)
+class Item:
+    dy: int
+    dx: int
+    tile: int
+    props: int
+
+
+def parse_props(expr: str) -> int:
+    value = 0
+    for term in (t.strip() for t in expr.split("|")):
+        if not term:
+            continue
+        m = re.fullmatch(r"S_PAL\((\d+)\)", term)
+        if m:
+            value |= int(m.group(1)) & 7
+        elif term in PROP_FLAGS:
+            value |= PROP_FLAGS[term]
+        else:
+            value |= int(term, 0)
+    return value
+
+
+def parse_png2asset(path: Path, table_name: str) -> list[list[Item]]:
+    text = path.read_text(encoding="utf-8")
+    arrays: dict[str, list[Item]] = {}
+    for name, body in ARRAY_RE.findall(text):
+        items = [
+            Item(int(dy, 0), int(dx, 0), int(tile, 0), parse_props(props))
+            for dy, dx, tile, props in ITEM_RE.findall(body)
+        ]
+        arrays[name] = items
+
+    for name, body in TABLE_RE.findall(text):
+        if name == table_name:
+            refs = [r.strip().lstrip("&") for r in body.split(",") if r.strip()]
+            return [arrays[r] for r in refs]
+    raise SystemExit(f"{path}: no '{table_name}' metasprite table")
+
+
+def parse_tiles(path: Path, name: str) -> list[bytes]:
+    m = re.search(TILES_RE.format(name=re.escape(name)), path.read_text(encoding="utf-8"), re.DOTALL)
+    if not m:
+        raise SystemExit(f"{path}: no '{name}' tile array")
+    data = bytes(int(v, 0) for v in m.group(1).replace("\n", " ").split(",") if v.strip())
+    return [data[i : i + TILE_BYTES] for i in range(0, len(data), TILE_BYTES)]
+
+
+def pack_tiles(items: list[Item], tiles: list[bytes]) -> tuple[list[Item], bytes]:
+    order: dict[int, int] = {}
+    out = []
+    for it in items:
+        if it.tile not in order:
+            order[it.tile] = len(order)
+        out.append(Item(it.dy, it.dx, order[it.tile], it.props))
+    return out, b"".join(tiles[t] for t in order)
+
+
+def flip_x(items: list[Item]) -> list[Item]:
+    out = []
+    for i, it in enumerate(items):
+        dx = -it.dx - (SPRITE_W if i == 0 else 0)
+        out.append(Item(it.dy, dx, it.tile, it.props ^ S_FLIPX))
+    return out
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compile pre-flipped player metasprite frames.")
+    parser.add_argument("png2asset_c", type=Path, help="png2asset C output for the player sheet")
+    parser.add_argument("--table", default="player_animations_metasprites", help="Metasprite table name")
+    parser.add_argument("--tiles", default="player_animations_tiles", help="Tile data array name")
+    parser.add_argument("--idle-sequence", default="0,1,2,1", help="Idle frame order (default: 0,1,2,1)")
+    parser.add_argument(
+        "--out",
+        type=Path,
+        default=SOURCES / "player_frames_data.h",
+        help="Output header (default: sources/player_frames_data.h)",
+    )
+    parser.add_argument(
+        "--out-tiles",
+        type=Path,
+        default=SOURCES / "player_frame_tiles.s",
+        help="Output packed tile data (default: sources/player_frame_tiles.s)",
+    )
+    args = parser.parse_args()
+
+    defines = {k: int(v) for k, v in DEFINE_RE.findall((SOURCES / "player.h").read_text(encoding="utf-8"))}
+    idle_n = defines["IDLE_FRAMES_PER_DIR"]
+    run_n = defines["RUN_FRAMES_PER_DIR"]
+    jump_n = defines["JUMP_FRAMES_PER_DIR"]
+    idle_seq = [int(v) for v in args.idle_sequence.split(",")]
+    if len(idle_seq) != defines["IDLE_SEQ_LEN"]:
+        raise SystemExit(f"--idle-sequence has {len(idle_seq)} entries, IDLE_SEQ_LEN is {defines['IDLE_SEQ_LEN']}")
+
+    sheet = parse_png2asset(args.png2asset_c, args.table)
+    tiles = parse_tiles(args.png2asset_c, args.tiles)
+    if len(sheet) < 2 * idle_n + run_n + jump_n:
+        raise SystemExit(f"{args.table} has {len(sheet)} frames, layout needs {2 * idle_n + run_n + jump_n}")
+
+    run_base = 2 * idle_n
+    jump_base = run_base + run_n
+
+    layout: dict[tuple[int, int], list[tuple[int, bool]]] = {
+        (0, 0): [(i, False) for i in idle_seq],
+        (0, 1): [(idle_n + i, False) for i in idle_seq],
+        (1, 0): [(run_base + i, False) for i in range(run_n)],
+        (1, 1): [(run_base + i, True) for i in range(run_n)],
+        (2, 0): [(jump_base + i, False) for i in range(jump_n)],
+        (2, 1): [(jump_base + i, True) for i in range(jump_n)],
+    }
+
+    stride = 1
+    while stride < max(len(v) for v in layout.values()):
+        stride <<= 1
+    stride_shift = stride.bit_length() - 1
+
+    names: dict[tuple[int, bool], str] = {}
+    blobs: dict[int, bytes] = {}
+    bodies: list[str] = []
+    for frames in layout.values():
+        for src, flipped in frames:
+            if (src, flipped) in names:
+                continue
+            name = f"player_frame_{src}{'_fx' if flipped else ''}"
+            names[(src, flipped)] = name
+            items, blobs[src] = pack_tiles(sheet[src], tiles)
+            items = flip_x(items) if flipped else items
+            lines = [f"    METASPR_ITEM({it.dy}, {it.dx}, {it.tile}, 0x{it.props:02X})," for it in items]
+            bodies.append(f"static const metasprite_t {name}[] = {{\n" + "\n".join(lines) + "\n    METASPR_TERM\n};\n")
+
+    offsets: dict[int, int] = {}
+    size = 0
+    for src in sorted(blobs):
+        offsets[src] = size
+        size += len(blobs[src])
+
+    table: list[str] = []
+    tile_data: list[str] = []
+    tile_count: list[str] = []
+    for state in range(len(STATES)):
+        for d in range(len(DIRS)):
+            frames = layout[(state, d)]
+            frames = frames + [frames[0]] * (stride - len(frames))
+            table.append("    " + ", ".join(names[f] for f in frames) + ",")
+            tile_data.append("    " + ", ".join(f"player_frame_tiles + 0x{offsets[src]:04X}" for src, _f in frames) + ",")
+            tile_count.append("    " + ", ".join(str(len(blobs[src]) // TILE_BYTES) for src, _f in frames) + ",")
+
+    max_tiles = max(len(b) for b in blobs.values()) // TILE_BYTES
+    entries = len(STATES) * len(DIRS) * stride
+
+    out = [
+        "#pragma once",
+        "",
+        "#include <gbdk/platform.h>",
+        "#include <gbdk/metasprites.h>",
+        "",
+        *(f"#define PLAYER_FRAME_STATE_{s} {i}" for i, s in enumerate(STATES)),
+        *(f"#define PLAYER_FRAME_DIR_{d} {i}" for i, d in enumerate(DIRS)),
+        f"#define PLAYER_FRAME_STRIDE_SHIFT {stride_shift}",
+        "#define PLAYER_FRAME_INDEX(state, dir, frame) \\",
+        "    ((UINT8)((((state) << 1) | (dir)) << PLAYER_FRAME_STRIDE_SHIFT) + (frame))",
+        f"#define PLAYER_FRAME_MAX_TILES {max_tiles}",
+        "",
+        "BANKREF_EXTERN(player_frame_tiles)",
+        f"extern const uint8_t player_frame_tiles[{size}];",
+        "",
+        *bodies,
+        f"static const metasprite_t* const PLAYER_FRAMES[{entries}] = {{",
+        *table,
+        "};",
+        "",
+        f"static const uint8_t* const PLAYER_FRAME_TILE_DATA[{entries}] = {{",
+        *tile_data,
+        "};",
+        "",
+        f"static const uint8_t PLAYER_FRAME_TILE_COUNT[{entries}] = {{",
+        *tile_count,
+        "};",
+    ]
+    args.out.write_text("\n".join(out) + "\n", encoding="utf-8")
+
+    tiles_out = [
+        "        .module player_frame_tiles",
+        "",
+        "        .globl  _player_frame_tiles",
+        "        .globl  ___bank_player_frame_tiles",
+        "",
+        "        ___bank_player_frame_tiles = 255",
+        "",
+        "        .area   _CODE_255",
+        "        .bndry  16",
+        "",
+        "_player_frame_tiles::",
+    ]
+    for src in sorted(blobs):
+        blob = blobs[src]
+        tiles_out.append(f";; frame {src}: {len(blob) // TILE_BYTES} tiles at +0x{offsets[src]:04X}")
+        tiles_out.extend(
+            "        .db     " + ", ".join(f"0x{b:02X}" for b in blob[i : i + TILE_BYTES])
+            for i in range(0, len(blob), TILE_BYTES)
+        )
+    args.out_tiles.write_text("\n".join(tiles_out).rstrip("\n") + "\n", encoding="utf-8")
+
+    print(
+        f"Wrote {args.out} ({len(names)} metasprites, stride {stride}) and "
+        f"{args.out_tiles} ({len(blobs)} frames, at most {max_tiles} tiles each)"
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""Compile sound effects into precompiled APU register-write streams.
+
+Effects are described in tools/sfx.json, in id order:
+
+    "jump": {"channel": 1, "priority": 2, "ticks": [
+        {"NR10": "0x15", "NR11": "0x80", "NR12": "0xA2", "NR13": "0x00", "NR14": "0x86", "wait": 3},
+        ...
+    ]}
+
+- `channel` is the APU / hUGE channel (1-4) the effect takes over;
+- `priority` decides stealing: an effect may replace one that is playing on
+  the same channel only if its priority is the same or higher;
+- each entry of `ticks` lists the register writes for one driver tick, then
+  `wait` silent ticks (default 0) before the next entry. Only the effect's own
+  channel registers may be written.
+
+Each entry becomes one record: a header byte (write count in bits 0-2, wait in
+bits 3-7) followed by (register low byte, value) pairs, so sfx_tick() only
+does table reads and stores. 0xFF ends the stream. Every record holds at most
+--max-writes writes, which bounds the per-tick cost of the engine; the header
+reports the worst case as SFX_TICK_WORST_WRITES.
+
+Output: sources/sfx_data.h, sources/sfx_data.c
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+CHANNEL_REGS = {
+    1: {"NR10": 0x10, "NR11": 0x11, "NR12": 0x12, "NR13": 0x13, "NR14": 0x14},
+    2: {"NR21": 0x16, "NR22": 0x17, "NR23": 0x18, "NR24": 0x19},
+    3: {"NR30": 0x1A, "NR31": 0x1B, "NR32": 0x1C, "NR33": 0x1D, "NR34": 0x1E},
+    4: {"NR41": 0x20, "NR42": 0x21, "NR43": 0x22, "NR44": 0x23},
+}
+
+HEADER_WRITES_BITS = 3
+MAX_WAIT = 0xFF >> HEADER_WRITES_BITS
+SFX_END = 0xFF
+
+
+def encode(name: str, spec: dict, max_writes: int) -> tuple[list[int], int, int]:
+    regs = CHANNEL_REGS[spec["channel"]]
+    stream: list[int] = []
+    worst = 0
+    ticks = 0
+    for i, tick in enumerate(spec["ticks"]):
+        wait = int(tick.get("wait", 0))
+        writes = [(k, int(v, 0) if isinstance(v, str) else int(v)) for k, v in tick.items() if k != "wait"]
+        for reg, value in writes:
+            if reg not in regs:
+                raise SystemExit(f"{name} tick {i}: {reg} is not a channel {spec['channel']} register")
+            if not 0 <= value <= 0xFF:
+                raise SystemExit(f"{name} tick {i}: {reg} value {value} does not fit a byte")
+        if len(writes) > max_writes:
+            raise SystemExit(f"{name} tick {i}: {len(writes)} writes, at most {max_writes} per tick")
+        worst = max(worst, len(writes))
+
+        header_wait = min(wait, MAX_WAIT)
+        stream.append(len(writes) | (header_wait << HEADER_WRITES_BITS))
+        for reg, value in writes:
+            stream.extend((regs[reg], value))
+        wait -= header_wait
+        while wait:
+            step = min(wait, MAX_WAIT + 1)
+            stream.append((step - 1) << HEADER_WRITES_BITS)
+            wait -= step
+        ticks += 1 + int(tick.get("wait", 0))
+    stream.append(SFX_END)
+    return stream, worst, ticks
+
+
+def c_array(ctype: str, name: str, values: list) -> str:
+    rows = []
+    for i in range(0, len(values), 16):
+        rows.append("    " + ", ".join(str(v) for v in values[i : i + 16]) + ",")
+    return f"const {ctype} {name}[{len(values)}] = {{\n" + "\n".join(rows) + "\n};\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compile sound effects into register-write streams.")
+    parser.add_argument(
+        "--effects",
+        type=Path,
+        default=ROOT / "tools" / "sfx.json",
+        help="Effect description (default: tools/sfx.json)",
+    )
+    parser.add_argument("--max-writes", type=int, default=5, help="Register writes allowed per tick (1-6, default: 5)")
+    parser.add_argument(
+        "--out",
+        type=Path,
+        default=SOURCES / "sfx_data.h",
+        help="Output header (default: sources/sfx_data.h)",
+    )
+    parser.add_argument(
+        "--out-data",
+        type=Path,
+        default=SOURCES / "sfx_data.c",
+        help="Output stream data (default: sources/sfx_data.c)",
+    )
+    args = parser.parse_args()
+    if not 1 <= args.max_writes <= 6:
+        raise SystemExit("--max-writes must be 1-6 (0xFF is the end marker)")
+
+    effects: dict[str, dict] = json.loads(args.effects.read_text(encoding="utf-8"))
+    if len(effects) > 255:
+        raise SystemExit(f"{len(effects)} effects; ids are UINT8")
+
+    ids = [re.sub(r"[^A-Za-z0-9]+", "_", name).upper() for name in effects]
+    streams: list[list[int]] = []
+    channel_worst = {ch: 0 for ch in CHANNEL_REGS}
+    for name, spec in effects.items():
+        if spec.get("channel") not in CHANNEL_REGS:
+            raise SystemExit(f"{name}: channel must be 1-4")
+        if not 0 <= int(spec.get("priority", 0)) <= 255:
+            raise SystemExit(f"{name}: priority must fit a byte")
+        stream, worst, ticks = encode(name, spec, args.max_writes)
+        streams.append(stream)
+        channel_worst[spec["channel"]] = max(channel_worst[spec["channel"]], worst)
+        print(f"  {name}: channel {spec['channel']}, {ticks} ticks, {len(stream)} bytes, {worst} writes max")
+
+    worst_total = sum(channel_worst.values())
+
+    header = [
+        "#pragma once",
+        "",
+        '#include "game_types.h"',
+        "",
+        *(f"#define SFX_{sfx_id} {i}" for i, sfx_id in enumerate(ids)),
+        f"#define SFX_COUNT {len(ids)}",
+        f"#define SFX_MAX_WRITES_PER_TICK {args.max_writes}",
+        f"#define SFX_TICK_WORST_WRITES {worst_total}",
+        "",
+        "extern const UINT8* const SFX_STREAM[SFX_COUNT];",
+        "extern const UINT8 SFX_CHANNEL[SFX_COUNT];",
+        "extern const UINT8 SFX_PRIORITY[SFX_COUNT];",
+    ]
+    args.out.write_text("\n".join(header) + "\n", encoding="utf-8")
+
+    data = ['#include "sfx_data.h"', ""]
+    for sfx_id, stream in zip(ids, streams):
+        data.append(c_array("UINT8", f"SFX_STREAM_{sfx_id}", [f"0x{b:02X}" for b in stream]))
+    data.append("const UINT8* const SFX_STREAM[SFX_COUNT] = {")
+    data.extend(f"    SFX_STREAM_{sfx_id}," for sfx_id in ids)
+    data.append("};")
+    data.append("")
+    data.append(c_array("UINT8", "SFX_CHANNEL", [spec["channel"] - 1 for spec in effects.values()]))
+    data.append(c_array("UINT8", "SFX_PRIORITY", [int(spec.get("priority", 0)) for spec in effects.values()]))
+    args.out_data.write_text("\n".join(data).rstrip("\n") + "\n", encoding="utf-8")
+
+    print(f"Wrote {args.out} and {args.out_data} ({len(ids)} effects, worst tick {worst_total} writes)")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Decode the per-phase frame profile from a cartridge SRAM dump.
+
+A PHASE_PROFILE build (see sources/phase_prof.h) timestamps every frame phase
+with TIMA at 262144 Hz (one tick = 4 M-cycles) and, every
+PHASE_PROF_WINDOW frames, appends one record to a ring buffer at the start of
+SRAM bank 0:
+
+    header   magic "PPRF", version, phase_count, record_size, window_frames,
+             capacity, head, count, seq                      (16 bytes)
+    records  seq, frames, lag_frames, then min/avg/max ticks per phase
+
+All fields are little-endian. Phase names are read from the PhaseProfPhase
+enum so the report follows the firmware. Main-loop phases exclude time spent
+in the VBlank / timer handlers, which are reported as their own phases; FRAME
+is the full frame, start to start. Frames run in CGB double speed are halved
+before they are accumulated, so every tick is normal-speed time. WAIT is idle
+time until VBlank, so it and FRAME are left out of the worst-phase pick.
+
+Usage:
+    tools/decode_profile_sram.py game.sav
+    tools/decode_profile_sram.py game.sav --records --csv
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import struct
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+MAGIC = b"PPRF"
+VERSION = 1
+HEADER = struct.Struct("<4sBBBBHHHH")
+M_CYCLES_PER_TICK = 4
+FRAME_M_CYCLES = 70224 // 4
+NOT_WORK_PHASES = ("wait", "frame")
+
+ENUM_RE = re.compile(r"typedef enum PhaseProfPhase \{(.*?)\} PhaseProfPhase;", re.DOTALL)
+NAME_RE = re.compile(r"PHASE_PROF_(\w+)")
+
+
+def read_phases(path: Path) -> list[str]:
+    m = ENUM_RE.search(path.read_text(encoding="utf-8"))
+    if not m:
+        raise SystemExit(f"{path}: no PhaseProfPhase enum")
+    return [n.lower() for n in NAME_RE.findall(m.group(1)) if n != "COUNT"]
+
+
+def decode(data: bytes, phases: list[str]) -> tuple[dict, list[dict]]:
+    if len(data) < HEADER.size:
+        raise SystemExit("dump is smaller than the profile header")
+    magic, version, phase_count, record_size, window, capacity, head, count, seq = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        raise SystemExit(f"no profile in dump (magic {magic!r}); was it made by a PHASE_PROFILE build?")
+    if version != VERSION:
+        raise SystemExit(f"profile version {version}, this tool reads {VERSION}")
+    if phase_count != len(phases):
+        raise SystemExit(f"dump has {phase_count} phases, sources/phase_prof.h has {len(phases)}")
+
+    record = struct.Struct("<HBB" + "HHH" * phase_count)
+    if record.size != record_size:
+        raise SystemExit(f"record size {record_size}, expected {record.size}")
+
+    header = {"window": window, "capacity": capacity, "count": count, "seq": seq}
+    records = []
+    first = (head - count) % capacity if capacity else 0
+    for i in range(count):
+        offset = HEADER.size + ((first + i) % capacity) * record_size
+        if offset + record_size > len(data):
+            raise SystemExit("dump ends inside the record ring")
+        values = record.unpack_from(data, offset)
+        stats = {
+            name: tuple(values[3 + j * 3 : 6 + j * 3])
+            for j, name in enumerate(phases)
+        }
+        records.append({"seq": values[0], "frames": values[1], "lag": values[2], "phases": stats})
+    return header, records
+
+
+def pct(ticks: float) -> str:
+    return f"{100.0 * ticks * M_CYCLES_PER_TICK / FRAME_M_CYCLES:5.1f}%"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Decode the per-phase profile ring from an SRAM dump.")
+    parser.add_argument("sram", type=Path, help="SRAM dump (.sav)")
+    parser.add_argument("--offset", type=lambda v: int(v, 0), default=0, help="Byte offset of SRAM bank 0 in the dump")
+    parser.add_argument("--records", action="store_true", help="Also list every record")
+    parser.add_argument("--csv", action="store_true", help="Print CSV instead of a table")
+    args = parser.parse_args()
+
+    phases = read_phases(SOURCES / "phase_prof.h")
+    header, records = decode(args.sram.read_bytes()[args.offset :], phases)
+    if not records:
+        print("profile is empty")
+        return 0
+
+    frames = sum(r["frames"] for r in records)
+    summary = {}
+    for name in phases:
+        lo = min(r["phases"][name][0] for r in records)
+        avg = sum(r["phases"][name][1] * r["frames"] for r in records) / frames
+        hi = max(r["phases"][name][2] for r in records)
+        summary[name] = (lo, avg, hi)
+
+    if args.csv:
+        print("seq,frames,lag," + ",".join(f"{n}_min,{n}_avg,{n}_max" for n in phases))
+        rows = records if args.records else []
+        for r in rows:
+            cells = [str(r["seq"]), str(r["frames"]), str(r["lag"])]
+            for name in phases:
+                cells.extend(str(v) for v in r["phases"][name])
+            print(",".join(cells))
+        cells = ["all", str(frames), str(sum(r["lag"] for r in records))]
+        for name in phases:
+            lo, avg, hi = summary[name]
+            cells.extend((str(lo), f"{avg:.1f}", str(hi)))
+        print(",".join(cells))
+        return 0
+
+    print(
+        f"{len(records)} windows of {header['window']} frames (seq {records[0]['seq']}..{records[-1]['seq']}), "
+        f"{sum(r['lag'] for r in records)} lag frames; ticks are {M_CYCLES_PER_TICK} M-cycles, "
+        f"% of a {FRAME_M_CYCLES} M-cycle frame"
+    )
+    print(f"{'phase':<8} {'min':>6} {'avg':>8} {'max':>6} {'avg%':>7} {'max%':>7}")
+    for name in phases:
+        lo, avg, hi = summary[name]
+        print(f"{name:<8} {lo:>6} {avg:>8.1f} {hi:>6} {pct(avg):>7} {pct(hi):>7}")
+
+    worst = max((n for n in phases if n not in NOT_WORK_PHASES), key=lambda n: summary[n][2])
+    print(f"worst phase: {worst} ({summary[worst][2]} ticks, {pct(summary[worst][2]).strip()} of the frame)")
+
+    if args.records:
+        print()
+        print(f"{'seq':>5} {'lag':>3} " + " ".join(f"{n:>8}" for n in phases) + "   (max ticks)")
+        for r in records:
+            print(f"{r['seq']:>5} {r['lag']:>3} " + " ".join(f"{r['phases'][n][2]:>8}" for n in phases))
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,378 @@
+#!/usr/bin/env python3
+"""Encode one tile/attr map for all three tilemap decoders.
+
+Writes, into --out:
+
+  tilemap_comp_data.h   run-length groups + sum tree  (tilemap_comp.c)
+  tilemap_macro_data.h  3x3 macrotile id map          (tilemap_macro.c)
+  tilemap_quad_data.h   3x3 macrotiles in 4x4 quadtrees (tilemap_quad.c)
+  tilemap_suite_map.h   the raw map, used as the reference by tilemap_suite.c
+
+The map is either a raw file of (tile, attr) byte pairs in row-major order
+(--map FILE --width W) or a procedural platformer level (--seed N). The same
+map feeds every encoder, so the decoders can be checked against each other.
+
+The comp format stores tile ids only; attributes are not encoded.
+
+Limits come from the decoders: x and y are 8-bit, the comp tile index is
+16-bit, and macrotile ids are 8-bit (at most 256 distinct 3x3 blocks).
+"""
+
+from __future__ import annotations
+
+import argparse
+import random
+from dataclasses import dataclass, field
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+MACRO_SIDE = 3
+QUAD_ROOT_MACROS = 4
+QUAD_LEAF_FLAG = 0x8000
+COMP_MAX_RUN = 16
+
+
+@dataclass
+class TileMap:
+    width: int
+    height: int
+    tiles: list[int]
+    attrs: list[int]
+
+    def at(self, x: int, y: int) -> tuple[int, int]:
+        if x >= self.width or y >= self.height:
+            return (0, 0)
+        i = y * self.width + x
+        return (self.tiles[i], self.attrs[i])
+
+
+@dataclass
+class Encoded:
+    header: str
+    rom_bytes: int
+    stats: dict[str, int] = field(default_factory=dict)
+
+
+def c_array(ctype: str, name: str, values: list[int], per_row: int = 24) -> str:
+    if not values:
+        values = [0]
+    rows = []
+    for i in range(0, len(values), per_row):
+        rows.append("    " + ", ".join(str(v) for v in values[i : i + per_row]) + ",")
+    return f"static const {ctype} {name}[{len(values)}] = {{\n" + "\n".join(rows) + "\n};\n"
+
+
+def header(title: str, body: list[str]) -> str:
+    return "\n".join(["#pragma once", "", f"/* {title} Generated by tools/encode_tilemap.py. */", "",
+                      "#include <stdint.h>", ""] + body) + "\n"
+
+
+def check_limits(m: TileMap) -> None:
+    if not (1 <= m.width <= 255 and 1 <= m.height <= 255):
+        raise SystemExit(f"map is {m.width}x{m.height}; the decoders take 8-bit coordinates (max 255x255)")
+    if m.width * m.height > 0xFFFF:
+        raise SystemExit(f"map has {m.width * m.height} tiles; tilemap_comp indexes tiles with 16 bits")
+
+
+def generate_level(width: int, height: int, seed: int) -> TileMap:
+    """A side-scrolling level: sky, clouds, rolling ground, platforms and pits."""
+    rng = random.Random(seed)
+    tiles = [0] * (width * height)
+    attrs = [0] * (width * height)
+
+    def put(x: int, y: int, tile: int, attr: int) -> None:
+        if 0 <= x < width and 0 <= y < height:
+            tiles[y * width + x] = tile
+            attrs[y * width + x] = attr
+
+    for _ in range(width * height // 600):
+        cx, cy = rng.randrange(width), rng.randrange(height // 2)
+        for dx in range(rng.randint(3, 6)):
+            put(cx + dx, cy, 0x10 + (dx & 1), 0x01)
+
+    ground = height * 2 // 3
+    x = 0
+    while x < width:
+        span = rng.randint(6, 18)
+        if rng.random() < 0.15:
+            x += rng.randint(2, 4)
+            continue
+        ground = max(height // 3, min(height - 4, ground + rng.choice((-2, -1, 0, 0, 1, 2))))
+        for xx in range(x, min(width, x + span)):
+            put(xx, ground, 0x20, 0x02)
+            for yy in range(ground + 1, height):
+                put(xx, yy, 0x21 if (yy - ground) < 3 else 0x22, 0x02 if (yy - ground) < 3 else 0x03)
+        x += span
+
+    for _ in range(width * height // 400):
+        px, py = rng.randrange(width), rng.randrange(4, height - 8)
+        for dx in range(rng.randint(3, 8)):
+            put(px + dx, py, 0x30, 0x04)
+            put(px + dx, py + 1, 0x31, 0x24)
+
+    return TileMap(width, height, tiles, attrs)
+
+
+def load_raw(path: Path, width: int) -> TileMap:
+    data = path.read_bytes()
+    if width <= 0 or len(data) % (2 * width):
+        raise SystemExit(f"{path}: size {len(data)} is not a whole number of {width}-tile rows of (tile, attr) pairs")
+    height = len(data) // (2 * width)
+    return TileMap(width, height, list(data[0::2]), list(data[1::2]))
+
+
+def encode_comp(m: TileMap, side: int) -> Encoded:
+    group_w = -(-m.width // side)
+    group_h = -(-m.height // side)
+
+    groups = []
+    for gy in range(group_h):
+        for gx in range(group_w):
+            groups.append(tuple(m.at(gx * side + ox, gy * side + oy)[0] for oy in range(side) for ox in range(side)))
+
+    runs: list[tuple[tuple[int, ...], int]] = []
+    for g in groups:
+        if runs and runs[-1][0] == g and runs[-1][1] < COMP_MAX_RUN:
+            runs[-1] = (g, runs[-1][1] + 1)
+        else:
+            runs.append((g, 1))
+
+    depth = 1
+    while (1 << depth) < len(runs):
+        depth += 1
+    lens = [n for _, n in runs] + [0] * ((1 << depth) - len(runs))
+
+    levels: list[list[int]] = []
+    for level in range(depth):
+        span = 1 << (depth - level)
+        levels.append([sum(lens[p * span : (p + 1) * span]) for p in range(1 << level)])
+    bits = [max(1, max(values).bit_length()) for values in levels]
+    if max(bits) > 16:
+        raise SystemExit("tilemap_comp tree sums need more than 16 bits")
+
+    packed_levels = []
+    for values, width in zip(levels, bits):
+        acc = 0
+        for i, v in enumerate(values):
+            acc |= v << (i * width)
+        nbytes = -(-len(values) * width // 8) + 2
+        packed_levels.append(list(acc.to_bytes(nbytes, "little")))
+
+    run_bytes = [t for g, _ in runs for t in g]
+    len_bytes = []
+    for i in range(0, len(runs), 2):
+        lo = runs[i][1] - 1
+        hi = runs[i + 1][1] - 1 if i + 1 < len(runs) else 0
+        len_bytes.append(lo | (hi << 4))
+
+    body = [
+        f"#define TILEMAP_WIDTH {m.width}u",
+        f"#define TILEMAP_HEIGHT {m.height}u",
+        f"#define TILEMAP_TILE_COUNT {m.width * m.height}u",
+        f"#define TILEMAP_GROUP_SIDE {side}u",
+        f"#define TILEMAP_GROUP_SIZE {side * side}u",
+        f"#define TILEMAP_GROUP_WIDTH {group_w}u",
+        f"#define TILEMAP_RLE_RUN_COUNT {len(runs)}u",
+        f"#define TILEMAP_RLE_TREE_DEPTH {depth}u",
+        "",
+        c_array("uint8_t", "TILEMAP_RLE_GROUPS", run_bytes),
+        c_array("uint8_t", "TILEMAP_RLE_LENS", len_bytes),
+        c_array("uint8_t", "TILEMAP_RLE_TREE_LEVEL_BITS", bits),
+    ]
+    for level, data in enumerate(packed_levels):
+        body.append(c_array("uint8_t", f"TILEMAP_RLE_TREE_LEVEL_{level}", data))
+    body.append("static const uint8_t* const TILEMAP_RLE_TREE_LEVEL_PTRS[%d] = { %s };\n"
+                % (depth, ", ".join(f"TILEMAP_RLE_TREE_LEVEL_{i}" for i in range(depth))))
+
+    rom = len(run_bytes) + len(len_bytes) + len(bits) + sum(len(d) for d in packed_levels) + 2 * depth
+    body.append(f"#define TILEMAP_COMP_ROM_BYTES {rom}u")
+    return Encoded(header("tilemap_comp data.", body), rom,
+                   {"groups": len(groups), "runs": len(runs), "tree_depth": depth})
+
+
+def macro_grid(m: TileMap) -> tuple[int, int, list[int], list[tuple[tuple[int, int], ...]]]:
+    mw = -(-m.width // MACRO_SIDE)
+    mh = -(-m.height // MACRO_SIDE)
+    ids: dict[tuple[tuple[int, int], ...], int] = {}
+    order: list[tuple[tuple[int, int], ...]] = []
+    grid = []
+    for my in range(mh):
+        for mx in range(mw):
+            cells = tuple(m.at(mx * MACRO_SIDE + ox, my * MACRO_SIDE + oy)
+                          for oy in range(MACRO_SIDE) for ox in range(MACRO_SIDE))
+            if cells not in ids:
+                ids[cells] = len(order)
+                order.append(cells)
+            grid.append(ids[cells])
+    if len(order) > 256:
+        raise SystemExit(f"map has {len(order)} distinct 3x3 macrotiles; macrotile ids are 8-bit (max 256)")
+    return mw, mh, grid, order
+
+
+def coord_tables(prefix: str) -> list[str]:
+    return [
+        c_array("uint8_t", f"{prefix}_X_TO_MX", [x // MACRO_SIDE for x in range(256)]),
+        c_array("uint8_t", f"{prefix}_X_TO_OX", [x % MACRO_SIDE for x in range(256)]),
+        c_array("uint8_t", f"{prefix}_Y_TO_MY", [y // MACRO_SIDE for y in range(256)]),
+        c_array("uint8_t", f"{prefix}_Y_TO_OY", [y % MACRO_SIDE for y in range(256)]),
+    ]
+
+
+def encode_macro(m: TileMap) -> Encoded:
+    mw, mh, grid, macros = macro_grid(m)
+    tile_ids = [t for cells in macros for t, _ in cells]
+    tile_attrs = [a for cells in macros for _, a in cells]
+    row_off = [my * mw for my in range(mh)]
+
+    body = [
+        f"#define TILEMAP_MACRO_GROUP_SIDE {MACRO_SIDE}u",
+        f"#define TILEMAP_MACRO_WIDTH {mw}u",
+        f"#define TILEMAP_MACRO_HEIGHT {mh}u",
+        f"#define TILEMAP_MACRO_COUNT {len(macros)}u",
+        "",
+        *coord_tables("TILEMAP_MACRO"),
+        c_array("uint16_t", "TILEMAP_MACRO_MY_TO_ROW_OFF", row_off),
+        c_array("uint8_t", "TILEMAP_MACRO_ID_MAP", grid),
+        c_array("uint8_t", "MACROTILES_IDS", tile_ids),
+        c_array("uint8_t", "MACROTILES_ATTRS", tile_attrs),
+    ]
+    rom = 4 * 256 + 2 * len(row_off) + len(grid) + len(tile_ids) + len(tile_attrs)
+    body.append(f"#define TILEMAP_MACRO_ROM_BYTES {rom}u")
+    return Encoded(header("tilemap_macro data.", body), rom, {"macrotiles": len(macros), "id_map": len(grid)})
+
+
+def encode_quad(m: TileMap) -> Encoded:
+    mw, mh, grid, macros = macro_grid(m)
+
+    # One guard macro column and row: next_right/next_down step past the last
+    # tile they return, so the root under mx == mw / my == mh must exist.
+    root_w = -(-(mw + 1) // QUAD_ROOT_MACROS)
+    root_h = -(-(mh + 1) // QUAD_ROOT_MACROS)
+
+    def macro_at(mx: int, my: int) -> int:
+        return grid[my * mw + mx] if mx < mw and my < mh else 0
+
+    def uniform(x0: int, y0: int, size: int) -> int | None:
+        first = macro_at(x0, y0)
+        for yy in range(y0, y0 + size):
+            for xx in range(x0, x0 + size):
+                if macro_at(xx, yy) != first:
+                    return None
+        return first
+
+    desc0: list[int] = []
+    desc1: list[int] = []
+    leaf0: list[int] = []
+    leaf1: list[int] = []
+    leaf2: list[int] = []
+    for ry in range(root_h):
+        for rx in range(root_w):
+            x0, y0 = rx * 4, ry * 4
+            u = uniform(x0, y0, 4)
+            if u is not None:
+                desc0.append(QUAD_LEAF_FLAG | len(leaf0))
+                leaf0.append(u)
+                continue
+            desc0.append(len(desc1))
+            children = []
+            for child in range(4):
+                cx, cy = x0 + (child & 1) * 2, y0 + (child >> 1) * 2
+                u = uniform(cx, cy, 2)
+                if u is not None:
+                    children.append(QUAD_LEAF_FLAG | len(leaf1))
+                    leaf1.append(u)
+                else:
+                    children.append(len(leaf2))
+                    leaf2.extend(macro_at(cx + (k & 1), cy + (k >> 1)) for k in range(4))
+            desc1.extend(children)
+    if max(len(desc1), len(leaf0), len(leaf1), len(leaf2)) >= QUAD_LEAF_FLAG:
+        raise SystemExit("quadtree node tables overflow the 15-bit descriptor index")
+
+    log2 = root_w.bit_length() - 1 if root_w & (root_w - 1) == 0 else 255
+    macro_bytes = [b for cells in macros for t, a in cells for b in (t, a)]
+
+    body = [
+        f"#define TILEMAP_QUAD_GROUP_SIDE {MACRO_SIDE}u",
+        "#define TILEMAP_QUAD_STACK_DEPTH 3u",
+        f"#define TILEMAP_QUAD_SUBTREE_W {root_w}u",
+        f"#define TILEMAP_QUAD_SUBTREE_W_LOG2 {log2}",
+        "#define TILEMAP_QUAD_ENTRY_TILE_OFF 0u",
+        "#define TILEMAP_QUAD_ENTRY_ATTR_OFF 1u",
+        f"#define TILEMAP_QUAD_COUNT {len(macros)}u",
+        "",
+        *coord_tables("TILEMAP_QUAD"),
+        c_array("uint16_t", "TILEMAP_QUAD_NODE_DESC_0", desc0),
+        c_array("uint16_t", "TILEMAP_QUAD_NODE_DESC_1", desc1),
+        "static const uint16_t* const TILEMAP_QUAD_NODE_DESC_PTRS[2] = { TILEMAP_QUAD_NODE_DESC_0, TILEMAP_QUAD_NODE_DESC_1 };\n",
+        c_array("uint8_t", "TILEMAP_QUAD_LEAF_TILES_0", leaf0),
+        c_array("uint8_t", "TILEMAP_QUAD_LEAF_TILES_1", leaf1),
+        c_array("uint8_t", "TILEMAP_QUAD_LEAF_TILES_2", leaf2),
+        "static const uint8_t* const TILEMAP_QUAD_LEAF_TILES_PTRS[3] = "
+        "{ TILEMAP_QUAD_LEAF_TILES_0, TILEMAP_QUAD_LEAF_TILES_1, TILEMAP_QUAD_LEAF_TILES_2 };\n",
+        c_array("uint8_t", "MACROTILES", macro_bytes),
+    ]
+    pointer_tables = 2 * (2 + 3)
+    rom = 4 * 256 + 2 * (len(desc0) + len(desc1)) + len(leaf0) + len(leaf1) + len(leaf2) + len(macro_bytes) + pointer_tables
+    body.append(f"#define TILEMAP_QUAD_ROM_BYTES {rom}u")
+    return Encoded(header("tilemap_quad data.", body), rom,
+                   {"roots": len(desc0), "leaf4x4": len(leaf0), "leaf2x2": len(leaf1), "split2x2": len(leaf2) // 4})
+
+
+def encode_reference(m: TileMap) -> str:
+    return header("Reference map for tilemap_suite.c.", [
+        f"#define TILEMAP_SUITE_W {m.width}u",
+        f"#define TILEMAP_SUITE_H {m.height}u",
+        "",
+        c_array("uint8_t", "TILEMAP_SUITE_TILES", m.tiles),
+        c_array("uint8_t", "TILEMAP_SUITE_ATTRS", m.attrs),
+    ])
+
+
+def encode_all(m: TileMap, out: Path, comp_side: int) -> dict[str, Encoded]:
+    check_limits(m)
+    out.mkdir(parents=True, exist_ok=True)
+    encoded = {
+        "comp": encode_comp(m, comp_side),
+        "macro": encode_macro(m),
+        "quad": encode_quad(m),
+    }
+    for name, enc in encoded.items():
+        (out / f"tilemap_{name}_data.h").write_text(enc.header, encoding="utf-8")
+    (out / "tilemap_suite_map.h").write_text(encode_reference(m), encoding="utf-8")
+    return encoded
+
+
+def add_map_arguments(parser: argparse.ArgumentParser) -> None:
+    parser.add_argument("--map", type=Path, help="Raw map: (tile, attr) byte pairs, row-major")
+    parser.add_argument("--width", type=int, default=240, help="Map width in tiles (default: 240)")
+    parser.add_argument("--height", type=int, default=240, help="Generated map height in tiles (default: 240)")
+    parser.add_argument("--seed", type=int, default=1, help="Seed for the generated level (default: 1)")
+    parser.add_argument("--comp-side", type=int, default=4, help="tilemap_comp group side in tiles (default: 4)")
+
+
+def map_from_args(args: argparse.Namespace) -> TileMap:
+    if args.map:
+        return load_raw(args.map, args.width)
+    return generate_level(args.width, args.height, args.seed)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Encode one map for the comp, macro and quad tilemap decoders.")
+    add_map_arguments(parser)
+    parser.add_argument("--out", type=Path, default=ROOT / "build" / "tilemap_suite",
+                        help="Output directory (default: build/tilemap_suite)")
+    args = parser.parse_args()
+
+    m = map_from_args(args)
+    encoded = encode_all(m, args.out, args.comp_side)
+    print(f"{m.width}x{m.height} map -> {args.out}")
+    for name, enc in encoded.items():
+        stats = ", ".join(f"{k} {v}" for k, v in enc.stats.items())
+        print(f"  {name:<6} {enc.rom_bytes:>7} ROM bytes  ({stats})")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""Turn a frozen flight-recorder window from an SRAM dump into an input trace.
+
+A FLIGHT_RECORDER build (see sources/flight_rec.h) keeps the last
+FLIGHT_REC_FRAMES frames in SRAM bank 1. Each entry holds the frame number,
+the joypad byte read that frame, PREV_JOY, the VBlanks missed during the frame,
+LY at frame_submit(), the per-phase TIMA ticks (PHASE_PROFILE builds only) and
+the Player, Camera and Map state at the start of the frame. The window freezes
+on the first frame that misses a VBlank.
+
+Every FLIGHT_REC_FRAMES / 2 frames the recorder also stores a keyframe of the
+rest of the simulation in one of two slots after the window: the actor pools,
+the broadphase order, the map-object spawn state, the sfx channels and the
+speed governor (builds without ACTORS store empty actor, broadphase and
+map-object blobs). The two slots alternate, so one of them is always inside the
+window; the trace starts at the oldest keyframe in the window and carries its
+blobs as hex in "start" (host_game loads them with the *_load functions):
+
+    {"start": {"frame": 16, "prev_joy": 0, "player": {...}, "camera": {...},
+               "map": {...}, "keyframe": {"actors": "...", ...}},
+     "joypad": [16, 16, 48, ...], "drop_index": 11, "frames": [...]}
+
+Replaying the joypad bytes from that state reproduces the simulation exactly.
+What is not recorded only changes how long the first replayed frames take,
+not what they compute: the OAM placement cache and player sprite-stream
+slots, VBlank strips still queued at the keyframe, VRAM contents, the music
+driver position, and where the timer ISR's sfx ticks fall inside a frame.
+If no keyframe is inside the window the trace starts at the oldest entry with
+"keyframe": null and is approximate for actors, objects and sound.
+
+Struct layouts are read from the sources (SDCC packs structs, little-endian)
+and checked against the sizes the firmware stored in the header. --joy also
+writes the joypad bytes as a raw one-byte-per-frame file for emulator input
+playback.
+
+Usage:
+    tools/flight_trace.py game.sav -o drop.json --joy drop.joy
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+import struct
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+MAGIC = b"FREC"
+VERSION = 2
+SRAM_BANK_SIZE = 0x2000
+SRAM_BANK = 1
+KEYFRAMES = 2
+HEADER = struct.Struct(f"<4sBBBBBBBBBBH{KEYFRAMES}H{KEYFRAMES}BBHBBB")
+KEYFRAME_PARTS = ("actors", "broadphase", "map_objects", "sfx", "speed_gov")
+ENTRY_HEAD = struct.Struct("<HBBBB")
+
+SCALARS = {"INT8": "b", "UINT8": "B", "BOOLEAN": "B", "INT16": "h", "UINT16": "H", "INT32": "i", "UINT32": "I"}
+STRUCT_RE = re.compile(r"typedef struct\s*\w*\s*\{(.*?)\}\s*(\w+)\s*;", re.DOTALL)
+FIELD_RE = re.compile(r"^\s*(\w+)\s+(\w+)\s*;", re.MULTILINE)
+ENUM_RE = re.compile(r"typedef enum PhaseProfPhase \{(.*?)\} PhaseProfPhase;", re.DOTALL)
+
+
+def read_structs(*paths: Path) -> dict[str, list[tuple[str, str]]]:
+    structs: dict[str, list[tuple[str, str]]] = {}
+    for path in paths:
+        for body, name in STRUCT_RE.findall(path.read_text(encoding="utf-8")):
+            structs[name] = [(ctype, field) for ctype, field in FIELD_RE.findall(body)]
+    return structs
+
+
+def layout(name: str, structs: dict) -> list[tuple[str, str]]:
+    out = []
+    for ctype, field in structs[name]:
+        if ctype in SCALARS:
+            out.append((field, SCALARS[ctype]))
+        elif ctype in structs:
+            out.extend((f"{field}.{sub}", fmt) for sub, fmt in layout(ctype, structs))
+        else:
+            raise SystemExit(f"{name}.{field}: unknown type {ctype}")
+    return out
+
+
+def unpack(fields: list[tuple[str, str]], data: bytes) -> dict:
+    values = struct.unpack("<" + "".join(f for _n, f in fields), data)
+    out: dict = {}
+    for (name, _f), value in zip(fields, values):
+        node = out
+        *parents, leaf = name.split(".")
+        for p in parents:
+            node = node.setdefault(p, {})
+        node[leaf] = value
+    return out
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Extract a replayable input trace from a flight-recorder SRAM dump.")
+    parser.add_argument("sram", type=Path, help="SRAM dump (.sav)")
+    parser.add_argument(
+        "--offset",
+        type=lambda v: int(v, 0),
+        default=SRAM_BANK * SRAM_BANK_SIZE,
+        help="Byte offset of the recorder bank in the dump (default: bank 1, 0x2000)",
+    )
+    parser.add_argument("-o", "--out", type=Path, help="Write the JSON trace here (default: stdout)")
+    parser.add_argument("--joy", type=Path, help="Also write the raw joypad bytes, one per frame")
+    args = parser.parse_args()
+
+    data = args.sram.read_bytes()[args.offset :]
+    if len(data) < HEADER.size:
+        raise SystemExit("dump is smaller than the recorder header")
+    fields = HEADER.unpack_from(data)
+    magic, version, capacity, entry_size, player_size, camera_size, map_size, phase_count, frozen, head, count = fields[:11]
+    keyframe_frames = fields[12 : 12 + KEYFRAMES]
+    keyframe_valid = fields[12 + KEYFRAMES : 12 + 2 * KEYFRAMES]
+    sfx_size, actor_size, broadphase_size, map_objects_size, speed_gov_size = fields[12 + 2 * KEYFRAMES :]
+    if magic != MAGIC:
+        raise SystemExit(f"no flight recorder in dump at offset {args.offset:#x} (magic {magic!r})")
+    if version != VERSION:
+        raise SystemExit(f"recorder version {version}, this tool reads {VERSION}")
+
+    structs = read_structs(SOURCES / "anim.h", SOURCES / "player.h", SOURCES / "camera.h", SOURCES / "map.h")
+    player = layout("Player", structs)
+    camera = layout("Camera", structs)
+    map_fields = layout("Map", structs)
+    for name, fields, size in (("Player", player, player_size), ("Camera", camera, camera_size), ("Map", map_fields, map_size)):
+        if struct.calcsize("<" + "".join(f for _n, f in fields)) != size:
+            raise SystemExit(f"{name} is {size} bytes in the dump; the sources no longer match that build")
+    m = ENUM_RE.search((SOURCES / "phase_prof.h").read_text(encoding="utf-8"))
+    phases = [n.lower() for n in re.findall(r"PHASE_PROF_(\w+)", m.group(1)) if n != "COUNT"] if m else []
+    if len(phases) != phase_count:
+        raise SystemExit(f"dump has {phase_count} phases, sources/phase_prof.h has {len(phases)}")
+
+    expected = ENTRY_HEAD.size + 2 * phase_count + player_size + camera_size + map_size
+    if expected != entry_size:
+        raise SystemExit(f"entry size {entry_size}, expected {expected}")
+    if not frozen:
+        print("warning: window is not frozen; no dropped frame was recorded yet")
+
+    frames = []
+    first = (head - count) % capacity
+    for i in range(count):
+        offset = HEADER.size + ((first + i) % capacity) * entry_size
+        raw = data[offset : offset + entry_size]
+        if len(raw) < entry_size:
+            raise SystemExit("dump ends inside the recorder window")
+        frame, joy, prev_joy, lag, submit_ly = ENTRY_HEAD.unpack_from(raw)
+        pos = ENTRY_HEAD.size
+        ticks = struct.unpack_from(f"<{phase_count}H", raw, pos)
+        pos += 2 * phase_count
+        state = {}
+        for key, fields, size in (("player", player, player_size), ("camera", camera, camera_size), ("map", map_fields, map_size)):
+            state[key] = unpack(fields, raw[pos : pos + size])
+            pos += size
+        frames.append(
+            {
+                "frame": frame,
+                "joy": joy,
+                "prev_joy": prev_joy,
+                "lag": lag,
+                "submit_ly": submit_ly,
+                "phase_ticks": dict(zip(phases, ticks)),
+                **state,
+            }
+        )
+
+    if not frames:
+        raise SystemExit("recorder window is empty")
+
+    sizes = (actor_size, broadphase_size, map_objects_size, sfx_size, speed_gov_size)
+    keyframe_base = HEADER.size + capacity * entry_size
+    index_of = {f["frame"]: i for i, f in enumerate(frames)}
+    usable = [s for s in range(KEYFRAMES) if keyframe_valid[s] and keyframe_frames[s] in index_of]
+    keyframe = None
+    first_index = 0
+    if usable:
+        slot = min(usable, key=lambda s: index_of[keyframe_frames[s]])
+        first_index = index_of[keyframe_frames[slot]]
+        pos = keyframe_base + slot * sum(sizes)
+        if pos + sum(sizes) > len(data):
+            raise SystemExit("dump ends inside the keyframe slots")
+        keyframe = {}
+        for part, size in zip(KEYFRAME_PARTS, sizes):
+            keyframe[part] = data[pos : pos + size].hex()
+            pos += size
+    else:
+        print("warning: no keyframe inside the window; actors, objects and sound start from power-on state")
+    frames = frames[first_index:]
+
+    drop_index = next((i for i, f in enumerate(frames) if f["lag"]), None)
+    start = frames[0]
+    trace = {
+        "start": {
+            "frame": start["frame"],
+            "prev_joy": start["prev_joy"],
+            **{k: start[k] for k in ("player", "camera", "map")},
+            "keyframe": keyframe,
+        },
+        "joypad": [f["joy"] for f in frames],
+        "drop_index": drop_index,
+        "frames": frames,
+    }
+
+    text = json.dumps(trace, indent=1)
+    if args.out:
+        args.out.write_text(text + "\n", encoding="utf-8")
+    else:
+        print(text)
+    if args.joy:
+        args.joy.write_bytes(bytes(trace["joypad"]))
+
+    if args.out:
+        summary = f"Wrote {args.out}: {len(frames)} frames from frame {start['frame']}"
+        if drop_index is not None:
+            d = frames[drop_index]
+            summary += f", drop at index {drop_index} (frame {d['frame']}, {d['lag']} VBlank(s) missed, submit LY {d['submit_ly']})"
+        print(summary)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
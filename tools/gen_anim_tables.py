@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""Generate the shared animation step tables used by the player and actors.
+
+Clips are described in tools/anim_clips.json, in clip id order:
+
+    "player_run": {"frames": {"count": "RUN_FRAMES_PER_DIR"}, "duration": "RUN_ANIM_SPEED"}
+    "walker":     {"frames": [0, 1, 2, 3], "duration": 8, "end": "loop"}
+
+- `frames` is a list of frame numbers, or {"count": N, "start": S} for
+  S, S+1, .. N-1, 0, .. S-1 (a looped run of N frames entered at S);
+- `duration` (frames per step) is a number, a list with one value per step,
+  or a #define from sources/player.h;
+- `end` is "loop" (default), "hold" (stay on the last step) or the name of the
+  clip to continue with.
+
+All clips are flattened into one step array. ANIM_NEXT[step] is the step that
+follows once ANIM_DURATION[step] frames have elapsed, so advancing any clip is
+a single table-indexed step with no per-state branches (see ANIM_TICK in
+sources/anim.h). The player clips come first so their ids line up with the
+PLAYER_FRAME_STATE_* rows of the compiled metasprite table.
+
+Output: sources/anim_data.h
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+DEFINE_RE = re.compile(r"^#define\s+(\w+)\s+(\d+)\s*$", re.MULTILINE)
+
+
+def resolve(value: int | str, defines: dict[str, int], what: str) -> int:
+    if isinstance(value, int):
+        return value
+    if value not in defines:
+        raise SystemExit(f"{what}: unknown constant '{value}'")
+    return defines[value]
+
+
+def clip_frames(spec: dict, defines: dict[str, int], name: str) -> list[int]:
+    frames = spec["frames"]
+    if isinstance(frames, list):
+        return [int(f) for f in frames]
+    count = resolve(frames["count"], defines, name)
+    start = int(frames.get("start", 0))
+    return [(start + i) % count for i in range(count)]
+
+
+def c_array(name: str, values: list[int]) -> str:
+    rows = []
+    for i in range(0, len(values), 16):
+        rows.append("    " + ", ".join(str(v) for v in values[i : i + 16]) + ",")
+    return f"static const UINT8 {name}[{len(values)}] = {{\n" + "\n".join(rows) + "\n};\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Generate animation step tables.")
+    parser.add_argument(
+        "--clips",
+        type=Path,
+        default=ROOT / "tools" / "anim_clips.json",
+        help="Clip description (default: tools/anim_clips.json)",
+    )
+    parser.add_argument(
+        "--out",
+        type=Path,
+        default=SOURCES / "anim_data.h",
+        help="Output header (default: sources/anim_data.h)",
+    )
+    args = parser.parse_args()
+
+    defines = {k: int(v) for k, v in DEFINE_RE.findall((SOURCES / "player.h").read_text(encoding="utf-8"))}
+    clips: dict[str, dict] = json.loads(args.clips.read_text(encoding="utf-8"))
+
+    starts: dict[str, int] = {}
+    frames: list[int] = []
+    durations: list[int] = []
+    ends: list[tuple[str, int, int]] = []
+
+    for name, spec in clips.items():
+        steps = clip_frames(spec, defines, name)
+        if not steps:
+            raise SystemExit(f"{name}: no frames")
+        dur = spec["duration"]
+        dur_list = [resolve(d, defines, name) for d in dur] if isinstance(dur, list) else [resolve(dur, defines, name)] * len(steps)
+        if len(dur_list) != len(steps) or not all(1 <= d <= 255 for d in dur_list):
+            raise SystemExit(f"{name}: need one duration in 1..255 per frame")
+
+        starts[name] = len(frames)
+        frames.extend(steps)
+        durations.extend(dur_list)
+        ends.append((spec.get("end", "loop"), starts[name], len(frames) - 1))
+
+    if len(frames) > 255:
+        raise SystemExit(f"{len(frames)} steps; steps are UINT8")
+
+    nxt = list(range(1, len(frames) + 1))
+    for (end, first, last), name in zip(ends, clips):
+        if end == "loop":
+            nxt[last] = first
+        elif end == "hold":
+            nxt[last] = last
+        elif end in starts:
+            nxt[last] = starts[end]
+        else:
+            raise SystemExit(f"{name}: unknown end '{end}'")
+
+    out = ["#pragma once", "", '#include "game_types.h"', ""]
+    for i, name in enumerate(clips):
+        out.append(f"#define ANIM_CLIP_{name.upper()} {i}")
+    out.append(f"#define ANIM_CLIP_COUNT {len(clips)}")
+    out.append(f"#define ANIM_STEP_COUNT {len(frames)}")
+    out.append("")
+    out.append(c_array("ANIM_CLIP_START", list(starts.values())))
+    out.append(c_array("ANIM_FRAME", frames))
+    out.append(c_array("ANIM_DURATION", durations))
+    out.append(c_array("ANIM_NEXT", nxt))
+
+    args.out.write_text("\n".join(out).rstrip("\n") + "\n", encoding="utf-8")
+    print(f"Wrote {args.out} ({len(clips)} clips, {len(frames)} steps)")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Generate the camera easing tables used by camera_update().
+
+The camera eases between the two lookahead offsets by advancing `progress_x`
+by CAMERA_MOVE_FRAMES per frame up to EASE_DURATION. Reversing mid-move sets
+progress to EASE_DURATION - progress, so every reachable progress value is a
+multiple of gcd(CAMERA_MOVE_FRAMES, EASE_DURATION). This script tabulates
+`ease_in_out(t) >> 1` for each of those steps, plus the final offsets for the
+full +/- (2 * CAMERA_LOOKAHEAD) move, so the runtime needs no multiply in the
+common case.
+
+Constants are read from sources/camera.h and sources/camera.c so the tables
+stay in sync with the code. Output: sources/camera_ease_data.h
+"""
+
+from __future__ import annotations
+
+import argparse
+import math
+import re
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+DEFINE_RE = re.compile(r"^#define\s+(\w+)\s+(.+?)\s*$", re.MULTILINE)
+
+
+def read_defines(*paths: Path) -> dict[str, int]:
+    raw: dict[str, str] = {}
+    for path in paths:
+        for name, value in DEFINE_RE.findall(path.read_text(encoding="utf-8")):
+            raw[name] = value
+
+    resolved: dict[str, int] = {}
+
+    def resolve(name: str) -> int:
+        if name in resolved:
+            return resolved[name]
+        expr = raw[name]
+        expr = re.sub(r"(\d+)u\b", r"\1", expr)
+        expr = re.sub(r"\b[A-Z_][A-Z0-9_]*\b", lambda m: str(resolve(m.group(0))), expr)
+        resolved[name] = int(eval(expr, {"__builtins__": {}}))
+        return resolved[name]
+
+    return {name: resolve(name) for name in ("EASE_DURATION", "CAMERA_MOVE_FRAMES", "CAMERA_LOOKAHEAD")}
+
+
+def ease_in_out(t: int, duration: int) -> int:
+    if t < duration // 2:
+        return ((t * t) & 0xFFFF) >> 6
+    t_inv = duration - t
+    return ((duration << 1) - (((t_inv * t_inv) & 0xFFFF) >> 6)) & 0xFFFF
+
+
+def c_array(ctype: str, name: str, values: list[int]) -> str:
+    rows = []
+    for i in range(0, len(values), 16):
+        rows.append("    " + ", ".join(str(v) for v in values[i : i + 16]) + ",")
+    return f"static const {ctype} {name}[{len(values)}] = {{\n" + "\n".join(rows) + "\n};\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Generate camera easing tables.")
+    parser.add_argument(
+        "--out",
+        type=Path,
+        default=SOURCES / "camera_ease_data.h",
+        help="Output header (default: sources/camera_ease_data.h)",
+    )
+    args = parser.parse_args()
+
+    d = read_defines(SOURCES / "camera.h", SOURCES / "camera.c")
+    duration = d["EASE_DURATION"]
+    step = math.gcd(d["CAMERA_MOVE_FRAMES"], duration)
+    if step & (step - 1):
+        raise SystemExit(f"gcd(CAMERA_MOVE_FRAMES, EASE_DURATION) = {step} is not a power of two")
+    shift = step.bit_length() - 1
+    full = 2 * d["CAMERA_LOOKAHEAD"]
+
+    eased = [ease_in_out(t, duration) >> 1 for t in range(0, duration, step)]
+    pos = [(full * e) >> 8 for e in eased]
+    neg = [(-full * e) >> 8 for e in eased]
+
+    if max(eased) * full > 0x7FFF:
+        raise SystemExit("move distance * eased no longer fits in INT16")
+
+    out = [
+        "#pragma once",
+        "",
+        '#include "game_types.h"',
+        "",
+        f"#define CAMERA_EASE_STEP_SHIFT {shift}",
+        f"#define CAMERA_EASE_STEPS {len(eased)}",
+        f"#define CAMERA_EASE_FULL_DISTANCE {full}",
+        "",
+        c_array("UINT16", "CAMERA_EASE_TABLE", eased),
+        c_array("INT8", "CAMERA_EASE_OFFSET_POS", pos),
+        c_array("INT8", "CAMERA_EASE_OFFSET_NEG", neg),
+    ]
+    args.out.write_text("\n".join(out).rstrip("\n") + "\n", encoding="utf-8")
+    print(f"Wrote {args.out} ({len(eased)} steps of {step})")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
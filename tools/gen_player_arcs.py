@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Generate per-frame vertical displacement tables for player jumps and falls.
+
+player_update() integrates y_speed_fp in 8.8 fixed point. Every airborne
+sequence that starts from a jump or from speed 0 is fully determined by the
+PLAYER_JUMP_INIT_SPEED_FP_*, PLAYER_GRAVITY_ACCEL_FP_* and
+PLAYER_MAX_FALL_SPEED_FP_* constants, so it can be tabulated:
+
+- rise arcs hold the (negative) displacement for each frame while the upward
+  speed is still >= 0; once the table is exhausted the player starts falling,
+  exactly like player_check_start_falling().
+- fall arcs hold the displacement for each frame starting from speed 0, and
+  the last entry (terminal velocity) repeats.
+
+An early release of the jump button or a head bump restarts the fall arc at
+index 0, which is also speed 0 in the integrator.
+
+Constants are read from sources/player.h. Output: sources/player_arc_data.h
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = ROOT / "sources"
+
+DEFINE_RE = re.compile(r"^#define\s+(\w+)\s+(.+?)\s*$", re.MULTILINE)
+
+MEDIA = ("NORMAL", "WATER")
+
+
+def read_defines(path: Path) -> dict[str, int]:
+    raw = dict(DEFINE_RE.findall(path.read_text(encoding="utf-8")))
+    resolved: dict[str, int] = {}
+
+    def resolve(name: str) -> int:
+        if name not in resolved:
+            expr = raw[name]
+            expr = re.sub(r"\((?:INT16|UINT16|INT8|UINT8)\)", "", expr)
+            expr = re.sub(r"(\d+)u\b", r"\1", expr)
+            expr = re.sub(r"\b[A-Z_][A-Z0-9_]*\b", lambda m: str(resolve(m.group(0))), expr)
+            resolved[name] = int(eval(expr, {"__builtins__": {}}))
+        return resolved[name]
+
+    out = {}
+    for medium in MEDIA:
+        for key in ("JUMP_INIT_SPEED_FP", "GRAVITY_ACCEL_FP", "MAX_FALL_SPEED_FP"):
+            name = f"PLAYER_{key}_{medium}"
+            out[name] = resolve(name)
+    return out
+
+
+def rise_arc(init_speed: int, gravity: int) -> list[int]:
+    out = []
+    speed = init_speed
+    while speed >= 0:
+        out.append(-speed)
+        speed -= gravity
+    return out
+
+
+def fall_arc(gravity: int, max_speed: int) -> list[int]:
+    out = []
+    speed = 0
+    while True:
+        out.append(speed)
+        if speed >= max_speed:
+            return out
+        speed = min(speed + gravity, max_speed)
+
+
+def c_array(name: str, values: list[int]) -> str:
+    rows = []
+    for i in range(0, len(values), 12):
+        rows.append("    " + ", ".join(str(v) for v in values[i : i + 12]) + ",")
+    return f"static const INT16 {name}[{len(values)}] = {{\n" + "\n".join(rows) + "\n};\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Generate player jump/fall displacement tables.")
+    parser.add_argument(
+        "--out",
+        type=Path,
+        default=SOURCES / "player_arc_data.h",
+        help="Output header (default: sources/player_arc_data.h)",
+    )
+    args = parser.parse_args()
+
+    d = read_defines(SOURCES / "player.h")
+
+    arcs: list[tuple[str, list[int], int]] = []
+    for medium in MEDIA:
+        rise = rise_arc(d[f"PLAYER_JUMP_INIT_SPEED_FP_{medium}"], d[f"PLAYER_GRAVITY_ACCEL_FP_{medium}"])
+        arcs.append((f"PLAYER_ARC_RISE_{medium}", rise, len(rise)))
+    for medium in MEDIA:
+        fall = fall_arc(d[f"PLAYER_GRAVITY_ACCEL_FP_{medium}"], d[f"PLAYER_MAX_FALL_SPEED_FP_{medium}"])
+        arcs.append((f"PLAYER_ARC_FALL_{medium}", fall, len(fall) - 1))
+
+    for name, values, limit in arcs:
+        if len(values) > 255 or limit > 255:
+            raise SystemExit(f"{name} has {len(values)} frames; arc steps are UINT8")
+
+    out = ["#pragma once", "", '#include "game_types.h"', ""]
+    for name, values, _limit in arcs:
+        out.append(c_array(name, values))
+    out.append("static const INT16* const PLAYER_ARC_TABLES[4] = {")
+    out.extend(f"    {name}," for name, _v, _l in arcs)
+    out.append("};")
+    out.append("")
+    out.append("static const UINT8 PLAYER_ARC_STEP_LIMIT[4] = {")
+    out.append("    " + ", ".join(str(limit) for _n, _v, limit in arcs) + ",")
+    out.append("};")
+
+    args.out.write_text("\n".join(out) + "\n", encoding="utf-8")
+    print(f"Wrote {args.out} ({', '.join(f'{n}={len(v)}' for n, v, _l in arcs)})")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
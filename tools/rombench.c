@@ -0,0 +1,1375 @@
+/*
+ * Headless ROM benchmark: boots a built .gbc in an embedded SM83 / CGB core,
+ * feeds a joypad trace and measures exact cycles per frame and per symbol.
+ *
+ * CPU memory accesses are timed per M-cycle, as are the timer (DIV falling
+ * edge, with the one M-cycle TIMA reload delay), LY / STAT / VBlank, OAM DMA,
+ * CGB general and HBlank HDMA and the KEY1 double-speed switch. Pixels are
+ * not rendered, so mode 3 is a model: 172 dots plus SCX & 7, 6 for a window
+ * on the line and the Pan Docs object penalties for the first ten objects on
+ * the line, taken from the registers at the start of mode 3. Object
+ * penalties over window tiles and mid-line register writes are not modelled,
+ * so HBlank starts and HDMA blocks can be off by a few dots on such lines.
+ *
+ * --test runs a test ROM that reports over the serial port (Blargg's
+ * cpu_instrs, instr_timing, mem_timing) until it prints "Passed" or "Failed";
+ * the exit status is 0 only for "Passed". Run it on instr_timing.gb and
+ * mem_timing.gb after changing the core; the ROMs are not distributed here.
+ *
+ * All cycle figures are normal-speed T-cycles (PPU dots), so one frame is
+ * 70224 whatever the CPU speed; in double speed an M-cycle costs 2.
+ *
+ * A frame runs from the return of the frame marker (default _wait_vbl_done)
+ * to its next entry: the main loop's work plus every interrupt handler that
+ * preempted it. Handlers that run while the main loop waits inside the
+ * marker (the VBlank strip commit, OAM DMA, sprite uploads, music) are
+ * charged to the frame that just entered it, whose work they finish; the
+ * marker_isr_cycles column shows that share. The joypad byte for frame k is
+ * trace[k]. Frame 0 includes the boot and is not gated. The exit status is
+ * 1 if any later frame is over --budget or missed a VBlank, so the tool can
+ * gate a build.
+ *
+ * Build:  cc -O2 -o rombench tools/rombench.c
+ * Usage:  rombench game.gbc --sym game.noi --joy drop.joy --csv frames.csv
+ *         rombench instr_timing.gb --test
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FRAME_DOTS 70224u
+#define LINE_DOTS 456u
+#define LINES 154u
+#define MAX_SYMS 65000u
+#define NO_SYM 0xFFFFu
+#define MAX_DEPTH 256u
+#define BOOT_DIV_DMG 0xABCCu
+#define BOOT_DIV_CGB 0x1EA0u
+
+enum { FLAG_Z = 0x80, FLAG_N = 0x40, FLAG_H = 0x20, FLAG_C = 0x10 };
+
+enum {
+    MBC_NONE = 0,
+    MBC_1,
+    MBC_5,
+};
+
+typedef struct Sym {
+    char name[64];
+    uint16_t bank;
+    uint16_t addr;
+    uint64_t excl;
+    uint64_t incl;
+    uint32_t entries;
+    uint32_t active;
+} Sym;
+
+typedef struct CallFrame {
+    uint16_t sym;
+    uint16_t sp;
+    uint64_t start;
+} CallFrame;
+
+typedef struct FrameStat {
+    uint64_t busy;
+    uint64_t interval;
+    uint64_t marker_isr;
+    uint8_t joy;
+    uint8_t fast;
+} FrameStat;
+
+typedef struct Gb {
+    uint8_t a, f, b, c, d, e, h, l;
+    uint16_t sp, pc;
+    uint8_t ime;
+    uint8_t ei_delay;
+    uint8_t halted;
+    uint8_t halt_bug;
+
+    uint8_t* rom;
+    uint32_t rom_size;
+    uint16_t rom_banks;
+    uint8_t mbc;
+    uint16_t rom_bank;
+    uint8_t ram_bank;
+    uint8_t ram_enable;
+    uint8_t mbc1_mode;
+    uint32_t sram_size;
+
+    uint8_t vram[2][0x2000];
+    uint8_t sram[0x20000];
+    uint8_t wram[8][0x1000];
+    uint8_t oam[0xA0];
+    uint8_t io[0x80];
+    uint8_t hram[0x7F];
+    uint8_t ie;
+    uint8_t bg_pal[64];
+    uint8_t obj_pal[64];
+
+    uint16_t sys_counter;
+    uint8_t double_speed;
+    uint32_t line_dot;
+    uint32_t mode3_end;
+    uint8_t stat_line;
+    uint8_t tima_state;
+    uint32_t serial_dots;
+    uint8_t hdma_active;
+    uint8_t hdma_left;
+    uint32_t stall;
+
+    uint8_t joy;
+    uint64_t dots;
+    uint64_t halted_dots;
+    uint64_t vblanks;
+} Gb;
+
+static Gb g_gb;
+
+static char g_serial[4096];
+static uint32_t g_serial_len;
+
+static Sym* g_syms;
+static uint32_t g_sym_count;
+static uint16_t* g_sym_fixed;
+static uint16_t** g_sym_banked;
+static uint16_t g_sym_halt;
+static uint16_t g_sym_dma;
+static uint16_t g_sym_unknown;
+
+static CallFrame g_stack[MAX_DEPTH];
+static uint32_t g_depth;
+
+static void die(const char* msg) {
+    fprintf(stderr, "rombench: %s\n", msg);
+    exit(2);
+}
+
+/* ---- timer, PPU, DMA ------------------------------------------------------ */
+
+static uint8_t bus_read(uint16_t addr);
+
+static const uint16_t TAC_BIT[4] = { 1u << 9, 1u << 3, 1u << 5, 1u << 7 };
+
+enum {
+    TIMA_RUNNING = 0,
+    TIMA_OVERFLOWED,
+    TIMA_RELOADED,
+};
+
+static void timer_increment(void) {
+    if (++g_gb.io[0x05] == 0) {
+        g_gb.tima_state = TIMA_OVERFLOWED;
+    }
+}
+
+static void timer_edge(uint16_t old_counter, uint16_t new_counter) {
+    uint8_t tac = g_gb.io[0x07];
+    if (!(tac & 0x04)) {
+        return;
+    }
+    uint16_t bit = TAC_BIT[tac & 3u];
+    if ((old_counter & bit) && !(new_counter & bit)) {
+        timer_increment();
+    }
+}
+
+static void timer_reload_step(void) {
+    if (g_gb.tima_state == TIMA_RELOADED) {
+        g_gb.tima_state = TIMA_RUNNING;
+    } else if (g_gb.tima_state == TIMA_OVERFLOWED) {
+        g_gb.io[0x05] = g_gb.io[0x06];
+        g_gb.io[0x0F] |= 0x04;
+        g_gb.tima_state = TIMA_RELOADED;
+    }
+}
+
+static void hdma_block(void) {
+    uint16_t src = (uint16_t)((g_gb.io[0x51] << 8) | (g_gb.io[0x52] & 0xF0));
+    uint16_t dst = (uint16_t)(((g_gb.io[0x53] & 0x1F) << 8) | (g_gb.io[0x54] & 0xF0));
+    uint8_t bank = g_gb.io[0x4F] & 1u;
+    for (uint8_t i = 0; i < 16u; i++) {
+        g_gb.vram[bank][(dst + i) & 0x1FFF] = bus_read((uint16_t)(src + i));
+    }
+    src = (uint16_t)(src + 16u);
+    dst = (uint16_t)(dst + 16u);
+    g_gb.io[0x51] = (uint8_t)(src >> 8);
+    g_gb.io[0x52] = (uint8_t)src;
+    g_gb.io[0x53] = (uint8_t)((dst >> 8) & 0x1F);
+    g_gb.io[0x54] = (uint8_t)dst;
+    g_gb.stall += g_gb.double_speed ? 16u : 8u;
+}
+
+static uint8_t ppu_mode(void) {
+    if (g_gb.io[0x44] >= 144u) {
+        return 1;
+    }
+    if (g_gb.line_dot < 80u) {
+        return 2;
+    }
+    return (g_gb.line_dot < g_gb.mode3_end) ? 3 : 0;
+}
+
+static uint32_t ppu_mode3_dots(void) {
+    uint8_t lcdc = g_gb.io[0x40];
+    uint8_t ly = g_gb.io[0x44];
+    uint8_t fine = g_gb.io[0x43] & 7u;
+    uint32_t dots = 172u + fine;
+
+    if ((lcdc & 0x20) && g_gb.io[0x4A] <= ly && g_gb.io[0x4B] <= 166u) {
+        dots += 6u;
+    }
+    if (!(lcdc & 0x02)) {
+        return dots;
+    }
+
+    uint8_t height = (lcdc & 0x04) ? 16u : 8u;
+    uint8_t xs[10];
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < 40u && n < 10u; i++) {
+        int top = (int)g_gb.oam[i * 4u] - 16;
+        if ((int)ly >= top && (int)ly < top + height) {
+            uint8_t x = g_gb.oam[i * 4u + 1u];
+            uint8_t j = n++;
+            for (; j && xs[j - 1u] > x; j--) {
+                xs[j] = xs[j - 1u];
+            }
+            xs[j] = x;
+        }
+    }
+
+    int last_tile = -1;
+    for (uint8_t k = 0; k < n; k++) {
+        uint8_t x = xs[k];
+        if (x >= 168u) {
+            continue;
+        }
+        if (x == 0) {
+            dots += 11u;
+            continue;
+        }
+        uint32_t pos = (uint32_t)x + fine;
+        int tile = (int)(pos >> 3);
+        if (tile != last_tile) {
+            uint32_t right = 7u - (pos & 7u);
+            dots += (right > 2u) ? right - 2u : 0u;
+            last_tile = tile;
+        }
+        dots += 6u;
+    }
+    return dots;
+}
+
+static void ppu_update_stat(void) {
+    uint8_t stat = g_gb.io[0x41];
+    uint8_t mode = ppu_mode();
+    uint8_t coincidence = (g_gb.io[0x44] == g_gb.io[0x45]);
+    g_gb.io[0x41] = (uint8_t)(0x80 | (stat & 0x78) | (coincidence ? 0x04 : 0) | mode);
+
+    uint8_t line = (uint8_t)(((stat & 0x40) && coincidence) || ((stat & 0x08) && mode == 0) || ((stat & 0x10) && mode == 1)
+        || ((stat & 0x20) && mode == 2));
+    if (line && !g_gb.stat_line) {
+        g_gb.io[0x0F] |= 0x02;
+    }
+    g_gb.stat_line = line;
+}
+
+static void ppu_advance(uint32_t dots) {
+    if (!(g_gb.io[0x40] & 0x80)) {
+        return;
+    }
+    while (dots--) {
+        uint8_t mode_before = ppu_mode();
+        if (++g_gb.line_dot == LINE_DOTS) {
+            g_gb.line_dot = 0;
+            g_gb.io[0x44] = (uint8_t)((g_gb.io[0x44] + 1u) % LINES);
+            if (g_gb.io[0x44] == 144u) {
+                g_gb.io[0x0F] |= 0x01;
+                g_gb.vblanks++;
+            }
+        } else if (g_gb.line_dot == 80u && g_gb.io[0x44] < 144u) {
+            g_gb.mode3_end = 80u + ppu_mode3_dots();
+        }
+        uint8_t mode = ppu_mode();
+        if (mode != mode_before || g_gb.line_dot == 0) {
+            if (mode == 0 && mode_before == 3 && g_gb.hdma_active) {
+                hdma_block();
+                if (--g_gb.hdma_left == 0) {
+                    g_gb.hdma_active = 0;
+                    g_gb.io[0x55] = 0xFF;
+                } else {
+                    g_gb.io[0x55] = (uint8_t)(g_gb.hdma_left - 1u);
+                }
+            }
+            ppu_update_stat();
+        }
+    }
+}
+
+static void serial_step(uint32_t dots) {
+    if (!g_gb.serial_dots) {
+        return;
+    }
+    if (g_gb.serial_dots > dots) {
+        g_gb.serial_dots -= dots;
+        return;
+    }
+    g_gb.serial_dots = 0;
+    if (g_serial_len + 1u < sizeof(g_serial)) {
+        g_serial[g_serial_len++] = (char)g_gb.io[0x01];
+        g_serial[g_serial_len] = 0;
+    }
+    g_gb.io[0x01] = 0xFF;
+    g_gb.io[0x02] &= 0x7F;
+    g_gb.io[0x0F] |= 0x08;
+}
+
+static void tick(void) {
+    uint16_t old = g_gb.sys_counter;
+    g_gb.sys_counter = (uint16_t)(old + 4u);
+    timer_reload_step();
+    timer_edge(old, g_gb.sys_counter);
+    uint32_t dots = g_gb.double_speed ? 2u : 4u;
+    g_gb.dots += dots;
+    ppu_advance(dots);
+    serial_step(dots);
+}
+
+/* ---- bus ------------------------------------------------------------------- */
+
+static uint8_t joy_read(uint8_t p1) {
+    uint8_t lines = 0x0F;
+    if (!(p1 & 0x10)) {
+        lines &= (uint8_t)~(g_gb.joy & 0x0F);
+    }
+    if (!(p1 & 0x20)) {
+        lines &= (uint8_t)~(g_gb.joy >> 4);
+    }
+    return (uint8_t)(0xC0 | (p1 & 0x30) | lines);
+}
+
+static uint8_t io_read(uint8_t reg) {
+    switch (reg) {
+        case 0x00: return joy_read(g_gb.io[0x00]);
+        case 0x04: return (uint8_t)(g_gb.sys_counter >> 8);
+        case 0x0F: return (uint8_t)(0xE0 | g_gb.io[0x0F]);
+        case 0x4D: return (uint8_t)(0x7E | (g_gb.double_speed ? 0x80 : 0) | (g_gb.io[0x4D] & 1u));
+        case 0x4F: return (uint8_t)(0xFE | (g_gb.io[0x4F] & 1u));
+        case 0x69: return g_gb.bg_pal[g_gb.io[0x68] & 0x3F];
+        case 0x6B: return g_gb.obj_pal[g_gb.io[0x6A] & 0x3F];
+        case 0x70: return (uint8_t)(0xF8 | (g_gb.io[0x70] & 7u));
+        default: return g_gb.io[reg];
+    }
+}
+
+static void io_write(uint8_t reg, uint8_t v) {
+    switch (reg) {
+        case 0x02:
+            g_gb.io[0x02] = (uint8_t)(0x7C | v);
+            if ((v & 0x81) == 0x81) {
+                g_gb.serial_dots = (v & 0x02) ? 32u : 1024u;
+            }
+            return;
+        case 0x04: {
+            uint16_t old = g_gb.sys_counter;
+            g_gb.sys_counter = 0;
+            timer_edge(old, 0);
+            return;
+        }
+        case 0x05:
+            if (g_gb.tima_state == TIMA_OVERFLOWED) {
+                g_gb.tima_state = TIMA_RUNNING;
+            } else if (g_gb.tima_state == TIMA_RELOADED) {
+                return;
+            }
+            g_gb.io[0x05] = v;
+            return;
+        case 0x06:
+            g_gb.io[0x06] = v;
+            if (g_gb.tima_state == TIMA_RELOADED) {
+                g_gb.io[0x05] = v;
+            }
+            return;
+        case 0x07: {
+            uint16_t bit_old = (g_gb.io[0x07] & 4u) ? (uint16_t)(g_gb.sys_counter & TAC_BIT[g_gb.io[0x07] & 3u]) : 0u;
+            uint16_t bit_new = (v & 4u) ? (uint16_t)(g_gb.sys_counter & TAC_BIT[v & 3u]) : 0u;
+            g_gb.io[0x07] = (uint8_t)(0xF8 | v);
+            if (bit_old && !bit_new) {
+                timer_increment();
+            }
+            return;
+        }
+        case 0x0F: g_gb.io[0x0F] = (uint8_t)(v & 0x1F); return;
+        case 0x40:
+            if ((g_gb.io[0x40] & 0x80) && !(v & 0x80)) {
+                g_gb.io[0x44] = 0;
+                g_gb.line_dot = 0;
+                g_gb.mode3_end = 252u;
+            }
+            g_gb.io[0x40] = v;
+            ppu_update_stat();
+            return;
+        case 0x41: g_gb.io[0x41] = (uint8_t)((g_gb.io[0x41] & 0x07) | (v & 0x78)); ppu_update_stat(); return;
+        case 0x44: return;
+        case 0x45: g_gb.io[0x45] = v; ppu_update_stat(); return;
+        case 0x46: {
+                    for (uint16_t i = 0; i < 0xA0u; i++) {
+                g_gb.oam[i] = bus_read((uint16_t)((v << 8) | i));
+            }
+            g_gb.io[0x46] = v;
+            return;
+        }
+        case 0x4D: g_gb.io[0x4D] = (uint8_t)(v & 1u); return;
+        case 0x55:
+            if (g_gb.hdma_active && !(v & 0x80)) {
+                g_gb.hdma_active = 0;
+                g_gb.io[0x55] = (uint8_t)(0x80 | (g_gb.hdma_left - 1u));
+                return;
+            }
+            if (v & 0x80) {
+                g_gb.hdma_active = 1;
+                g_gb.hdma_left = (uint8_t)((v & 0x7F) + 1u);
+                g_gb.io[0x55] = (uint8_t)(v & 0x7F);
+                return;
+            }
+            for (uint8_t n = (uint8_t)((v & 0x7F) + 1u); n; n--) {
+                hdma_block();
+            }
+            g_gb.io[0x55] = 0xFF;
+            return;
+        case 0x69:
+            g_gb.bg_pal[g_gb.io[0x68] & 0x3F] = v;
+            if (g_gb.io[0x68] & 0x80) g_gb.io[0x68] = (uint8_t)(0x80 | ((g_gb.io[0x68] + 1u) & 0x3F));
+            return;
+        case 0x6B:
+            g_gb.obj_pal[g_gb.io[0x6A] & 0x3F] = v;
+            if (g_gb.io[0x6A] & 0x80) g_gb.io[0x6A] = (uint8_t)(0x80 | ((g_gb.io[0x6A] + 1u) & 0x3F));
+            return;
+        default: g_gb.io[reg] = v; return;
+    }
+}
+
+static uint8_t wram_bank(void) {
+    uint8_t b = g_gb.io[0x70] & 7u;
+    return b ? b : 1u;
+}
+
+static uint32_t sram_offset(uint16_t addr) {
+    uint8_t bank = (g_gb.mbc == MBC_1 && !g_gb.mbc1_mode) ? 0u : g_gb.ram_bank;
+    return (((uint32_t)bank << 13) + (addr - 0xA000u)) % g_gb.sram_size;
+}
+
+static uint8_t bus_read(uint16_t addr) {
+    if (addr < 0x4000u) {
+        if (g_gb.mbc == MBC_1 && g_gb.mbc1_mode) {
+            uint32_t off = ((uint32_t)(g_gb.ram_bank & 3u) << 19) + addr;
+            return g_gb.rom[off % g_gb.rom_size];
+        }
+        return g_gb.rom[addr];
+    }
+    if (addr < 0x8000u) {
+        uint32_t off = ((uint32_t)g_gb.rom_bank << 14) + (addr - 0x4000u);
+        return g_gb.rom[off % g_gb.rom_size];
+    }
+    if (addr < 0xA000u) return g_gb.vram[g_gb.io[0x4F] & 1u][addr - 0x8000u];
+    if (addr < 0xC000u) {
+        if (!g_gb.ram_enable || !g_gb.sram_size) return 0xFF;
+        return g_gb.sram[sram_offset(addr)];
+    }
+    if (addr < 0xD000u) return g_gb.wram[0][addr - 0xC000u];
+    if (addr < 0xE000u) return g_gb.wram[wram_bank()][addr - 0xD000u];
+    if (addr < 0xFE00u) return bus_read((uint16_t)(addr - 0x2000u));
+    if (addr < 0xFEA0u) return g_gb.oam[addr - 0xFE00u];
+    if (addr < 0xFF00u) return 0xFF;
+    if (addr < 0xFF80u) return io_read((uint8_t)(addr - 0xFF00u));
+    if (addr < 0xFFFFu) return g_gb.hram[addr - 0xFF80u];
+    return g_gb.ie;
+}
+
+static void mbc_write(uint16_t addr, uint8_t v) {
+    if (g_gb.mbc == MBC_5) {
+        if (addr < 0x2000u) g_gb.ram_enable = ((v & 0x0F) == 0x0A);
+        else if (addr < 0x3000u) g_gb.rom_bank = (uint16_t)((g_gb.rom_bank & 0x100u) | v);
+        else if (addr < 0x4000u) g_gb.rom_bank = (uint16_t)((g_gb.rom_bank & 0xFFu) | ((v & 1u) << 8));
+        else if (addr < 0x6000u) g_gb.ram_bank = (uint8_t)(v & 0x0F);
+        return;
+    }
+    if (g_gb.mbc == MBC_1) {
+        if (addr < 0x2000u) g_gb.ram_enable = ((v & 0x0F) == 0x0A);
+        else if (addr < 0x4000u) {
+            uint8_t low = (uint8_t)(v & 0x1F);
+            g_gb.rom_bank = (uint16_t)((g_gb.rom_bank & 0x60u) | (low ? low : 1u));
+        } else if (addr < 0x6000u) {
+            g_gb.ram_bank = (uint8_t)(v & 3u);
+            g_gb.rom_bank = (uint16_t)((g_gb.rom_bank & 0x1Fu) | ((v & 3u) << 5));
+        } else {
+            g_gb.mbc1_mode = (uint8_t)(v & 1u);
+        }
+    }
+}
+
+static void bus_write(uint16_t addr, uint8_t v) {
+    if (addr < 0x8000u) mbc_write(addr, v);
+    else if (addr < 0xA000u) g_gb.vram[g_gb.io[0x4F] & 1u][addr - 0x8000u] = v;
+    else if (addr < 0xC000u) {
+        if (g_gb.ram_enable && g_gb.sram_size) {
+            g_gb.sram[sram_offset(addr)] = v;
+        }
+    } else if (addr < 0xD000u) g_gb.wram[0][addr - 0xC000u] = v;
+    else if (addr < 0xE000u) g_gb.wram[wram_bank()][addr - 0xD000u] = v;
+    else if (addr < 0xFE00u) bus_write((uint16_t)(addr - 0x2000u), v);
+    else if (addr < 0xFEA0u) g_gb.oam[addr - 0xFE00u] = v;
+    else if (addr < 0xFF00u) return;
+    else if (addr < 0xFF80u) io_write((uint8_t)(addr - 0xFF00u), v);
+    else if (addr < 0xFFFFu) g_gb.hram[addr - 0xFF80u] = v;
+    else g_gb.ie = v;
+}
+
+/* ---- CPU ------------------------------------------------------------------- */
+
+static uint8_t rd(uint16_t addr) {
+    uint8_t v = bus_read(addr);
+    tick();
+    return v;
+}
+
+static void wr(uint16_t addr, uint8_t v) {
+    bus_write(addr, v);
+    tick();
+}
+
+static uint8_t fetch(void) {
+    uint8_t v = rd(g_gb.pc);
+    if (g_gb.halt_bug) {
+        g_gb.halt_bug = 0;
+    } else {
+        g_gb.pc++;
+    }
+    return v;
+}
+
+static uint16_t fetch16(void) {
+    uint8_t lo = fetch();
+    return (uint16_t)(lo | (fetch() << 8));
+}
+
+static void push16(uint16_t v) {
+    wr(--g_gb.sp, (uint8_t)(v >> 8));
+    wr(--g_gb.sp, (uint8_t)v);
+}
+
+static uint16_t pop16(void) {
+    uint8_t lo = rd(g_gb.sp++);
+    return (uint16_t)(lo | (rd(g_gb.sp++) << 8));
+}
+
+#define BC ((uint16_t)((g_gb.b << 8) | g_gb.c))
+#define DE ((uint16_t)((g_gb.d << 8) | g_gb.e))
+#define HL ((uint16_t)((g_gb.h << 8) | g_gb.l))
+#define SET_BC(v) do { uint16_t v_ = (v); g_gb.b = (uint8_t)(v_ >> 8); g_gb.c = (uint8_t)v_; } while (0)
+#define SET_DE(v) do { uint16_t v_ = (v); g_gb.d = (uint8_t)(v_ >> 8); g_gb.e = (uint8_t)v_; } while (0)
+#define SET_HL(v) do { uint16_t v_ = (v); g_gb.h = (uint8_t)(v_ >> 8); g_gb.l = (uint8_t)v_; } while (0)
+
+static uint8_t get_r(uint8_t i) {
+    switch (i) {
+        case 0: return g_gb.b;
+        case 1: return g_gb.c;
+        case 2: return g_gb.d;
+        case 3: return g_gb.e;
+        case 4: return g_gb.h;
+        case 5: return g_gb.l;
+        case 6: return rd(HL);
+        default: return g_gb.a;
+    }
+}
+
+static void set_r(uint8_t i, uint8_t v) {
+    switch (i) {
+        case 0: g_gb.b = v; break;
+        case 1: g_gb.c = v; break;
+        case 2: g_gb.d = v; break;
+        case 3: g_gb.e = v; break;
+        case 4: g_gb.h = v; break;
+        case 5: g_gb.l = v; break;
+        case 6: wr(HL, v); break;
+        default: g_gb.a = v; break;
+    }
+}
+
+static uint16_t get_rr(uint8_t i) {
+    switch (i) {
+        case 0: return BC;
+        case 1: return DE;
+        case 2: return HL;
+        default: return g_gb.sp;
+    }
+}
+
+static void set_rr(uint8_t i, uint16_t v) {
+    switch (i) {
+        case 0: SET_BC(v); break;
+        case 1: SET_DE(v); break;
+        case 2: SET_HL(v); break;
+        default: g_gb.sp = v; break;
+    }
+}
+
+static uint8_t cond(uint8_t i) {
+    switch (i) {
+        case 0: return !(g_gb.f & FLAG_Z);
+        case 1: return (g_gb.f & FLAG_Z) != 0;
+        case 2: return !(g_gb.f & FLAG_C);
+        default: return (g_gb.f & FLAG_C) != 0;
+    }
+}
+
+static void alu(uint8_t op, uint8_t v) {
+    uint8_t a = g_gb.a;
+    uint8_t carry = (g_gb.f & FLAG_C) ? 1u : 0u;
+    unsigned r;
+    switch (op) {
+        case 0:
+        case 1:
+            if (op == 0) carry = 0;
+            r = (unsigned)a + v + carry;
+            g_gb.f = (uint8_t)((((uint8_t)r) ? 0 : FLAG_Z) | (((a & 0xF) + (v & 0xF) + carry) > 0xF ? FLAG_H : 0) | (r > 0xFF ? FLAG_C : 0));
+            g_gb.a = (uint8_t)r;
+            break;
+        case 2:
+        case 3:
+        case 7:
+            if (op != 3) carry = 0;
+            r = (unsigned)a - v - carry;
+            g_gb.f = (uint8_t)((((uint8_t)r) ? 0 : FLAG_Z) | FLAG_N | (((a & 0xF) < (v & 0xF) + carry) ? FLAG_H : 0)
+                | (((unsigned)a < (unsigned)v + carry) ? FLAG_C : 0));
+            if (op != 7) g_gb.a = (uint8_t)r;
+            break;
+        case 4: g_gb.a = (uint8_t)(a & v); g_gb.f = (uint8_t)((g_gb.a ? 0 : FLAG_Z) | FLAG_H); break;
+        case 5: g_gb.a = (uint8_t)(a ^ v); g_gb.f = (uint8_t)(g_gb.a ? 0 : FLAG_Z); break;
+        default: g_gb.a = (uint8_t)(a | v); g_gb.f = (uint8_t)(g_gb.a ? 0 : FLAG_Z); break;
+    }
+}
+
+static uint8_t cb_rot(uint8_t op, uint8_t v) {
+    uint8_t carry_in = (g_gb.f & FLAG_C) ? 1u : 0u;
+    uint8_t c;
+    uint8_t r;
+    switch (op) {
+        case 0: c = (uint8_t)(v >> 7); r = (uint8_t)((v << 1) | c); break;
+        case 1: c = (uint8_t)(v & 1u); r = (uint8_t)((v >> 1) | (c << 7)); break;
+        case 2: c = (uint8_t)(v >> 7); r = (uint8_t)((v << 1) | carry_in); break;
+        case 3: c = (uint8_t)(v & 1u); r = (uint8_t)((v >> 1) | (carry_in << 7)); break;
+        case 4: c = (uint8_t)(v >> 7); r = (uint8_t)(v << 1); break;
+        case 5: c = (uint8_t)(v & 1u); r = (uint8_t)((v >> 1) | (v & 0x80)); break;
+        case 6: c = 0; r = (uint8_t)((v << 4) | (v >> 4)); break;
+        default: c = (uint8_t)(v & 1u); r = (uint8_t)(v >> 1); break;
+    }
+    g_gb.f = (uint8_t)((r ? 0 : FLAG_Z) | (c ? FLAG_C : 0));
+    return r;
+}
+
+static void exec_cb(void) {
+    uint8_t op = fetch();
+    uint8_t reg = (uint8_t)(op & 7u);
+    uint8_t bit = (uint8_t)((op >> 3) & 7u);
+    uint8_t v = get_r(reg);
+    switch (op >> 6) {
+        case 0: set_r(reg, cb_rot(bit, v)); break;
+        case 1: g_gb.f = (uint8_t)((g_gb.f & FLAG_C) | FLAG_H | ((v & (1u << bit)) ? 0 : FLAG_Z)); break;
+        case 2: set_r(reg, (uint8_t)(v & ~(1u << bit))); break;
+        default: set_r(reg, (uint8_t)(v | (1u << bit))); break;
+    }
+}
+
+static uint16_t sp_plus_e(void) {
+    int8_t e = (int8_t)fetch();
+    uint16_t sp = g_gb.sp;
+    uint16_t r = (uint16_t)(sp + e);
+    g_gb.f = (uint8_t)((((sp & 0xF) + ((uint8_t)e & 0xF)) > 0xF ? FLAG_H : 0) | (((sp & 0xFF) + (uint8_t)e) > 0xFF ? FLAG_C : 0));
+    return r;
+}
+
+static void speed_switch(void) {
+    if (!(g_gb.io[0x4D] & 1u)) {
+        return;
+    }
+    g_gb.double_speed ^= 1u;
+    g_gb.io[0x4D] = 0;
+    uint16_t old = g_gb.sys_counter;
+    g_gb.sys_counter = 0;
+    timer_edge(old, 0);
+    for (uint32_t i = 0; i < 2050u; i++) {
+        tick();
+    }
+}
+
+static int exec(void) {
+    uint8_t op = fetch();
+    switch (op) {
+        case 0x00: break;
+        case 0x10: fetch(); speed_switch(); break;
+        case 0x76:
+            if (!g_gb.ime && (g_gb.ie & g_gb.io[0x0F] & 0x1F)) g_gb.halt_bug = 1;
+            else g_gb.halted = 1;
+            break;
+        case 0xCB: exec_cb(); break;
+
+        case 0x01: case 0x11: case 0x21: case 0x31: set_rr((uint8_t)(op >> 4), fetch16()); break;
+        case 0x02: wr(BC, g_gb.a); break;
+        case 0x12: wr(DE, g_gb.a); break;
+        case 0x22: wr(HL, g_gb.a); SET_HL(HL + 1); break;
+        case 0x32: wr(HL, g_gb.a); SET_HL(HL - 1); break;
+        case 0x0A: g_gb.a = rd(BC); break;
+        case 0x1A: g_gb.a = rd(DE); break;
+        case 0x2A: g_gb.a = rd(HL); SET_HL(HL + 1); break;
+        case 0x3A: g_gb.a = rd(HL); SET_HL(HL - 1); break;
+        case 0x03: case 0x13: case 0x23: case 0x33: set_rr((uint8_t)(op >> 4), (uint16_t)(get_rr((uint8_t)(op >> 4)) + 1)); tick(); break;
+        case 0x0B: case 0x1B: case 0x2B: case 0x3B: set_rr((uint8_t)(op >> 4), (uint16_t)(get_rr((uint8_t)(op >> 4)) - 1)); tick(); break;
+        case 0x09: case 0x19: case 0x29: case 0x39: {
+            uint16_t hl = HL;
+            uint16_t v = get_rr((uint8_t)(op >> 4));
+            uint32_t r = (uint32_t)hl + v;
+            g_gb.f = (uint8_t)((g_gb.f & FLAG_Z) | (((hl & 0xFFF) + (v & 0xFFF)) > 0xFFF ? FLAG_H : 0) | (r > 0xFFFF ? FLAG_C : 0));
+            SET_HL((uint16_t)r);
+            tick();
+            break;
+        }
+        case 0x04: case 0x0C: case 0x14: case 0x1C: case 0x24: case 0x2C: case 0x34: case 0x3C: {
+            uint8_t i = (uint8_t)(op >> 3);
+            uint8_t v = get_r(i);
+            uint8_t r = (uint8_t)(v + 1);
+            g_gb.f = (uint8_t)((g_gb.f & FLAG_C) | (r ? 0 : FLAG_Z) | ((v & 0xF) == 0xF ? FLAG_H : 0));
+            set_r(i, r);
+            break;
+        }
+        case 0x05: case 0x0D: case 0x15: case 0x1D: case 0x25: case 0x2D: case 0x35: case 0x3D: {
+            uint8_t i = (uint8_t)(op >> 3);
+            uint8_t v = get_r(i);
+            uint8_t r = (uint8_t)(v - 1);
+            g_gb.f = (uint8_t)((g_gb.f & FLAG_C) | FLAG_N | (r ? 0 : FLAG_Z) | ((v & 0xF) == 0 ? FLAG_H : 0));
+            set_r(i, r);
+            break;
+        }
+        case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E: case 0x36: case 0x3E: {
+            uint8_t v = fetch();
+            set_r((uint8_t)(op >> 3), v);
+            break;
+        }
+        case 0x07: g_gb.a = cb_rot(0, g_gb.a); g_gb.f &= FLAG_C; break;
+        case 0x0F: g_gb.a = cb_rot(1, g_gb.a); g_gb.f &= FLAG_C; break;
+        case 0x17: g_gb.a = cb_rot(2, g_gb.a); g_gb.f &= FLAG_C; break;
+        case 0x1F: g_gb.a = cb_rot(3, g_gb.a); g_gb.f &= FLAG_C; break;
+        case 0x08: {
+            uint16_t addr = fetch16();
+            wr(addr, (uint8_t)g_gb.sp);
+            wr((uint16_t)(addr + 1), (uint8_t)(g_gb.sp >> 8));
+            break;
+        }
+        case 0x18: {
+            int8_t e = (int8_t)fetch();
+            g_gb.pc = (uint16_t)(g_gb.pc + e);
+            tick();
+            break;
+        }
+        case 0x20: case 0x28: case 0x30: case 0x38: {
+            int8_t e = (int8_t)fetch();
+            if (cond((uint8_t)((op >> 3) & 3u))) {
+                g_gb.pc = (uint16_t)(g_gb.pc + e);
+                tick();
+            }
+            break;
+        }
+        case 0x27: {
+            uint8_t a = g_gb.a;
+            uint8_t adj = 0;
+            uint8_t carry = (g_gb.f & FLAG_C) ? 1u : 0u;
+            if (g_gb.f & FLAG_N) {
+                if (g_gb.f & FLAG_H) adj |= 0x06;
+                if (carry) adj |= 0x60;
+                a = (uint8_t)(a - adj);
+            } else {
+                if ((g_gb.f & FLAG_H) || (a & 0x0F) > 9) adj |= 0x06;
+                if (carry || a > 0x99) { adj |= 0x60; carry = 1; }
+                a = (uint8_t)(a + adj);
+            }
+            g_gb.a = a;
+            g_gb.f = (uint8_t)((g_gb.f & FLAG_N) | (a ? 0 : FLAG_Z) | (carry ? FLAG_C : 0));
+            break;
+        }
+        case 0x2F: g_gb.a = (uint8_t)~g_gb.a; g_gb.f |= FLAG_N | FLAG_H; break;
+        case 0x37: g_gb.f = (uint8_t)((g_gb.f & FLAG_Z) | FLAG_C); break;
+        case 0x3F: g_gb.f = (uint8_t)((g_gb.f & (FLAG_Z | FLAG_C)) ^ FLAG_C); break;
+
+        case 0xC0: case 0xC8: case 0xD0: case 0xD8:
+            tick();
+            if (cond((uint8_t)((op >> 3) & 3u))) {
+                g_gb.pc = pop16();
+                tick();
+            }
+            break;
+        case 0xC9: g_gb.pc = pop16(); tick(); break;
+        case 0xD9: g_gb.pc = pop16(); tick(); g_gb.ime = 1; g_gb.ei_delay = 0; break;
+        case 0xC1: case 0xD1: case 0xE1: set_rr((uint8_t)((op >> 4) & 3u), pop16()); break;
+        case 0xF1: { uint16_t v = pop16(); g_gb.a = (uint8_t)(v >> 8); g_gb.f = (uint8_t)(v & 0xF0); break; }
+        case 0xC5: case 0xD5: case 0xE5: tick(); push16(get_rr((uint8_t)((op >> 4) & 3u))); break;
+        case 0xF5: tick(); push16((uint16_t)((g_gb.a << 8) | g_gb.f)); break;
+        case 0xC3: g_gb.pc = fetch16(); tick(); break;
+        case 0xC2: case 0xCA: case 0xD2: case 0xDA: {
+            uint16_t addr = fetch16();
+            if (cond((uint8_t)((op >> 3) & 3u))) {
+                g_gb.pc = addr;
+                tick();
+            }
+            break;
+        }
+        case 0xE9: g_gb.pc = HL; break;
+        case 0xCD: {
+            uint16_t addr = fetch16();
+            tick();
+            push16(g_gb.pc);
+            g_gb.pc = addr;
+            break;
+        }
+        case 0xC4: case 0xCC: case 0xD4: case 0xDC: {
+            uint16_t addr = fetch16();
+            if (cond((uint8_t)((op >> 3) & 3u))) {
+                tick();
+                push16(g_gb.pc);
+                g_gb.pc = addr;
+            }
+            break;
+        }
+        case 0xC7: case 0xCF: case 0xD7: case 0xDF: case 0xE7: case 0xEF: case 0xF7: case 0xFF:
+            tick();
+            push16(g_gb.pc);
+            g_gb.pc = (uint16_t)(op & 0x38);
+            break;
+        case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE: case 0xF6: case 0xFE:
+            alu((uint8_t)((op >> 3) & 7u), fetch());
+            break;
+        case 0xE0: { uint8_t n = fetch(); wr((uint16_t)(0xFF00u | n), g_gb.a); break; }
+        case 0xF0: { uint8_t n = fetch(); g_gb.a = rd((uint16_t)(0xFF00u | n)); break; }
+        case 0xE2: wr((uint16_t)(0xFF00u | g_gb.c), g_gb.a); break;
+        case 0xF2: g_gb.a = rd((uint16_t)(0xFF00u | g_gb.c)); break;
+        case 0xEA: wr(fetch16(), g_gb.a); break;
+        case 0xFA: g_gb.a = rd(fetch16()); break;
+        case 0xE8: g_gb.sp = sp_plus_e(); tick(); tick(); break;
+        case 0xF8: SET_HL(sp_plus_e()); tick(); break;
+        case 0xF9: g_gb.sp = HL; tick(); break;
+        case 0xF3: g_gb.ime = 0; g_gb.ei_delay = 0; break;
+        case 0xFB: if (!g_gb.ime && !g_gb.ei_delay) g_gb.ei_delay = 2; break;
+
+        case 0xD3: case 0xDB: case 0xDD: case 0xE3: case 0xE4: case 0xEB: case 0xEC: case 0xED: case 0xF4: case 0xFC: case 0xFD:
+            return 0;
+
+        default:
+            if (op >= 0x40 && op < 0x80) {
+                uint8_t v = get_r((uint8_t)(op & 7u));
+                set_r((uint8_t)((op >> 3) & 7u), v);
+            } else {
+                alu((uint8_t)((op >> 3) & 7u), get_r((uint8_t)(op & 7u)));
+            }
+            break;
+    }
+
+    if (g_gb.ei_delay && --g_gb.ei_delay == 0) {
+        g_gb.ime = 1;
+    }
+    return 1;
+}
+
+static uint8_t irq_pending(void) {
+    return (uint8_t)(g_gb.ie & g_gb.io[0x0F] & 0x1F);
+}
+
+static void irq_dispatch(void) {
+    uint8_t pending = irq_pending();
+    uint8_t n = 0;
+    while (!(pending & (1u << n))) {
+        n++;
+    }
+    g_gb.ime = 0;
+    g_gb.io[0x0F] &= (uint8_t)~(1u << n);
+    tick();
+    tick();
+    push16(g_gb.pc);
+    g_gb.pc = (uint16_t)(0x40u + n * 8u);
+    tick();
+}
+
+/* ---- symbols ---------------------------------------------------------------- */
+
+static int sym_cmp(const void* a, const void* b) {
+    const Sym* x = (const Sym*)a;
+    const Sym* y = (const Sym*)b;
+    if (x->bank != y->bank) return (x->bank < y->bank) ? -1 : 1;
+    return (x->addr < y->addr) ? -1 : (x->addr > y->addr);
+}
+
+static uint16_t sym_add(const char* name, uint16_t bank, uint16_t addr) {
+    if (g_sym_count >= MAX_SYMS) die("too many symbols");
+    Sym* s = &g_syms[g_sym_count];
+    memset(s, 0, sizeof(*s));
+    snprintf(s->name, sizeof(s->name), "%s", name);
+    s->bank = bank;
+    s->addr = addr;
+    return (uint16_t)g_sym_count++;
+}
+
+static int sym_wanted(const char* name) {
+    if (strncmp(name, "l_", 2) == 0 || strncmp(name, "s_", 2) == 0 || strncmp(name, "b_", 2) == 0) return 0;
+    if (strncmp(name, "___bank_", 8) == 0 || name[0] == '.' || strchr(name, '$')) return 0;
+    return 1;
+}
+
+static void sym_load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) die("cannot open the symbol file");
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        char name[256];
+        unsigned long value;
+        unsigned bank;
+        unsigned addr;
+        if (sscanf(line, "DEF %255s 0x%lx", name, &value) == 2) {
+            if (sym_wanted(name)) sym_add(name, (uint16_t)(value >> 16), (uint16_t)value);
+        } else if (sscanf(line, "%x:%x %255s", &bank, &addr, name) == 3) {
+            if (sym_wanted(name)) sym_add(name, (uint16_t)((addr >= 0x4000u && addr < 0x8000u) ? bank : 0u), (uint16_t)addr);
+        }
+    }
+    fclose(f);
+}
+
+static uint16_t* sym_table(uint16_t bank) {
+    if (bank == 0) return g_sym_fixed;
+    if (bank >= g_gb.rom_banks) return 0;
+    if (!g_sym_banked[bank]) {
+        uint16_t* t = (uint16_t*)malloc(0x4000u * sizeof(uint16_t));
+        if (!t) die("out of memory");
+        for (uint32_t i = 0; i < 0x4000u; i++) t[i] = g_sym_unknown;
+        g_sym_banked[bank] = t;
+    }
+    return g_sym_banked[bank];
+}
+
+static void sym_index(void) {
+    g_sym_halt = sym_add("<halt>", 0, 0);
+    g_sym_dma = sym_add("<dma stall>", 0, 0);
+    g_sym_unknown = sym_add("<no symbol>", 0, 0);
+    uint32_t real = g_sym_count - 3u;
+    qsort(g_syms, real, sizeof(Sym), sym_cmp);
+
+    g_sym_fixed = (uint16_t*)malloc(0x10000u * sizeof(uint16_t));
+    g_sym_banked = (uint16_t**)calloc(g_gb.rom_banks ? g_gb.rom_banks : 1u, sizeof(uint16_t*));
+    if (!g_sym_fixed || !g_sym_banked) die("out of memory");
+    for (uint32_t i = 0; i < 0x10000u; i++) g_sym_fixed[i] = g_sym_unknown;
+
+    for (uint32_t i = 0; i < real; i++) {
+        const Sym* s = &g_syms[i];
+        uint32_t area_end;
+        if (s->addr < 0x4000u) area_end = 0x4000u;
+        else if (s->addr < 0x8000u) area_end = 0x8000u;
+        else area_end = (uint32_t)(s->addr | 0x1FFFu) + 1u;
+        uint32_t end = area_end;
+        if (i + 1u < real && g_syms[i + 1u].bank == s->bank && g_syms[i + 1u].addr < end) end = g_syms[i + 1u].addr;
+
+        uint16_t bank = (s->addr >= 0x4000u && s->addr < 0x8000u) ? s->bank : 0u;
+        uint16_t* t = sym_table(bank);
+        if (!t) continue;
+        uint32_t base = (bank == 0) ? 0u : 0x4000u;
+        for (uint32_t a = s->addr; a < end; a++) t[a - base] = (uint16_t)i;
+    }
+}
+
+static uint16_t sym_at(uint16_t pc, uint16_t bank) {
+    if (pc >= 0x4000u && pc < 0x8000u) {
+        uint16_t* t = sym_table(bank);
+        return t ? t[pc - 0x4000u] : g_sym_unknown;
+    }
+    return g_sym_fixed[pc];
+}
+
+static uint16_t sym_find(const char* name, uint16_t* bank, uint16_t* addr) {
+    for (uint32_t i = 0; i + 3u < g_sym_count; i++) {
+        if (strcmp(g_syms[i].name, name) == 0) {
+            *bank = g_syms[i].bank;
+            *addr = g_syms[i].addr;
+            return (uint16_t)i;
+        }
+    }
+    return NO_SYM;
+}
+
+static void call_push(uint16_t sym, uint64_t start) {
+    if (g_depth >= MAX_DEPTH) return;
+    CallFrame* fr = &g_stack[g_depth++];
+    fr->sym = sym;
+    fr->sp = g_gb.sp;
+    fr->start = start;
+    g_syms[sym].active++;
+}
+
+static void call_pop_returned(void) {
+    while (g_depth && g_gb.sp > g_stack[g_depth - 1u].sp) {
+        CallFrame* fr = &g_stack[--g_depth];
+        Sym* s = &g_syms[fr->sym];
+        if (--s->active == 0) s->incl += g_gb.dots - fr->start;
+    }
+}
+
+/* ---- runner ----------------------------------------------------------------- */
+
+static uint8_t* read_file(const char* path, uint32_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* data = (n > 0) ? (uint8_t*)malloc((size_t)n) : 0;
+    if (data && fread(data, 1, (size_t)n, f) != (size_t)n) {
+        free(data);
+        data = 0;
+    }
+    fclose(f);
+    *size = data ? (uint32_t)n : 0u;
+    return data;
+}
+
+static void gb_boot(void) {
+    uint8_t type = g_gb.rom[0x147];
+    if (type == 0x00) g_gb.mbc = MBC_NONE;
+    else if (type >= 0x01 && type <= 0x03) g_gb.mbc = MBC_1;
+    else if (type >= 0x19 && type <= 0x1E) g_gb.mbc = MBC_5;
+    else die("unsupported cartridge type (ROM only, MBC1 and MBC5 are emulated)");
+
+    static const uint32_t RAM_SIZES[6] = { 0, 0x800, 0x2000, 0x8000, 0x20000, 0x10000 };
+    g_gb.sram_size = (g_gb.rom[0x149] < 6u) ? RAM_SIZES[g_gb.rom[0x149]] : 0u;
+    g_gb.rom_banks = (uint16_t)(g_gb.rom_size / 0x4000u);
+    g_gb.rom_bank = 1;
+
+    g_gb.a = 0x11; g_gb.f = 0x80; g_gb.b = 0x00; g_gb.c = 0x00;
+    g_gb.d = 0xFF; g_gb.e = 0x56; g_gb.h = 0x00; g_gb.l = 0x0D;
+    g_gb.sp = 0xFFFE;
+    g_gb.pc = 0x0100;
+    g_gb.sys_counter = (g_gb.rom[0x143] & 0x80) ? BOOT_DIV_CGB : BOOT_DIV_DMG;
+    g_gb.mode3_end = 252u;
+
+    g_gb.io[0x00] = 0xCF;
+    g_gb.io[0x07] = 0xF8;
+    g_gb.io[0x0F] = 0x01;
+    g_gb.io[0x40] = 0x91;
+    g_gb.io[0x47] = 0xFC;
+    g_gb.io[0x55] = 0xFF;
+    g_gb.io[0x70] = 0x01;
+    ppu_update_stat();
+}
+
+static void usage(void) {
+    fprintf(stderr,
+        "usage: rombench game.gbc [--sym game.noi|.sym] [--joy trace.joy] [--frames n]\n"
+        "                [--budget 70224] [--marker _wait_vbl_done] [--top 25]\n"
+        "                [--csv frames.csv] [--sram in.sav] [--sram-out out.sav]\n"
+        "                [--div 0xABCC] [--test]\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    const char* rom_path = 0;
+    const char* sym_path = 0;
+    const char* joy_path = 0;
+    const char* csv_path = 0;
+    const char* sram_in = 0;
+    const char* sram_out = 0;
+    const char* marker_name = "_wait_vbl_done";
+    uint32_t frames = 600;
+    uint32_t budget = FRAME_DOTS;
+    uint32_t top = 25;
+    uint8_t frames_set = 0;
+    uint8_t test = 0;
+    long boot_div = -1;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : 0;
+        if (strcmp(a, "--sym") == 0 && v) { sym_path = v; i++; }
+        else if (strcmp(a, "--joy") == 0 && v) { joy_path = v; i++; }
+        else if (strcmp(a, "--frames") == 0 && v) { frames = (uint32_t)strtoul(v, 0, 0); frames_set = 1; i++; }
+        else if (strcmp(a, "--budget") == 0 && v) { budget = (uint32_t)strtoul(v, 0, 0); i++; }
+        else if (strcmp(a, "--marker") == 0 && v) { marker_name = v; i++; }
+        else if (strcmp(a, "--top") == 0 && v) { top = (uint32_t)strtoul(v, 0, 0); i++; }
+        else if (strcmp(a, "--csv") == 0 && v) { csv_path = v; i++; }
+        else if (strcmp(a, "--sram") == 0 && v) { sram_in = v; i++; }
+        else if (strcmp(a, "--sram-out") == 0 && v) { sram_out = v; i++; }
+        else if (strcmp(a, "--div") == 0 && v) { boot_div = (long)(strtoul(v, 0, 0) & 0xFFFFu); i++; }
+        else if (strcmp(a, "--test") == 0) test = 1;
+        else if (a[0] != '-' && !rom_path) rom_path = a;
+        else usage();
+    }
+    if (!rom_path) usage();
+
+    g_gb.rom = read_file(rom_path, &g_gb.rom_size);
+    if (!g_gb.rom || g_gb.rom_size < 0x8000u) die("cannot read the ROM (or it is smaller than 32 KiB)");
+    gb_boot();
+    if (boot_div >= 0) g_gb.sys_counter = (uint16_t)boot_div;
+    if (test && !frames_set) frames = 60u * 60u;
+
+    if (sram_in) {
+        uint32_t n;
+        uint8_t* data = read_file(sram_in, &n);
+        if (!data) die("cannot read --sram");
+        memcpy(g_gb.sram, data, n < sizeof(g_gb.sram) ? n : sizeof(g_gb.sram));
+        free(data);
+    }
+
+    uint8_t* joy = 0;
+    uint32_t joy_len = 0;
+    if (joy_path) {
+        joy = read_file(joy_path, &joy_len);
+        if (!joy) die("cannot read --joy");
+        if (!frames_set) frames = joy_len;
+    }
+
+    g_syms = (Sym*)calloc(MAX_SYMS, sizeof(Sym));
+    if (!g_syms) die("out of memory");
+    if (sym_path) sym_load(sym_path);
+    sym_index();
+
+    uint16_t marker_bank = 0;
+    uint16_t marker_addr = 0;
+    uint8_t use_marker = sym_path && sym_find(marker_name, &marker_bank, &marker_addr) != NO_SYM;
+    if (sym_path && !use_marker) {
+        fprintf(stderr, "rombench: %s not in %s; frames are timed VBlank to VBlank instead\n", marker_name, sym_path);
+    }
+
+    FrameStat* stats = (FrameStat*)calloc(frames ? frames : 1u, sizeof(FrameStat));
+    if (!stats) die("out of memory");
+
+    uint32_t frame = 0;
+    uint64_t frame_start = 0;
+    uint64_t last_entry = 0;
+    uint64_t halted_at_start = 0;
+    uint8_t in_marker = 0;
+    uint16_t marker_ret_sp = 0;
+    uint16_t isr_ret_sp = 0;
+    uint16_t isr_ret_pc = 0;
+    uint64_t isr_start = 0;
+    uint64_t vblanks_seen = 0;
+    uint64_t limit = (uint64_t)(frames + 120u) * FRAME_DOTS * 8u;
+    uint8_t fast_in_frame = 0;
+
+    g_gb.joy = (joy && joy_len) ? joy[0] : 0;
+
+    uint32_t serial_seen = 0;
+
+    while (frame < frames || in_marker) {
+        if (test && g_serial_len != serial_seen) {
+            serial_seen = g_serial_len;
+            if (strstr(g_serial, "Passed") || strstr(g_serial, "Failed")) break;
+        }
+        if (g_gb.dots > limit) {
+            fprintf(stderr, "rombench: stopped after %llu cycles at frame %u; the frame marker is not being reached\n",
+                (unsigned long long)g_gb.dots, (unsigned)frame);
+            break;
+        }
+
+        if (g_gb.stall) {
+            uint64_t d0 = g_gb.dots;
+            while (g_gb.stall) {
+                g_gb.stall--;
+                tick();
+            }
+            g_syms[g_sym_dma].excl += g_gb.dots - d0;
+            continue;
+        }
+
+        uint16_t bank = g_gb.rom_bank;
+        uint64_t d0 = g_gb.dots;
+
+        if (g_gb.halted) {
+            if (irq_pending()) {
+                g_gb.halted = 0;
+                if (g_gb.ime) tick();
+            } else {
+                tick();
+                g_gb.halted_dots += g_gb.dots - d0;
+                g_syms[g_sym_halt].excl += g_gb.dots - d0;
+                continue;
+            }
+        }
+
+        if (g_gb.ime && irq_pending()) {
+            if (in_marker && !isr_ret_sp) {
+                isr_ret_sp = g_gb.sp;
+                isr_ret_pc = g_gb.pc;
+                isr_start = d0;
+            }
+            irq_dispatch();
+            uint16_t s = sym_at(g_gb.pc, g_gb.rom_bank);
+            g_syms[s].excl += g_gb.dots - d0;
+            if (g_syms[s].addr == g_gb.pc) g_syms[s].entries++;
+            call_push(s, d0);
+            continue;
+        }
+
+        uint16_t pc = g_gb.pc;
+        uint16_t sp_before = g_gb.sp;
+        if (!exec()) {
+            fprintf(stderr, "rombench: illegal opcode %02X at %02X:%04X\n", bus_read(pc), (unsigned)bank, (unsigned)pc);
+            return 2;
+        }
+        g_syms[sym_at(pc, bank)].excl += g_gb.dots - d0;
+        fast_in_frame |= g_gb.double_speed;
+
+        if (g_gb.sp < sp_before && g_depth < MAX_DEPTH) {
+            uint8_t op = bus_read(pc);
+            if (op == 0xCD || (op & 0xC7) == 0xC4 || (op & 0xC7) == 0xC7) {
+                if (g_gb.sp == (uint16_t)(sp_before - 2u) && g_gb.pc != (uint16_t)(pc + ((op == 0xCD || (op & 0xC7) == 0xC4) ? 3u : 1u))) {
+                    call_push(sym_at(g_gb.pc, g_gb.rom_bank), g_gb.dots);
+                }
+            }
+        }
+        call_pop_returned();
+
+        if (isr_ret_sp && g_gb.sp == isr_ret_sp && g_gb.pc == isr_ret_pc) {
+            FrameStat* st = &stats[frame - 1u];
+            st->marker_isr += g_gb.dots - isr_start;
+            st->busy += g_gb.dots - isr_start;
+            isr_ret_sp = 0;
+        }
+
+        uint16_t s = sym_at(g_gb.pc, g_gb.rom_bank);
+        if (g_syms[s].addr == g_gb.pc) g_syms[s].entries++;
+
+        if (use_marker) {
+            if (!in_marker && g_gb.pc == marker_addr && (marker_addr < 0x4000u || marker_addr >= 0x8000u || g_gb.rom_bank == marker_bank)) {
+                FrameStat* st = &stats[frame];
+                st->busy = g_gb.dots - frame_start;
+                st->interval = frame ? g_gb.dots - last_entry : st->busy;
+                st->joy = g_gb.joy;
+                st->fast = fast_in_frame;
+                last_entry = g_gb.dots;
+                in_marker = 1;
+                marker_ret_sp = (uint16_t)(g_gb.sp + 2u);
+                frame++;
+                g_gb.joy = (joy && frame < joy_len) ? joy[frame] : 0;
+            } else if (in_marker && g_gb.sp == marker_ret_sp && g_gb.pc == (uint16_t)(bus_read((uint16_t)(marker_ret_sp - 2u)) | (bus_read((uint16_t)(marker_ret_sp - 1u)) << 8))) {
+                in_marker = 0;
+                frame_start = g_gb.dots;
+                fast_in_frame = g_gb.double_speed;
+            }
+        } else if (g_gb.vblanks != vblanks_seen) {
+            vblanks_seen = g_gb.vblanks;
+            FrameStat* st = &stats[frame];
+            uint64_t halted = g_gb.halted_dots - halted_at_start;
+            st->interval = g_gb.dots - frame_start;
+            st->busy = st->interval - halted;
+            st->joy = g_gb.joy;
+            st->fast = fast_in_frame;
+            frame_start = g_gb.dots;
+            halted_at_start = g_gb.halted_dots;
+            fast_in_frame = g_gb.double_speed;
+            frame++;
+            g_gb.joy = (joy && frame < joy_len) ? joy[frame] : 0;
+        }
+    }
+
+    if (test) {
+        fputs(g_serial, stdout);
+        if (g_serial_len && g_serial[g_serial_len - 1u] != '\n') putchar('\n');
+        fflush(stdout);
+        if (strstr(g_serial, "Passed")) return 0;
+        fprintf(stderr, "rombench: %s\n", strstr(g_serial, "Failed") ? "test failed" : "test did not report a result");
+        return 1;
+    }
+
+    g_gb.sp = 0xFFFF;
+    call_pop_returned();
+
+    FILE* csv = 0;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) die("cannot write --csv");
+        fprintf(csv, "frame,joy,busy_cycles,interval_cycles,marker_isr_cycles,double_speed,over_budget\n");
+    }
+
+    uint32_t measured = 0;
+    uint32_t over = 0;
+    uint32_t missed = 0;
+    uint32_t fast = 0;
+    uint64_t busy_sum = 0;
+    uint64_t busy_min = ~0ull;
+    uint64_t busy_max = 0;
+    uint32_t worst = 0;
+    for (uint32_t i = 0; i < frame; i++) {
+        const FrameStat* st = &stats[i];
+        uint8_t gated = (i > 0u);
+        uint8_t is_over = gated && st->busy > budget;
+        if (csv) {
+            fprintf(csv, "%u,%u,%llu,%llu,%llu,%u,%u\n", (unsigned)i, (unsigned)st->joy, (unsigned long long)st->busy,
+                (unsigned long long)st->interval, (unsigned long long)st->marker_isr, (unsigned)st->fast,
+                (unsigned)is_over);
+        }
+        if (!gated) continue;
+        measured++;
+        busy_sum += st->busy;
+        if (st->busy < busy_min) busy_min = st->busy;
+        if (st->busy > busy_max) { busy_max = st->busy; worst = i; }
+        if (is_over) over++;
+        if (st->interval >= FRAME_DOTS + FRAME_DOTS / 2u) missed++;
+        if (st->fast) fast++;
+    }
+    if (csv) fclose(csv);
+
+    printf("%s: %u ROM banks, MBC%s, %u frames timed %s\n", rom_path, (unsigned)g_gb.rom_banks,
+        g_gb.mbc == MBC_5 ? "5" : g_gb.mbc == MBC_1 ? "1" : " none", (unsigned)frame,
+        use_marker ? "from the frame marker" : "VBlank to VBlank (busy = not halted)");
+    printf("cycles are normal-speed T-cycles; budget %u per frame\n", (unsigned)budget);
+    if (frame) printf("frame 0 (boot): %llu cycles\n", (unsigned long long)stats[0].busy);
+    if (measured) {
+        printf("frames 1..%u: busy min %llu, avg %.1f, max %llu (frame %u, %.1f%% of budget)\n", (unsigned)frame - 1u,
+            (unsigned long long)busy_min, (double)busy_sum / measured, (unsigned long long)busy_max, (unsigned)worst,
+            100.0 * (double)busy_max / budget);
+        printf("over budget: %u, missed VBlank: %u, double speed: %u\n", (unsigned)over, (unsigned)missed, (unsigned)fast);
+        for (uint32_t i = 1, shown = 0; i < frame && shown < 10u; i++) {
+            if (stats[i].busy > budget) {
+                printf("  frame %u: %llu cycles (+%llu), joy %02X\n", (unsigned)i, (unsigned long long)stats[i].busy,
+                    (unsigned long long)(stats[i].busy - budget), (unsigned)stats[i].joy);
+                shown++;
+            }
+        }
+    }
+
+    if (sym_path && top) {
+        uint32_t* order = (uint32_t*)malloc(g_sym_count * sizeof(uint32_t));
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < g_sym_count; i++) {
+            if (g_syms[i].excl) order[n++] = i;
+        }
+        for (uint32_t i = 1; i < n; i++) {
+            uint32_t k = order[i];
+            uint32_t j = i;
+            while (j && g_syms[order[j - 1u]].excl < g_syms[k].excl) {
+                order[j] = order[j - 1u];
+                j--;
+            }
+            order[j] = k;
+        }
+        printf("\n%-32s %4s %9s %13s %6s %13s %11s\n", "symbol", "bank", "entries", "excl_cycles", "excl%", "incl_cycles", "excl/frame");
+        for (uint32_t i = 0; i < n && i < top; i++) {
+            const Sym* s = &g_syms[order[i]];
+            printf("%-32s %4u %9u %13llu %5.1f%% %13llu %11.1f\n", s->name, (unsigned)s->bank, (unsigned)s->entries,
+                (unsigned long long)s->excl, g_gb.dots ? 100.0 * (double)s->excl / (double)g_gb.dots : 0.0,
+                (unsigned long long)s->incl, frame ? (double)s->excl / frame : 0.0);
+        }
+        free(order);
+    }
+
+    if (sram_out && g_gb.sram_size) {
+        FILE* f = fopen(sram_out, "wb");
+        if (!f || fwrite(g_gb.sram, 1, g_gb.sram_size, f) != g_gb.sram_size) die("cannot write --sram-out");
+        fclose(f);
+    }
+
+    return (over || missed) ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Build and run the cross-decoder tilemap suite (sources/tilemap_suite.c).
+
+Encodes one map for comp, macro and quad (tools/encode_tilemap.py), compiles
+each decoder as its own translation unit with its own TILEMAP_* define (the
+three cannot share one), links them with the suite driver and runs it.
+
+The "hram" decoder is the TILEMAP_MACRO_HRAM build: tilemap_macro_hram.c's C
+model of the HRAM-cursor stepping, with its entry points renamed so it links
+next to the plain macro decoder. tilemap_macro_hram.s itself only runs on
+target, where TILEMAP_MACRO_VERIFY checks it against the C reference.
+
+The run:
+
+  1. every decoder is checked cell by cell against the raw map on random
+     seeks, screen-row and screen-column strips, player collision probes
+     and an exhaustive row/column/seek sweep; any difference fails the run;
+  2. each access pattern is timed per decoder (ns/cell, ns/access and perf
+     counters when available);
+  3. a second build with *_INSTRUMENT replays the patterns once and reports
+     per-function call counts (tree descents, macrotile fetches, quadtree
+     traversal depth) per decoded cell.
+
+Exit status is non-zero if any decoder disagrees with the raw map.
+"""
+
+from __future__ import annotations
+
+import argparse
+import shlex
+import subprocess
+from pathlib import Path
+
+from encode_tilemap import ROOT, SOURCES, add_map_arguments, encode_all, map_from_args
+
+HRAM_RENAMES = [
+    f"tilemap_macro_{name}=tilemap_macro_hram_{name}" for name in ("init", "seek_xy", "next_right", "next_down")
+]
+
+UNITS = [
+    ("driver", ["tilemap_suite.c", "host_perf.c", "host_prof.c", "host_rand.c"], []),
+    ("comp", ["tilemap_comp.c", "tilemap_suite_comp.c"], []),
+    ("macro", ["tilemap_macro.c", "tilemap_suite_macro.c"], ["TILEMAP_MACRO"]),
+    ("hram", ["tilemap_macro_hram.c", "tilemap_suite_macro.c"], ["TILEMAP_MACRO", "TILEMAP_MACRO_HRAM"] + HRAM_RENAMES),
+    ("quad", ["tilemap_quad.c", "tilemap_suite_quad.c"], ["TILEMAP_QUAD"]),
+]
+
+INSTRUMENT = {
+    "driver": ["TILEMAP_COMP_INSTRUMENT", "TILEMAP_MACRO_INSTRUMENT", "TILEMAP_QUAD_INSTRUMENT"],
+    "comp": ["TILEMAP_COMP_INSTRUMENT"],
+    "macro": ["TILEMAP_MACRO_INSTRUMENT"],
+    "hram": [],
+    "quad": ["TILEMAP_QUAD_INSTRUMENT"],
+}
+
+
+def build(cc: list[str], cflags: list[str], gen: Path, out: Path, instrument: bool) -> Path:
+    out.mkdir(parents=True, exist_ok=True)
+    objects = []
+    for unit, files, defines in UNITS:
+        defines = ["TILEMAP_SUITE"] + defines + (INSTRUMENT[unit] if instrument else [])
+        for name in files:
+            obj = out / f"{unit}_{Path(name).stem}.o"
+            cmd = cc + cflags + [f"-I{gen}", f"-I{SOURCES}"] + [f"-D{d}" for d in defines]
+            subprocess.run(cmd + ["-c", str(SOURCES / name), "-o", str(obj)], check=True)
+            objects.append(obj)
+    exe = out / "tilemap_suite"
+    subprocess.run(cc + cflags + [str(o) for o in objects] + ["-o", str(exe), "-lm"], check=True)
+    return exe
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Check and benchmark the comp, macro, hram and quad tilemap decoders.")
+    add_map_arguments(parser)
+    parser.add_argument("--out", type=Path, default=ROOT / "build" / "tilemap_suite",
+                        help="Build directory (default: build/tilemap_suite)")
+    parser.add_argument("--cc", default="cc", help="Host C compiler (default: cc)")
+    parser.add_argument("--cflags", default="-O2", help="Compiler flags (default: -O2)")
+    parser.add_argument("--reps", type=int, default=50, help="Timing repetitions per pattern (default: 50)")
+    parser.add_argument("--pattern-seed", type=int, default=0, help="Access pattern seed (default: built-in)")
+    parser.add_argument("--no-instrument", action="store_true", help="Skip the instrumented traversal-stats build")
+    args = parser.parse_args()
+
+    m = map_from_args(args)
+    gen = args.out / "gen"
+    encoded = encode_all(m, gen, args.comp_side)
+    print(f"encoded {m.width}x{m.height} map: " + ", ".join(
+        f"{name} {enc.rom_bytes} B ({', '.join(f'{k} {v}' for k, v in enc.stats.items())})"
+        for name, enc in encoded.items()))
+
+    cc = shlex.split(args.cc)
+    cflags = shlex.split(args.cflags)
+    run_args = [str(args.reps)] + ([str(args.pattern_seed)] if args.pattern_seed else [])
+
+    exe = build(cc, cflags, gen, args.out / "plain", instrument=False)
+    status = subprocess.run([str(exe)] + run_args).returncode
+    if status == 0 and not args.no_instrument:
+        exe = build(cc, cflags, gen, args.out / "instrumented", instrument=True)
+        print()
+        status = subprocess.run([str(exe), "0"] + run_args[1:]).returncode
+    return status
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())